@@ -35,6 +35,7 @@
 #include <jsoncons/json_reader.hpp>
 #include <jsoncons/json_type_traits.hpp>
 #include <jsoncons/byte_string.hpp>
+#include <jsoncons/shared_key.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/heap_only_string.hpp>
 
@@ -232,6 +233,42 @@ struct preserve_order_policy : public sorted_policy
     using key_order = preserve_key_order;
 };
 
+// Replaces the key type of Policy with basic_shared_key, copies of which share storage.
+// json_decoder interns the keys of objects it builds with such a policy.
+template <class Policy>
+struct shared_key_policy : public Policy
+{
+    template <class CharT, class CharTraits, class Allocator>
+    using key_storage = basic_shared_key<CharT, CharTraits, Allocator>;
+};
+
+// Makes copies of a basic_json share their arrays and objects. A shared array or object 
+// is copied, shallowly, on first non-const access, so a write copies only the path to the
+// modified value.
+template <class Policy>
+struct copy_on_write_policy : public Policy
+{
+    using copy_on_write = std::true_type;
+};
+
+// Caches the structural hash (std::hash<basic_json>) of arrays and objects that contain
+// no arrays or objects. A cached hash is cleared by non-const access, and differing
+// cached hashes make operator== return false without comparing elements.
+template <class Policy>
+struct cached_hash_policy : public Policy
+{
+    using cache_hash = std::true_type;
+};
+
+// Widens basic_json values from 16 to Size bytes, 32 or 64, so that longer strings 
+// (up to 29 or 61 chars) are stored inline in the value rather than in a separate allocation.
+template <class Policy, std::size_t Size>
+struct wide_variant_policy : public Policy
+{
+    static_assert(Size == 32 || Size == 64, "Size must be 32 or 64");
+    using variant_size = std::integral_constant<std::size_t,Size>;
+};
+
 template <typename IteratorT>
 class range 
 {
@@ -285,7 +322,10 @@ public:
 
     using char_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<char_type>;
 
-    using key_type = std::basic_string<char_type,char_traits_type,char_allocator_type>;
+    using key_type = typename implementation_policy::template key_storage<char_type,char_traits_type,char_allocator_type>;
+
+    // Copies of a copy-on-write basic_json share array and object storage
+    using copy_on_write = std::integral_constant<bool,detail::is_copy_on_write_policy<implementation_policy>::value>;
 
 
     using reference = basic_json&;
@@ -306,6 +346,7 @@ public:
     using byte_string_storage_type = typename implementation_policy::template sequence_container_type<uint8_t, byte_allocator_type>;
 
     using array = json_array<basic_json>;
+    using typed_array = json_typed_array<basic_json>;
 
     using key_value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_value_type>;                       
 
@@ -504,14 +545,15 @@ public:
         public:
             uint8_t ext_type_;
         private:
-            static constexpr size_t capacity = (2*sizeof(uint64_t) - 2*sizeof(uint8_t))/sizeof(char_type);
+            static constexpr size_t capacity = (detail::policy_variant_size<implementation_policy>::value - 2*sizeof(uint8_t))/sizeof(char_type);
             uint8_t length_;
             char_type data_[capacity];
         public:
             static constexpr size_t max_length = capacity - 1;
 
-            short_string_storage(semantic_tag tag, const char_type* p, uint8_t length)
-                : ext_type_(from_storage_and_tag(storage_kind::short_string_value, tag)), 
+            short_string_storage(semantic_tag tag, const char_type* p, uint8_t length,
+                                 storage_kind kind = storage_kind::short_string_value)
+                : ext_type_(from_storage_and_tag(kind, tag)), 
                   length_(length)
             {
                 JSONCONS_ASSERT(length <= max_length);
@@ -552,8 +594,9 @@ public:
             jsoncons::detail::heap_only_string_wrapper<char_type,Allocator> s_;
         public:
 
-            long_string_storage(semantic_tag tag, const char_type* data, std::size_t length, const Allocator& a)
-                : ext_type_(from_storage_and_tag(storage_kind::long_string_value, tag)),
+            long_string_storage(semantic_tag tag, const char_type* data, std::size_t length, const Allocator& a,
+                                storage_kind kind = storage_kind::long_string_value)
+                : ext_type_(from_storage_and_tag(kind, tag)),
                   s_(data, length, a)
             {
             }
@@ -726,6 +769,27 @@ public:
                 }
             }
 
+            // Replaces a shared array with a copy of it, whose elements in turn share their storage
+            void unshare()
+            {
+                pointer shared = ptr_;
+                JSONCONS_TRY
+                {
+                    create(shared->get_allocator(), *shared);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    ptr_ = shared;
+                    JSONCONS_RETHROW;
+                }
+                if (shared->release()) // the other owners went away meanwhile
+                {
+                    std::swap(shared, ptr_);
+                    destroy();
+                    ptr_ = shared;
+                }
+            }
+
             void destroy() noexcept
             {
                 array_allocator alloc(ptr_->get_allocator());
@@ -748,7 +812,15 @@ public:
             array_storage(const array_storage& val)
                 : ext_type_(val.ext_type_)
             {
-                create(val.ptr_->get_allocator(), *(val.ptr_));
+                if (copy_on_write::value)
+                {
+                    ptr_ = val.ptr_;
+                    ptr_->add_ref();
+                }
+                else
+                {
+                    create(val.ptr_->get_allocator(), *(val.ptr_));
+                }
             }
 
             array_storage(array_storage&& val) noexcept
@@ -761,11 +833,19 @@ public:
             array_storage(const array_storage& val, const Allocator& a)
                 : ext_type_(val.ext_type_)
             {
-                create(array_allocator(a), *(val.ptr_), a);
+                if (copy_on_write::value && val.ptr_->get_allocator() == a)
+                {
+                    ptr_ = val.ptr_;
+                    ptr_->add_ref();
+                }
+                else
+                {
+                    create(array_allocator(a), *(val.ptr_), a);
+                }
             }
             ~array_storage() noexcept
             {
-                if (ptr_ != nullptr)
+                if (ptr_ != nullptr && ptr_->release())
                 {
                     destroy();
                 }
@@ -783,6 +863,11 @@ public:
 
             array& value()
             {
+                if (ptr_->is_shared())
+                {
+                    unshare();
+                }
+                ptr_->invalidate_hash();
                 return *ptr_;
             }
 
@@ -792,6 +877,141 @@ public:
             }
         };
 
+        // typed_array_storage
+        class typed_array_storage final
+        {
+        public:
+            uint8_t ext_type_;
+        private:
+            using typed_array_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<typed_array>;
+            using pointer = typename std::allocator_traits<typed_array_allocator>::pointer;
+
+            pointer ptr_;
+
+            template <typename... Args>
+            void create(typed_array_allocator alloc, Args&& ... args)
+            {
+                ptr_ = std::allocator_traits<typed_array_allocator>::allocate(alloc, 1);
+                JSONCONS_TRY
+                {
+                    std::allocator_traits<typed_array_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    std::allocator_traits<typed_array_allocator>::deallocate(alloc, ptr_,1);
+                    JSONCONS_RETHROW;
+                }
+            }
+
+            // Replaces a shared typed array with a copy of it, whose elements in turn share their storage
+            void unshare()
+            {
+                pointer shared = ptr_;
+                JSONCONS_TRY
+                {
+                    create(shared->get_allocator(), *shared);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    ptr_ = shared;
+                    JSONCONS_RETHROW;
+                }
+                if (shared->release()) // the other owners went away meanwhile
+                {
+                    std::swap(shared, ptr_);
+                    destroy();
+                    ptr_ = shared;
+                }
+            }
+
+            void destroy() noexcept
+            {
+                typed_array_allocator alloc(ptr_->get_allocator());
+                std::allocator_traits<typed_array_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
+                std::allocator_traits<typed_array_allocator>::deallocate(alloc, ptr_,1);
+            }
+        public:
+            template <class T>
+            typed_array_storage(const span<const T>& data, semantic_tag tag, const Allocator& a)
+                : ext_type_(from_storage_and_tag(storage_kind::typed_array_value, tag))
+            {
+                create(typed_array_allocator(a), data, a);
+            }
+
+            typed_array_storage(half_array_arg_t, const span<const uint16_t>& data, semantic_tag tag, const Allocator& a)
+                : ext_type_(from_storage_and_tag(storage_kind::typed_array_value, tag))
+            {
+                create(typed_array_allocator(a), half_array_arg, data, a);
+            }
+
+            typed_array_storage(const typed_array_storage& val)
+                : ext_type_(val.ext_type_)
+            {
+                if (copy_on_write::value)
+                {
+                    ptr_ = val.ptr_;
+                    ptr_->add_ref();
+                }
+                else
+                {
+                    create(val.ptr_->get_allocator(), *(val.ptr_));
+                }
+            }
+
+            typed_array_storage(typed_array_storage&& val) noexcept
+                : ext_type_(val.ext_type_), 
+                  ptr_(nullptr)
+            {
+                std::swap(val.ptr_, ptr_);
+            }
+
+            typed_array_storage(const typed_array_storage& val, const Allocator& a)
+                : ext_type_(val.ext_type_)
+            {
+                if (copy_on_write::value && val.ptr_->get_allocator() == a)
+                {
+                    ptr_ = val.ptr_;
+                    ptr_->add_ref();
+                }
+                else
+                {
+                    create(typed_array_allocator(a), *(val.ptr_), a);
+                }
+            }
+
+            ~typed_array_storage() noexcept
+            {
+                if (ptr_ != nullptr && ptr_->release())
+                {
+                    destroy();
+                }
+            }
+
+            allocator_type get_allocator() const
+            {
+                return ptr_->get_allocator();
+            }
+
+            void swap(typed_array_storage& val) noexcept
+            {
+                std::swap(val.ptr_,ptr_);
+            }
+
+            typed_array& value()
+            {
+                if (ptr_->is_shared())
+                {
+                    unshare();
+                }
+                return *ptr_;
+            }
+
+            const typed_array& value() const
+            {
+                return *ptr_;
+            }
+        };
+
         // object_storage
         class object_storage final
         {
@@ -833,7 +1053,15 @@ public:
             explicit object_storage(const object_storage& val)
                 : ext_type_(val.ext_type_)
             {
-                create(val.ptr_->get_allocator(), *(val.ptr_));
+                if (copy_on_write::value)
+                {
+                    ptr_ = val.ptr_;
+                    ptr_->add_ref();
+                }
+                else
+                {
+                    create(val.ptr_->get_allocator(), *(val.ptr_));
+                }
             }
 
             explicit object_storage(object_storage&& val) noexcept
@@ -846,12 +1074,20 @@ public:
             explicit object_storage(const object_storage& val, const Allocator& a)
                 : ext_type_(val.ext_type_)
             {
-                create(object_allocator(a), *(val.ptr_), a);
+                if (copy_on_write::value && val.ptr_->get_allocator() == a)
+                {
+                    ptr_ = val.ptr_;
+                    ptr_->add_ref();
+                }
+                else
+                {
+                    create(object_allocator(a), *(val.ptr_), a);
+                }
             }
 
             ~object_storage() noexcept
             {
-                if (ptr_ != nullptr)
+                if (ptr_ != nullptr && ptr_->release())
                 {
                     destroy();
                 }
@@ -864,6 +1100,11 @@ public:
 
             object& value()
             {
+                if (ptr_->is_shared())
+                {
+                    unshare();
+                }
+                ptr_->invalidate_hash();
                 return *ptr_;
             }
 
@@ -878,6 +1119,27 @@ public:
             }
         private:
 
+            // Replaces a shared object with a copy of it, whose elements in turn share their storage
+            void unshare()
+            {
+                pointer shared = ptr_;
+                JSONCONS_TRY
+                {
+                    create(shared->get_allocator(), *shared);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    ptr_ = shared;
+                    JSONCONS_RETHROW;
+                }
+                if (shared->release()) // the other owners went away meanwhile
+                {
+                    std::swap(shared, ptr_);
+                    destroy();
+                    ptr_ = shared;
+                }
+            }
+
             void destroy() noexcept
             {
                 object_allocator alloc(ptr_->get_allocator());
@@ -902,6 +1164,7 @@ public:
             array_storage array_stor_;
             object_storage object_stor_;
             empty_object_storage empty_object_stor_;
+            typed_array_storage typed_array_stor_;
         };
     public:
         variant(semantic_tag tag)
@@ -961,6 +1224,19 @@ public:
             }
         }
 
+        // The text of a number held back from conversion, stored like a string
+        variant(lazy_number_arg_t, const char_type* s, std::size_t length, const Allocator& alloc)
+        {
+            if (length <= short_string_storage::max_length)
+            {
+                construct_var<short_string_storage>(semantic_tag::none, s, static_cast<uint8_t>(length), storage_kind::short_number_value);
+            }
+            else
+            {
+                construct_var<long_string_storage>(semantic_tag::none, s, length, char_allocator_type(alloc), storage_kind::long_number_value);
+            }
+        }
+
         variant(const byte_string_view& bytes, semantic_tag tag)
         {
             construct_var<byte_string_storage>(tag, bytes.data(), bytes.size(), byte_allocator_type());
@@ -993,6 +1269,17 @@ public:
             construct_var<array_storage>(val, tag, alloc);
         }
 
+        template <class T>
+        variant(typed_array_arg_t, const span<const T>& data, semantic_tag tag, const Allocator& alloc)
+        {
+            construct_var<typed_array_storage>(data, tag, alloc);
+        }
+
+        variant(typed_array_arg_t, half_arg_t, const span<const uint16_t>& data, semantic_tag tag, const Allocator& alloc)
+        {
+            construct_var<typed_array_storage>(half_array_arg, data, tag, alloc);
+        }
+
         variant(const variant& val)
         {
             Init_(val);
@@ -1024,6 +1311,7 @@ public:
             switch (storage())
             {
                 case storage_kind::long_string_value:
+                case storage_kind::long_number_value:
                     destroy_var<long_string_storage>();
                     break;
                 case storage_kind::byte_string_value:
@@ -1035,6 +1323,9 @@ public:
                 case storage_kind::object_value:
                     destroy_var<object_storage>();
                     break;
+                case storage_kind::typed_array_value:
+                    destroy_var<typed_array_storage>();
+                    break;
                 default:
                     break;
             }
@@ -1224,6 +1515,16 @@ public:
             return array_stor_;
         }
 
+        typed_array_storage& cast(identity<typed_array_storage>)
+        {
+            return typed_array_stor_;
+        }
+
+        const typed_array_storage& cast(identity<typed_array_storage>) const
+        {
+            return typed_array_stor_;
+        }
+
         std::size_t size() const
         {
             switch (storage())
@@ -1232,6 +1533,8 @@ public:
                     return cast<array_storage>().value().size();
                 case storage_kind::object_value:
                     return cast<object_storage>().value().size();
+                case storage_kind::typed_array_value:
+                    return cast<typed_array_storage>().value().size();
                 default:
                     return 0;
             }
@@ -1242,8 +1545,10 @@ public:
             switch (storage())
             {
                 case storage_kind::short_string_value:
+                case storage_kind::short_number_value:
                     return string_view_type(cast<short_string_storage>().data(),cast<short_string_storage>().length());
                 case storage_kind::long_string_value:
+                case storage_kind::long_number_value:
                     return string_view_type(cast<long_string_storage>().data(),cast<long_string_storage>().length());
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
@@ -1293,6 +1598,14 @@ public:
             {
                 return true;
             }
+            if (storage() == storage_kind::typed_array_value || rhs.storage() == storage_kind::typed_array_value)
+            {
+                return typed_array_equal(rhs);
+            }
+            if (is_lazy_number_storage(storage()) || is_lazy_number_storage(rhs.storage()))
+            {
+                return lazy_number_equal(rhs);
+            }
             switch (storage())
             {
                 case storage_kind::null_value:
@@ -1448,6 +1761,14 @@ public:
             {
                 return false;
             }
+            if (storage() == storage_kind::typed_array_value || rhs.storage() == storage_kind::typed_array_value)
+            {
+                return typed_array_less(rhs);
+            }
+            if (is_lazy_number_storage(storage()) || is_lazy_number_storage(rhs.storage()))
+            {
+                return lazy_number_less(rhs);
+            }
             switch (storage())
             {
                 case storage_kind::null_value:
@@ -1569,6 +1890,104 @@ public:
                     break;
             }
         }
+        // A typed array compares like an array of its elements
+
+        bool typed_array_equal(const variant& rhs) const
+        {
+            if (!(is_array_storage(storage()) && is_array_storage(rhs.storage())))
+            {
+                return false;
+            }
+            if (storage() == storage_kind::typed_array_value && rhs.storage() == storage_kind::typed_array_value)
+            {
+                return cast<typed_array_storage>().value() == rhs.cast<typed_array_storage>().value();
+            }
+            if (size() != rhs.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < size(); ++i)
+            {
+                if (!(element_at(i) == rhs.element_at(i)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool typed_array_less(const variant& rhs) const
+        {
+            if (!(is_array_storage(storage()) && is_array_storage(rhs.storage())))
+            {
+                storage_kind lhs_kind = storage() == storage_kind::typed_array_value ? storage_kind::array_value : storage();
+                storage_kind rhs_kind = rhs.storage() == storage_kind::typed_array_value ? storage_kind::array_value : rhs.storage();
+                return (int)lhs_kind < (int)rhs_kind;
+            }
+            const std::size_t n = (std::min)(size(), rhs.size());
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                basic_json a = element_at(i);
+                basic_json b = rhs.element_at(i);
+                if (a < b)
+                {
+                    return true;
+                }
+                if (b < a)
+                {
+                    return false;
+                }
+            }
+            return size() < rhs.size();
+        }
+
+        // A lazy number compares like the double it denotes
+
+        bool lazy_number_equal(const variant& rhs) const
+        {
+            if (is_lazy_number_storage(storage()))
+            {
+                if (is_lazy_number_storage(rhs.storage()) && as_string_view() == rhs.as_string_view())
+                {
+                    return true;
+                }
+                return variant(lazy_number_value(), semantic_tag::none) == rhs;
+            }
+            return *this == variant(rhs.lazy_number_value(), semantic_tag::none);
+        }
+
+        bool lazy_number_less(const variant& rhs) const
+        {
+            if (is_lazy_number_storage(storage()))
+            {
+                return variant(lazy_number_value(), semantic_tag::none) < rhs;
+            }
+            return *this < variant(rhs.lazy_number_value(), semantic_tag::none);
+        }
+
+        double lazy_number_value() const
+        {
+            static const jsoncons::detail::to_double_t to_double;
+            string_view_type sv = as_string_view();
+            return to_double(sv.data(), sv.length());
+        }
+
+        static bool is_lazy_number_storage(storage_kind kind)
+        {
+            return kind == storage_kind::short_number_value || kind == storage_kind::long_number_value;
+        }
+
+        static bool is_array_storage(storage_kind kind)
+        {
+            return kind == storage_kind::array_value || kind == storage_kind::typed_array_value;
+        }
+
+        basic_json element_at(std::size_t i) const
+        {
+            return storage() == storage_kind::typed_array_value ? cast<typed_array_storage>().value().at(i) 
+                                                                : cast<array_storage>().value()[i];
+        }
+
         template <class TypeA, class TypeB>
         void swap_a_b(variant& other)
         {
@@ -1593,9 +2012,12 @@ public:
                 case storage_kind::double_value       : swap_a_b<TypeA, double_storage>(other); break;
                 case storage_kind::short_string_value : swap_a_b<TypeA, short_string_storage>(other); break;
                 case storage_kind::long_string_value       : swap_a_b<TypeA, long_string_storage>(other); break;
+                case storage_kind::short_number_value : swap_a_b<TypeA, short_string_storage>(other); break;
+                case storage_kind::long_number_value  : swap_a_b<TypeA, long_string_storage>(other); break;
                 case storage_kind::byte_string_value  : swap_a_b<TypeA, byte_string_storage>(other); break;
                 case storage_kind::array_value        : swap_a_b<TypeA, array_storage>(other); break;
                 case storage_kind::object_value       : swap_a_b<TypeA, object_storage>(other); break;
+                case storage_kind::typed_array_value  : swap_a_b<TypeA, typed_array_storage>(other); break;
                 default:
                     JSONCONS_UNREACHABLE();
                     break;
@@ -1621,9 +2043,12 @@ public:
                 case storage_kind::double_value: swap_a<double_storage>(other); break;
                 case storage_kind::short_string_value: swap_a<short_string_storage>(other); break;
                 case storage_kind::long_string_value: swap_a<long_string_storage>(other); break;
+                case storage_kind::short_number_value: swap_a<short_string_storage>(other); break;
+                case storage_kind::long_number_value: swap_a<long_string_storage>(other); break;
                 case storage_kind::byte_string_value: swap_a<byte_string_storage>(other); break;
                 case storage_kind::array_value: swap_a<array_storage>(other); break;
                 case storage_kind::object_value: swap_a<object_storage>(other); break;
+                case storage_kind::typed_array_value: swap_a<typed_array_storage>(other); break;
                 default:
                     JSONCONS_UNREACHABLE();
                     break;
@@ -1658,9 +2083,11 @@ public:
                     construct_var<double_storage>(val.cast<double_storage>());
                     break;
                 case storage_kind::short_string_value:
+                case storage_kind::short_number_value:
                     construct_var<short_string_storage>(val.cast<short_string_storage>());
                     break;
                 case storage_kind::long_string_value:
+                case storage_kind::long_number_value:
                     construct_var<long_string_storage>(val.cast<long_string_storage>());
                     break;
                 case storage_kind::byte_string_value:
@@ -1672,6 +2099,9 @@ public:
                 case storage_kind::array_value:
                     construct_var<array_storage>(val.cast<array_storage>());
                     break;
+                case storage_kind::typed_array_value:
+                    construct_var<typed_array_storage>(val.cast<typed_array_storage>());
+                    break;
                 default:
                     break;
             }
@@ -1689,9 +2119,11 @@ public:
             case storage_kind::half_value:
             case storage_kind::double_value:
             case storage_kind::short_string_value:
+            case storage_kind::short_number_value:
                 Init_(val);
                 break;
             case storage_kind::long_string_value:
+            case storage_kind::long_number_value:
                 construct_var<long_string_storage>(val.cast<long_string_storage>(),a);
                 break;
             case storage_kind::byte_string_value:
@@ -1703,6 +2135,9 @@ public:
             case storage_kind::object_value:
                 construct_var<object_storage>(val.cast<object_storage>(),a);
                 break;
+            case storage_kind::typed_array_value:
+                construct_var<typed_array_storage>(val.cast<typed_array_storage>(),a);
+                break;
             default:
                 break;
             }
@@ -1720,12 +2155,15 @@ public:
                 case storage_kind::uint64_value:
                 case storage_kind::bool_value:
                 case storage_kind::short_string_value:
+                case storage_kind::short_number_value:
                     Init_(val);
                     break;
                 case storage_kind::long_string_value:
+                case storage_kind::long_number_value:
                 case storage_kind::byte_string_value:
                 case storage_kind::array_value:
                 case storage_kind::object_value:
+                case storage_kind::typed_array_value:
                 {
                     construct_var<null_storage>();
                     swap(val);
@@ -1754,9 +2192,11 @@ public:
                 case storage_kind::uint64_value:
                 case storage_kind::bool_value:
                 case storage_kind::short_string_value:
+                case storage_kind::short_number_value:
                     Init_(std::forward<variant>(val));
                     break;
                 case storage_kind::long_string_value:
+                case storage_kind::long_number_value:
                 {
                     if (a == val.cast<long_string_storage>().get_allocator())
                     {
@@ -1804,6 +2244,18 @@ public:
                     }
                     break;
                 }
+                case storage_kind::typed_array_value:
+                {
+                    if (a == val.cast<typed_array_storage>().get_allocator())
+                    {
+                        Init_rv_(std::forward<variant>(val), a, std::true_type());
+                    }
+                    else
+                    {
+                        Init_(val,a);
+                    }
+                    break;
+                }
             default:
                 break;
             }
@@ -2082,6 +2534,15 @@ public:
             return evaluate().is_array();
         }
 
+        bool is_typed_array() const noexcept
+        {
+            if (!parent_.contains(key_))
+            {
+                return false;
+            }
+            return evaluate().is_typed_array();
+        }
+
         bool is_int64() const noexcept
         {
             if (!parent_.contains(key_))
@@ -2128,6 +2589,11 @@ public:
             return evaluate().as_byte_string_view();
         }
 
+        typed_array_view as_typed_array_view() const 
+        {
+            return evaluate().as_typed_array_view();
+        }
+
         template <class SAllocator=std::allocator<char_type>>
         std::basic_string<char_type,char_traits_type,SAllocator> as_string() const 
         {
@@ -2467,6 +2933,15 @@ public:
             evaluate().dump(visitor);
         }
 
+        template <class SAllocator=std::allocator<char_type>>
+        void dump(exact_size_arg_t,
+                  std::basic_string<char_type,char_traits_type,SAllocator>& s,
+                  const basic_json_encode_options<char_type>& options = basic_json_encode_options<char_type>(), 
+                  indenting line_indent = indenting::no_indent) const
+        {
+            evaluate().dump(exact_size_arg, s, options, line_indent);
+        }
+
         template <class SAllocator=std::allocator<char_type>>
         void dump(std::basic_string<char_type,char_traits_type,SAllocator>& s, 
                   indenting line_indent,
@@ -3242,6 +3717,11 @@ public:
     {
     }
 
+    basic_json(lazy_number_arg_t, const string_view_type& sv, const Allocator& alloc = Allocator())
+        : var_(lazy_number_arg, sv.data(), sv.length(), alloc)
+    {
+    }
+
     explicit basic_json(const byte_string_view& bytes, 
                         semantic_tag tag, 
                         const Allocator& alloc = Allocator())
@@ -3258,6 +3738,26 @@ public:
     {
     }
 
+    template <class Source>
+    basic_json(typed_array_arg_t, const Source& source, 
+               semantic_tag tag = semantic_tag::none,
+               const Allocator& alloc = Allocator(),
+               typename std::enable_if<jsoncons::detail::has_data_and_size<Source>::value &&
+                                       jsoncons::detail::typed_array_element_traits<typename std::decay<typename Source::value_type>::type>::value,int>::type = 0)
+        : var_(typed_array_arg, span<const typename std::decay<typename Source::value_type>::type>(source.data(), source.size()), tag, alloc)
+    {
+    }
+
+    template <class Source>
+    basic_json(typed_array_arg_t, half_arg_t, const Source& source, 
+               semantic_tag tag = semantic_tag::none,
+               const Allocator& alloc = Allocator(),
+               typename std::enable_if<jsoncons::detail::has_data_and_size<Source>::value &&
+                                       std::is_same<typename std::decay<typename Source::value_type>::type,uint16_t>::value,int>::type = 0)
+        : var_(typed_array_arg, half_arg, span<const uint16_t>(source.data(), source.size()), tag, alloc)
+    {
+    }
+
     ~basic_json() noexcept
     {
     }
@@ -3331,6 +3831,8 @@ public:
             return 0;
         case storage_kind::object_value:
             return object_value().size();
+        case storage_kind::typed_array_value:
+            return var_.size();
         case storage_kind::array_value:
             return array_value().size();
         default:
@@ -3512,6 +4014,72 @@ public:
         visitor.flush();
     }
 
+    template <class SAllocator=std::allocator<char_type>>
+    void dump(exact_size_arg_t,
+              std::basic_string<char_type,char_traits_type,SAllocator>& s,
+              const basic_json_encode_options<char_type>& options = basic_json_encode_options<char_type>(), 
+              indenting line_indent = indenting::no_indent) const
+    {
+        std::error_code ec;
+
+        dump(exact_size_arg, s, options, line_indent, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+    }
+
+    template <class SAllocator=std::allocator<char_type>>
+    void dump(exact_size_arg_t,
+              std::basic_string<char_type,char_traits_type,SAllocator>& s,
+              const basic_json_encode_options<char_type>& options, 
+              indenting line_indent,
+              std::error_code& ec) const
+    {
+        // Measure the output, then write it into s grown once by exactly that length
+        std::size_t length = 0;
+        if (line_indent == indenting::indent)
+        {
+            basic_json_encoder<char_type,jsoncons::counting_sink<char_type>> encoder(length, options);
+            dump(encoder, ec);
+        }
+        else
+        {
+            basic_json_compressed_encoder<char_type,jsoncons::counting_sink<char_type>> encoder(length, options);
+            dump(encoder, ec);
+        }
+        if (ec)
+        {
+            return;
+        }
+
+        // On failure s is restored to its original size
+        std::size_t offset = s.size();
+        s.resize(offset + length);
+        JSONCONS_TRY
+        {
+            if (line_indent == indenting::indent)
+            {
+                basic_json_encoder<char_type,jsoncons::unchecked_sink<char_type>> encoder(&s[0] + offset, options);
+                dump(encoder, ec);
+            }
+            else
+            {
+                basic_json_compressed_encoder<char_type,jsoncons::unchecked_sink<char_type>> encoder(&s[0] + offset, options);
+                dump(encoder, ec);
+            }
+        }
+        JSONCONS_CATCH(...)
+        {
+            s.resize(offset);
+            JSONCONS_RETHROW;
+        }
+        if (ec)
+        {
+            s.resize(offset);
+        }
+    }
+
     bool is_null() const noexcept
     {
         return var_.storage() == storage_kind::null_value;
@@ -3522,6 +4090,7 @@ public:
         switch (var_.storage())
         {
             case storage_kind::long_string_value:
+            case storage_kind::long_number_value:
             {
                 return var_.template cast<typename variant::long_string_storage>().get_allocator();
             }
@@ -3533,6 +4102,10 @@ public:
             {
                 return var_.template cast<typename variant::array_storage>().get_allocator();
             }
+            case storage_kind::typed_array_value:
+            {
+                return var_.template cast<typename variant::typed_array_storage>().get_allocator();
+            }
             case storage_kind::object_value:
             {
                 return var_.template cast<typename variant::object_storage>().get_allocator();
@@ -3635,7 +4208,12 @@ public:
 
     bool is_array() const noexcept
     {
-        return var_.storage() == storage_kind::array_value;
+        return var_.storage() == storage_kind::array_value || var_.storage() == storage_kind::typed_array_value;
+    }
+
+    bool is_typed_array() const noexcept
+    {
+        return var_.storage() == storage_kind::typed_array_value;
     }
 
     bool is_int64() const noexcept
@@ -3655,7 +4233,8 @@ public:
 
     bool is_double() const noexcept
     {
-        return var_.storage() == storage_kind::double_value;
+        return var_.storage() == storage_kind::double_value || 
+               var_.storage() == storage_kind::short_number_value || var_.storage() == storage_kind::long_number_value;
     }
 
     bool is_number() const noexcept
@@ -3666,6 +4245,8 @@ public:
             case storage_kind::uint64_value:
             case storage_kind::half_value:
             case storage_kind::double_value:
+            case storage_kind::short_number_value:
+            case storage_kind::long_number_value:
                 return true;
             case storage_kind::short_string_value:
             case storage_kind::long_string_value:
@@ -3688,6 +4269,8 @@ public:
                 return var_.template cast<typename variant::short_string_storage>().length() == 0;
             case storage_kind::long_string_value:
                 return var_.template cast<typename variant::long_string_storage>().length() == 0;
+            case storage_kind::typed_array_value:
+                return var_.size() == 0;
             case storage_kind::array_value:
                 return array_value().size() == 0;
             case storage_kind::empty_object_value:
@@ -3703,6 +4286,8 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
+            return var_.size();
         case storage_kind::array_value:
             return array_value().capacity();
         case storage_kind::object_value:
@@ -3734,6 +4319,7 @@ public:
         {
             switch (var_.storage())
             {
+            case storage_kind::typed_array_value:
             case storage_kind::array_value:
                 array_value().reserve(n);
                 break;
@@ -3758,6 +4344,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().resize(n);
             break;
@@ -3771,6 +4358,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().resize(n, val);
             break;
@@ -3875,6 +4463,9 @@ public:
                 return static_cast<T>(var_.template cast<typename variant::half_storage>().value());
             case storage_kind::double_value:
                 return static_cast<T>(var_.template cast<typename variant::double_storage>().value());
+            case storage_kind::short_number_value:
+            case storage_kind::long_number_value:
+                return static_cast<T>(var_.lazy_number_value());
             case storage_kind::int64_value:
                 return static_cast<T>(var_.template cast<typename variant::int64_storage>().value());
             case storage_kind::uint64_value:
@@ -3901,6 +4492,9 @@ public:
                 return jsoncons::detail::decode_half(var_.template cast<typename variant::half_storage>().value());
             case storage_kind::double_value:
                 return var_.template cast<typename variant::double_storage>().value();
+            case storage_kind::short_number_value:
+            case storage_kind::long_number_value:
+                return var_.lazy_number_value();
             case storage_kind::int64_value:
                 return static_cast<double>(var_.template cast<typename variant::int64_storage>().value());
             case storage_kind::uint64_value:
@@ -3920,6 +4514,17 @@ public:
         return var_.as_byte_string_view();
     }
 
+    typed_array_view as_typed_array_view() const
+    {
+        switch (var_.storage())
+        {
+            case storage_kind::typed_array_value:
+                return var_.template cast<typename variant::typed_array_storage>().value().view();
+            default:
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a typed array"));
+        }
+    }
+
     template <typename BAllocator=std::allocator<uint8_t>>
     basic_byte_string<BAllocator> as_byte_string() const
     {
@@ -3943,6 +4548,8 @@ public:
         {
             case storage_kind::short_string_value:
             case storage_kind::long_string_value:
+            case storage_kind::short_number_value:
+            case storage_kind::long_number_value:
             {
                 return string_type(as_string_view().data(),as_string_view().length(),alloc);
             }
@@ -4061,6 +4668,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             if (i >= array_value().size())
             {
@@ -4078,6 +4686,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             if (i >= array_value().size())
             {
@@ -4188,6 +4797,8 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
+            break;
         case storage_kind::array_value:
             array_value().shrink_to_fit();
             break;
@@ -4203,6 +4814,9 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
+            var_ = variant(array(get_allocator()), var_.tag());
+            break;
         case storage_kind::array_value:
             array_value().clear();
             break;
@@ -4248,6 +4862,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().erase(pos);
             break;
@@ -4261,6 +4876,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().erase(first, last);
             break;
@@ -4506,6 +5122,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return array_value().insert(pos, std::forward<T>(val));
             break;
@@ -4521,6 +5138,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return array_value().insert(pos, first, last);
             break;
@@ -4568,6 +5186,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return array_value().emplace(pos, std::forward<Args>(args)...);
             break;
@@ -4583,6 +5202,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return array_value().emplace_back(std::forward<Args>(args)...);
         default:
@@ -4617,6 +5237,8 @@ public:
             case storage_kind::half_value:
                 return json_type::half_value;
             case storage_kind::double_value:
+            case storage_kind::short_number_value:
+            case storage_kind::long_number_value:
                 return json_type::double_value;
             case storage_kind::short_string_value:
             case storage_kind::long_string_value:
@@ -4624,6 +5246,7 @@ public:
             case storage_kind::byte_string_value:
                 return json_type::byte_string_value;
             case storage_kind::array_value:
+            case storage_kind::typed_array_value:
                 return json_type::array_value;
             case storage_kind::empty_object_value:
             case storage_kind::object_value:
@@ -4649,6 +5272,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().push_back(std::forward<T>(val));
             break;
@@ -5268,6 +5892,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             array_value().remove_range(from_index, to_index);
             break;
@@ -5363,6 +5988,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return range<array_iterator>(array_value().begin(),array_value().end());
         default:
@@ -5374,6 +6000,7 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
         case storage_kind::array_value:
             return range<const_array_iterator>(array_value().begin(),array_value().end());
         default:
@@ -5385,6 +6012,15 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
+        {
+            // Mutable access to the elements replaces the packed storage with an array
+            array elements = var_.template cast<typename variant::typed_array_storage>().value().take_array();
+            basic_json temp(json_array_arg, var_.tag(), get_allocator());
+            temp.var_.template cast<typename variant::array_storage>().value().swap(elements);
+            swap(temp);
+            return var_.template cast<typename variant::array_storage>().value();
+        }
         case storage_kind::array_value:
             return var_.template cast<typename variant::array_storage>().value();
         default:
@@ -5397,6 +6033,8 @@ public:
     {
         switch (var_.storage())
         {
+        case storage_kind::typed_array_value:
+            return var_.template cast<typename variant::typed_array_storage>().value().elements();
         case storage_kind::array_value:
             return var_.template cast<typename variant::array_storage>().value();
         default:
@@ -5446,6 +6084,10 @@ private:
             case storage_kind::long_string_value:
                 visitor.string_value(as_string_view(), var_.tag(), context, ec);
                 break;
+            case storage_kind::short_number_value:
+            case storage_kind::long_number_value:
+                visitor.number_text_value(as_string_view(), semantic_tag::none, context, ec);
+                break;
             case storage_kind::byte_string_value:
                 visitor.byte_string_value(var_.template cast<typename variant::byte_string_storage>().data(), var_.template cast<typename variant::byte_string_storage>().length(), 
                                           var_.tag(), context, ec);
@@ -5502,6 +6144,49 @@ private:
                 }
                 break;
             }
+            case storage_kind::typed_array_value:
+            {
+                typed_array_view v = var_.template cast<typename variant::typed_array_storage>().value().view();
+                switch (v.type())
+                {
+                    case typed_array_type::uint8_value:
+                        visitor.typed_array(v.data(uint8_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::uint16_value:
+                        visitor.typed_array(v.data(uint16_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::uint32_value:
+                        visitor.typed_array(v.data(uint32_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::uint64_value:
+                        visitor.typed_array(v.data(uint64_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::int8_value:
+                        visitor.typed_array(v.data(int8_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::int16_value:
+                        visitor.typed_array(v.data(int16_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::int32_value:
+                        visitor.typed_array(v.data(int32_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::int64_value:
+                        visitor.typed_array(v.data(int64_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::half_value:
+                        visitor.typed_array(half_arg, v.data(half_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::float_value:
+                        visitor.typed_array(v.data(float_array_arg), var_.tag(), context, ec);
+                        break;
+                    case typed_array_type::double_value:
+                        visitor.typed_array(v.data(double_array_arg), var_.tag(), context, ec);
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            }
             default:
                 break;
         }
@@ -5577,6 +6262,135 @@ jsoncons::wojson operator "" _ojson(const wchar_t* s, std::size_t n)
 
 namespace detail {
 
+template <class CharT>
+std::size_t hash_chars(const CharT* s, std::size_t length) noexcept
+{
+    std::size_t h = 2166136261u;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        h = (h ^ static_cast<std::size_t>(s[i])) * 16777619u;
+    }
+    return h;
+}
+
+inline
+std::size_t hash_combine(std::size_t seed, std::size_t h) noexcept
+{
+    return seed ^ (h + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+inline
+std::size_t hash_number(double d) noexcept
+{
+    if (d == 0)
+    {
+        d = 0; // -0.0 == 0.0
+    }
+    return std::hash<double>()(d);
+}
+
+// Receives the elements of a typed array from append_typed_array, and combines their
+// hashes without building json values
+struct typed_array_hash
+{
+    using value_type = double;
+
+    std::size_t h;
+
+    void push_back(double d) noexcept
+    {
+        h = hash_combine(h, hash_number(d));
+    }
+};
+
+// Structural hash of a json value, consistent with operator==: numbers that compare 
+// equal hash equal whatever their storage, semantic tags are ignored, and object 
+// members are combined independently of their order. Elements and member values 
+// are hashed with child_hash.
+template <class Json, class ChildHash>
+std::size_t hash_json(const Json& val, ChildHash&& child_hash)
+{
+    switch (val.type())
+    {
+        case json_type::null_value:
+            return 0x9e3779b9;
+        case json_type::bool_value:
+            return val.as_bool() ? 1231 : 1237;
+        case json_type::int64_value:
+        case json_type::uint64_value:
+        case json_type::half_value:
+        case json_type::double_value:
+        {
+            return hash_number(val.template as<double>());
+        }
+        case json_type::string_value:
+        {
+            auto sv = val.as_string_view();
+            return hash_chars(sv.data(), sv.size());
+        }
+        case json_type::byte_string_value:
+        {
+            auto bytes = val.as_byte_string_view();
+            return hash_chars(bytes.data(), bytes.size()) ^ 0x5bd1e995;
+        }
+        case json_type::array_value:
+        {
+            if (val.is_typed_array())
+            {
+                typed_array_hash elements{0x7f4a7c15};
+                append_typed_array(val.as_typed_array_view(), elements);
+                return elements.h;
+            }
+            const auto& a = val.array_value();
+            std::size_t h;
+            if (a.get_cached_hash(h))
+            {
+                return h;
+            }
+            h = 0x7f4a7c15;
+            bool is_leaf = true;
+            for (const auto& item : a)
+            {
+                h = hash_combine(h, child_hash(item));
+                is_leaf = is_leaf && !item.is_array() && !item.is_object();
+            }
+            // A nested container can change without its parent knowing
+            if (is_leaf)
+            {
+                a.set_cached_hash(h);
+            }
+            return h;
+        }
+        case json_type::object_value:
+        {
+            std::size_t h = 0x165667b1;
+            if (val.storage() == storage_kind::empty_object_value)
+            {
+                return h;
+            }
+            const auto& o = val.object_value();
+            std::size_t cached;
+            if (o.get_cached_hash(cached))
+            {
+                return cached;
+            }
+            bool is_leaf = true;
+            for (const auto& member : o)
+            {
+                h += hash_combine(hash_chars(member.key().data(), member.key().size()), child_hash(member.value()));
+                is_leaf = is_leaf && !member.value().is_array() && !member.value().is_object();
+            }
+            if (is_leaf)
+            {
+                o.set_cached_hash(h);
+            }
+            return h;
+        }
+        default:
+            return 0;
+    }
+}
+
 template <class T>
 struct is_basic_json : std::false_type
 {};
@@ -5594,4 +6408,15 @@ struct is_basic_json<basic_json<CharT,ImplementationPolicy,Allocator>> : std::tr
 
 } // namespace jsoncons
 
+namespace std {
+    template <class CharT, class ImplementationPolicy, class Allocator>
+    struct hash<jsoncons::basic_json<CharT,ImplementationPolicy,Allocator>>
+    {
+        std::size_t operator()(const jsoncons::basic_json<CharT,ImplementationPolicy,Allocator>& val) const
+        {
+            return jsoncons::detail::hash_json(val, *this);
+        }
+    };
+} // namespace std
+
 #endif
@@ -21,6 +21,9 @@
 #include <initializer_list> // std::initializer_list
 #include <type_traits> // std::enable_if
 #include <jsoncons/config/jsoncons_config.hpp>
+#if defined(JSONCONS_HAS_UMUL128)
+#include <intrin.h> // _umul128, _udiv128
+#endif
 
 namespace jsoncons {
 
@@ -72,6 +75,16 @@ private:
     static constexpr uint64_t l_mask = max_basic_type - r_mask;
     static constexpr uint64_t l_bit = max_basic_type - (max_basic_type >> 1);
 
+    // Operands of at least this many words are multiplied with Karatsuba
+    static constexpr std::size_t karatsuba_threshold = 32;
+    // Numbers of up to this many words are converted to and from decimal 
+    // one word at a time, larger numbers are split in halves
+    static constexpr std::size_t radix_threshold = 32;
+    static constexpr uint64_t max_p10 = 10000000000000000000u; // 10^19
+    static constexpr std::size_t max_p10_digits = 19;
+
+    using basic_type_buffer = std::vector<uint64_t,typename basic_bignum_base<Allocator>::basic_type_allocator_type>;
+
     union
     {
         std::size_t capacity_;
@@ -173,11 +186,8 @@ public:
     {
         if (l.size() > 0)
         {
-            basic_bignum<Allocator> v = 0;
-            for (auto c: l)
-            {
-                v = (v * 256) + (uint64_t)(c);
-            }
+            basic_bignum<Allocator> v;
+            v.assign_bytes(l.begin(), l.size());
 
             if (signum == -1)
             {
@@ -198,11 +208,8 @@ public:
     {
         if (n > 0)
         {
-            basic_bignum<Allocator> v = 0;
-            for (std::size_t i = 0; i < n; i++)
-            {
-                v = (v * 256) + (uint64_t)(str[i]);
-            }
+            basic_bignum<Allocator> v;
+            v.assign_bytes(str, n);
 
             if (signum == -1)
             {
@@ -491,34 +498,10 @@ public:
                 *this *= y.data_[0];
             else
             {
-                std::size_t lenProd = length() + y.length(), jA, jB;
-                uint64_t sumHi = 0, sumLo, hi, lo,
-                sumLo_old, sumHi_old, carry=0;
+                std::size_t lenProd = length() + y.length();
                 basic_bignum<Allocator> x = *this;
                 set_length( lenProd ); // Give *this length lenProd
-
-                for (std::size_t i = 0; i < lenProd; i++ )
-                {
-                    sumLo = sumHi;
-                    sumHi = carry;
-                    carry = 0;
-                    for ( jA=0; jA < x.length(); jA++ )
-                    {
-                        jB = i - jA;
-                        if ( jB >= 0 && jB < y.length() )
-                        {
-                            DDproduct( x.data_[jA], y.data_[jB], hi, lo );
-                            sumLo_old = sumLo;
-                            sumHi_old = sumHi;
-                            sumLo += lo;
-                            if ( sumLo < sumLo_old )
-                                sumHi++;
-                            sumHi += hi;
-                            carry += (sumHi < sumHi_old);
-                        }
-                    }
-                    data_[i] = sumLo;
-                }
+                multiply(x.data_, x.length(), y.data_, y.length(), data_);
             }
         }
        reduce();
@@ -553,7 +536,7 @@ public:
         if ( k )  // 0 < k < basic_type_bits:
         {
             uint64_t k1 = basic_type_bits - k;
-            uint64_t mask = (1 << k) - 1;
+            uint64_t mask = (uint64_t(1) << k) - 1;
             incr_length( length() + 1 );
             for (std::size_t i = length(); i-- > 0; )
             {
@@ -588,7 +571,7 @@ public:
 
         std::size_t n = (std::size_t)(length() - 1);
         int64_t k1 = basic_type_bits - k;
-        uint64_t mask = (1 << k) - 1;
+        uint64_t mask = (uint64_t(1) << k) - 1;
         for (std::size_t i = 0; i <= n; i++)
         {
             data_[i] >>= k;
@@ -768,132 +751,90 @@ public:
         {
             signum = 1;
         }
-        basic_bignum<Allocator> divisor(256);
 
-        while (n >= 256)
+        // Big endian bytes of the magnitude, at least one byte
+        std::size_t offset = data.size();
+        for (std::size_t i = n.length(); i-- > 0; )
         {
-            basic_bignum<Allocator> q;
-            basic_bignum<Allocator> r;
-            n.divide(divisor, q, r, true);
-            n = q;
-            data.push_back((uint8_t)(uint64_t)r);
+            uint64_t d = n.data_[i];
+            for (int shift = basic_type_bits - 8; shift >= 0; shift -= 8)
+            {
+                uint8_t c = (uint8_t)(d >> shift);
+                if (c != 0 || data.size() > offset)
+                {
+                    data.push_back(c);
+                }
+            }
         }
-        if (n >= 0)
+        if (data.size() == offset)
         {
-            data.push_back((uint8_t)(uint64_t)n);
+            data.push_back(0);
         }
-        std::reverse(data.begin(),data.end());
     }
 
     template <typename Ch, typename Traits, typename Alloc>
     void dump(std::basic_string<Ch,Traits,Alloc>& data) const
     {
+        data.clear();
+        if ( length() == 0 )
+        {
+            data.push_back('0');
+            return;
+        }
+        if ( neg_ )
+        {
+            data.push_back('-');
+        }
         basic_bignum<Allocator> v(*this);
+        v.neg_ = false;
 
-        int len = int(uint32_t(v.length()) * basic_bignum<Allocator>::basic_type_bits / 3) + 2;
-        data.resize(len);
-
-        int n = len;
-        int i = 0;
-                                      // 1/3 > ln(2)/ln(10)
-        static uint64_t p10 = 1;
-        static uint64_t ip10 = 0;
-
-        if ( v.length() == 0 )
+        if ( v.length() <= radix_threshold )
         {
-            data[0] = '0';
-            i = 1;
+            write_decimal(v, 0, data);
+            return;
         }
-        else
+
+        // powers[k] = 10^(19*2^k), up to the first with v < powers[k]^2
+        std::vector<basic_bignum<Allocator>> powers;
+        powers.emplace_back(uint64_t(max_p10));
+        for (;;)
         {
-            uint64_t r;
-            if ( p10 == 1 )
+            basic_bignum<Allocator> sq = powers.back() * powers.back();
+            if ( v < sq )
             {
-                while ( p10 <= (std::numeric_limits<uint64_t>::max)()/10 )
-                {
-                    p10 *= 10;
-                    ip10++;
-                }
-            }                     // p10 is max unsigned power of 10
-            basic_bignum<Allocator> R;
-            basic_bignum<Allocator> LP10 = p10; // LP10 = p10 = ::pow(10, ip10)
-            if ( v.neg_ )
-            {
-                data[0] = '-';
-                i = 1;
+                break;
             }
-            do
-            {
-                v.divide( LP10, v, R, true );
-                r = (R.length() ? R.data_[0] : 0);
-                for ( std::size_t j=0; j < ip10; j++ )
-                {
-                    data[--n] = char(r % 10 + '0');
-                    r /= 10;
-                    if ( r + v.length() == 0 )
-                        break;
-                }
-            } while ( v.length() );
-            while ( n < len )
-                data[i++] = data[n++];
+            powers.push_back(std::move(sq));
         }
-        data.resize(i);
+        std::vector<basic_bignum<Allocator>> reciprocals(powers.size());
+        write_decimal(v, powers.size()-1, false, powers, reciprocals, data);
     }
 
     template <typename Ch, typename Traits, typename Alloc>
     void dump_hex_string(std::basic_string<Ch,Traits,Alloc>& data) const
     {
-        basic_bignum<Allocator> v(*this);
-
-        int len = int(uint32_t(v.length()) * basic_bignum<Allocator>::basic_type_bits / 3) + 2;
-        data.resize(len);
-
-        int n = len;
-        int i = 0;
-                                      // 1/3 > ln(2)/ln(10)
-        static uint64_t p10 = 1;
-        static uint64_t ip10 = 0;
-
-        if ( v.length() == 0 )
+        data.clear();
+        if ( length() == 0 )
+        {
+            data.push_back('0');
+            return;
+        }
+        if ( neg_ )
         {
-            data[0] = '0';
-            i = 1;
+            data.push_back('-');
         }
-        else
+        std::size_t offset = data.size();
+        for (std::size_t i = length(); i-- > 0; )
         {
-            uint64_t r;
-            if ( p10 == 1 )
+            for (int shift = basic_type_bits - 4; shift >= 0; shift -= 4)
             {
-                while ( p10 <= (std::numeric_limits<uint64_t>::max)()/16 )
+                uint8_t c = (uint8_t)((data_[i] >> shift) & 0x0f);
+                if (c != 0 || data.size() > offset)
                 {
-                    p10 *= 16;
-                    ip10++;
+                    data.push_back((c < 10) ? Ch('0' + c) : Ch('A' - 10 + c));
                 }
-            }                     // p10 is max unsigned power of 16
-            basic_bignum<Allocator> R;
-            basic_bignum<Allocator> LP10 = p10; // LP10 = p10 = ::pow(16, ip10)
-            if ( v.neg_ )
-            {
-                data[0] = '-';
-                i = 1;
             }
-            do
-            {
-                v.divide( LP10, v, R, true );
-                r = (R.length() ? R.data_[0] : 0);
-                for ( std::size_t j=0; j < ip10; j++ )
-                {
-                    uint8_t c = r % 16;
-                    data[--n] = (c < 10) ? ('0' + c) : ('A' - 10 + c);
-                    r /= 16;
-                    if ( r + v.length() == 0 )
-                        break;
-                }
-            } while ( v.length() );
-            while ( n < len )
-                data[i++] = data[n++];
         }
-        data.resize(i);
     }
 
 //  Global Operators
@@ -1159,10 +1100,18 @@ public:
     }
 
 private:
-    void DDproduct( uint64_t A, uint64_t B,
-                    uint64_t& hi, uint64_t& lo ) const
+    static void DDproduct( uint64_t A, uint64_t B,
+                           uint64_t& hi, uint64_t& lo )
     // Multiplying two digits: (hi, lo) = A * B
     {
+#if defined(JSONCONS_HAS_INT128)
+        __extension__ typedef unsigned __int128 uint128_type;
+        uint128_type p = (uint128_type)A * B;
+        hi = (uint64_t)(p >> basic_type_bits);
+        lo = (uint64_t)p;
+#elif defined(JSONCONS_HAS_UMUL128)
+        lo = _umul128(A, B, &hi);
+#else
         uint64_t hiA = A >> basic_type_halfBits, loA = A & r_mask,
                    hiB = B >> basic_type_halfBits, loB = B & r_mask,
                    mid1, mid2, old;
@@ -1177,6 +1126,25 @@ private:
         old = lo;
         lo += mid2 << basic_type_halfBits;
             hi += (lo < old) + (mid2 >> basic_type_halfBits);
+#endif
+    }
+
+    uint64_t DDdivide( uint64_t A, uint64_t B, uint64_t d, uint64_t& rem ) const
+    // Divide double word (A, B) by d, A < d and d normalized
+    {
+#if defined(JSONCONS_HAS_INT128)
+        __extension__ typedef unsigned __int128 uint128_type;
+        uint128_type n = ((uint128_type)A << basic_type_bits) | B;
+        uint64_t q = (uint64_t)(n / d);
+        rem = B - q * d;
+        return q;
+#elif defined(JSONCONS_HAS_UDIV128)
+        return _udiv128(A, B, d, &rem);
+#else
+        uint64_t q = DDquotient(A, B, d);
+        rem = B - q * d;
+        return q;
+#endif
     }
 
     uint64_t DDquotient( uint64_t A, uint64_t B, uint64_t d ) const
@@ -1234,26 +1202,32 @@ private:
             if ( a[i] > d )
                 carry++;
             d = a[i + 1];
-            a[i + 1] -= hi + carry;
-            carry = a[i + 1] > d;
+            a[i + 1] -= hi;
+            hi = a[i + 1] > d; // hi + carry may overflow, subtract separately
+            d = a[i + 1];
+            a[i + 1] -= carry;
+            carry = hi + (a[i + 1] > d);
         }
-        if ( carry ) // q was too large
+        while ( carry ) // q was too large
         {
             q--;
-            carry = 0;
+            uint64_t c = 0;
             for ( i = 0; i < n; i++ )
             {
-                d = a[i] + carry;
-                carry = d < carry;
+                d = a[i] + c;
+                c = d < c;
                 a[i] = d + b[i];
                 if ( a[i] < d )
-                    carry = 1;
+                    c = 1;
             }
-            a[n] = 0;
+            a[n] += c;
+            carry = !(c && a[n] == 0); // still negative unless the add carries out
         }
     }
 
-    int normalize( basic_bignum<Allocator>& denom, basic_bignum<Allocator>& num, int& x ) const
+    // Shifts so that the top bit of the divisor is set, which is all that the
+    // quotient digit estimates in divide need
+    void normalize( basic_bignum<Allocator>& denom, basic_bignum<Allocator>& num, int& x ) const
     {
         std::size_t r = denom.length() - 1;
         uint64_t y = denom.data_[r];
@@ -1266,29 +1240,15 @@ private:
         }
         denom <<= x;
         num <<= x;
-        if ( r > 0 && denom.data_[r] < denom.data_[r-1] )
-        {
-            denom *= max_basic_type;
-                    num *= max_basic_type;
-            return 1;
-        }
-        return 0;
     }
 
-    void unnormalize( basic_bignum<Allocator>& rem, int x, int secondDone ) const
+    void unnormalize( basic_bignum<Allocator>& rem, int x ) const
     {
-        if ( secondDone )
-        {
-            rem /= max_basic_type;
-        }
+        rem.reduce();
         if ( x > 0 )
         {
             rem >>= x;
         }
-        else
-        {
-            rem.reduce();
-        }
     }
 
     void divide( basic_bignum<Allocator> denom, basic_bignum<Allocator>& quot, basic_bignum<Allocator>& rem, bool remDesired ) const
@@ -1340,7 +1300,7 @@ private:
             return;
         }
         basic_bignum<Allocator> num0 = num, denom0 = denom;
-        int second_done = normalize(denom, num, x);
+        normalize(denom, num, x);
         std::size_t l = denom.length() - 1;
         std::size_t n = num.length() - 1;
         quot.set_length(n - l);
@@ -1356,7 +1316,8 @@ private:
         uint64_t d = denom.data_[l];
         for ( std::size_t k = n; k > l; k-- )
         {
-            uint64_t q = DDquotient(rem.data_[k], rem.data_[k-1], d);
+            // The estimate may exceed the quotient digit by 2, subtractmul corrects it
+            uint64_t q = rem.data_[k] >= d ? max_basic_type : DDquotient(rem.data_[k], rem.data_[k-1], d);
             subtractmul( rem.data_ + k - l - 1, denom.data_, l + 1, q );
             quot.data_[k - l - 1] = q;
         }
@@ -1364,11 +1325,349 @@ private:
         quot.neg_ = quot_neg;
         if ( remDesired )
         {
-            unnormalize(rem, x, second_done);
+            unnormalize(rem, x);
             rem.neg_ = rem_neg;
         }
     }
 
+    static uint64_t add_words( uint64_t* a, std::size_t n, const uint64_t* b, std::size_t m )
+    // a += b: a in n positions, b in m <= n positions; returns the carry
+    {
+        uint64_t carry = 0;
+        std::size_t i = 0;
+        for ( ; i < m; i++ )
+        {
+            uint64_t d = a[i] + carry;
+            carry = d < carry;
+            a[i] = d + b[i];
+            carry += a[i] < d;
+        }
+        for ( ; carry && i < n; i++ )
+        {
+            carry = ++a[i] == 0;
+        }
+        return carry;
+    }
+
+    static uint64_t sub_words( uint64_t* a, std::size_t n, const uint64_t* b, std::size_t m )
+    // a -= b: a in n positions, b in m <= n positions; returns the borrow
+    {
+        uint64_t borrow = 0;
+        std::size_t i = 0;
+        for ( ; i < m; i++ )
+        {
+            uint64_t d = a[i] - borrow;
+            borrow = d > a[i];
+            a[i] = d - b[i];
+            borrow += a[i] > d;
+        }
+        for ( ; borrow && i < n; i++ )
+        {
+            borrow = a[i]-- == 0;
+        }
+        return borrow;
+    }
+
+    static void multiply_basecase( const uint64_t* a, std::size_t n, const uint64_t* b, std::size_t m, uint64_t* r )
+    // r = a * b: r in n + m positions
+    {
+        std::fill(r, r + n + m, uint64_t(0));
+        for (std::size_t j = 0; j < m; j++ )
+        {
+            uint64_t carry = 0, hi, lo;
+            for (std::size_t i = 0; i < n; i++ )
+            {
+                DDproduct( a[i], b[j], hi, lo );
+                lo += carry;
+                hi += lo < carry;
+                r[i + j] += lo;
+                carry = hi + (r[i + j] < lo);
+            }
+            r[n + j] = carry;
+        }
+    }
+
+    void multiply( const uint64_t* a, std::size_t n, const uint64_t* b, std::size_t m, uint64_t* r ) const
+    // r = a * b: r in n + m positions, not overlapping a or b
+    {
+        if ( n < m )
+        {
+            std::swap(a, b);
+            std::swap(n, m);
+        }
+        if ( m < karatsuba_threshold )
+        {
+            multiply_basecase(a, n, b, m, r);
+        }
+        else if ( 2*m <= n )
+        {
+            // Unbalanced, multiply b by slices of a in m positions
+            std::fill(r, r + n + m, uint64_t(0));
+            basic_type_buffer t(2*m, 0, alloc());
+            for (std::size_t i = 0; i < n; i += m )
+            {
+                std::size_t len = n - i < m ? n - i : m;
+                multiply(a + i, len, b, m, t.data());
+                add_words(r + i, n + m - i, t.data(), len + m);
+            }
+        }
+        else
+        {
+            // Karatsuba: a = a1*B^h + a0, b = b1*B^h + b0,
+            // a*b = z2*B^2h + (z1 - z2 - z0)*B^h + z0
+            std::size_t h = n / 2;
+            std::size_t n1 = n - h;
+            std::size_t m1 = m - h;
+            multiply(a, h, b, h, r);                    // z0
+            multiply(a + h, n1, b + h, m1, r + 2*h);    // z2
+
+            std::size_t la = n1 + 1;
+            std::size_t lb = (h > m1 ? h : m1) + 1;
+            basic_type_buffer t(la + lb + la + lb, 0, alloc());
+            uint64_t* sa = t.data();
+            uint64_t* sb = sa + la;
+            uint64_t* z1 = sb + lb;
+            std::copy(a + h, a + n, sa);
+            add_words(sa, la, a, h);                    // a0 + a1
+            std::copy(b, b + h, sb);
+            add_words(sb, lb, b + h, m1);               // b0 + b1
+            multiply(sa, la, sb, lb, z1);
+
+            std::size_t lz = la + lb;
+            sub_words(z1, lz, r, 2*h);
+            sub_words(z1, lz, r + 2*h, n1 + m1);
+            while ( lz > 0 && z1[lz-1] == 0 )
+            {
+                --lz;
+            }
+            add_words(r + h, n + m - h, z1, lz);
+        }
+    }
+
+    std::size_t bit_length() const
+    {
+        if ( length() == 0 )
+        {
+            return 0;
+        }
+        std::size_t n = (length() - 1) * basic_type_bits;
+        for (uint64_t d = data_[length() - 1]; d != 0; d >>= 1)
+        {
+            ++n;
+        }
+        return n;
+    }
+
+    basic_bignum<Allocator> reciprocal( const basic_bignum<Allocator>& d ) const
+    // floor(2^2s/d), where d has s bits, by Newton iteration 
+    {
+        std::size_t s = d.bit_length();
+        basic_bignum<Allocator> pow2 = 1;
+        pow2 <<= 2*s;
+        if ( d.length() < 2*karatsuba_threshold )
+        {
+            return pow2 / d;
+        }
+
+        // Start from the reciprocal of the upper half of d
+        std::size_t t = s / 2;
+        basic_bignum<Allocator> dh = d;
+        dh >>= t;
+        basic_bignum<Allocator> x = reciprocal(dh);
+        x <<= t;
+
+        basic_bignum<Allocator> e = pow2 - d * x;
+        basic_bignum<Allocator> c = x * e;
+        bool neg = c.neg_;
+        c.neg_ = false;
+        c >>= 2*s;
+        c.neg_ = neg && c.length() > 0;
+        x += c;
+
+        // Correct the last few units
+        basic_bignum<Allocator> r = pow2 - d * x;
+        while ( r.neg_ )
+        {
+            --x;
+            r += d;
+        }
+        while ( r >= d )
+        {
+            ++x;
+            r -= d;
+        }
+        return x;
+    }
+
+    void divide_by_power( const basic_bignum<Allocator>& v, const basic_bignum<Allocator>& p,
+                          basic_bignum<Allocator>& reciprocal_p,
+                          basic_bignum<Allocator>& quot, basic_bignum<Allocator>& rem ) const
+    // quot, rem = v / p, v % p, where v < p^2 
+    {
+        if ( p.length() < 2*karatsuba_threshold )
+        {
+            v.divide(p, quot, rem, true);
+            return;
+        }
+        if ( reciprocal_p.length() == 0 )
+        {
+            reciprocal_p = reciprocal(p);
+        }
+        quot = v * reciprocal_p;
+        quot >>= 2*p.bit_length();
+        rem = v - quot * p;
+        while ( rem.neg_ )
+        {
+            --quot;
+            rem += p;
+        }
+        while ( rem >= p )
+        {
+            ++quot;
+            rem -= p;
+        }
+    }
+
+    template <typename Ch, typename Traits, typename Alloc>
+    void write_decimal( const basic_bignum<Allocator>& v, std::size_t width, std::basic_string<Ch,Traits,Alloc>& data ) const
+    // Appends v in decimal, left padded with zeros to width, dividing by 10^19 in place
+    {
+        basic_type_buffer words(v.begin(), v.end(), alloc());
+        std::size_t len = words.size();
+        std::vector<uint64_t> chunks;
+        while ( len > 0 )
+        {
+            uint64_t r = 0;
+            for (std::size_t i = len; i-- > 0; )
+            {
+                words[i] = DDdivide(r, words[i], max_p10, r);
+            }
+            chunks.push_back(r);
+            while ( len > 0 && words[len-1] == 0 )
+            {
+                --len;
+            }
+        }
+
+        Ch buf[max_p10_digits];
+        std::size_t n = 0;
+        if ( !chunks.empty() )
+        {
+            for (uint64_t r = chunks.back(); r != 0; r /= 10)
+            {
+                ++n;
+            }
+            n += (chunks.size() - 1) * max_p10_digits;
+        }
+        if ( width > n )
+        {
+            data.append(width - n, '0');
+        }
+        for (std::size_t i = chunks.size(); i-- > 0; )
+        {
+            uint64_t r = chunks[i];
+            std::size_t ndigits = max_p10_digits;
+            if ( i + 1 == chunks.size() )
+            {
+                ndigits = n - i * max_p10_digits;
+            }
+            for (std::size_t j = ndigits; j-- > 0; )
+            {
+                buf[j] = Ch('0' + r % 10);
+                r /= 10;
+            }
+            data.append(buf, ndigits);
+        }
+    }
+
+    template <typename Ch, typename Traits, typename Alloc>
+    void write_decimal( const basic_bignum<Allocator>& v, std::size_t k, bool pad,
+                        const std::vector<basic_bignum<Allocator>>& powers,
+                        std::vector<basic_bignum<Allocator>>& reciprocals,
+                        std::basic_string<Ch,Traits,Alloc>& data ) const
+    // Appends v < powers[k]^2 in decimal, when pad is true left padded to 2*19*2^k digits
+    {
+        if ( v.length() <= radix_threshold )
+        {
+            write_decimal(v, pad ? (max_p10_digits << (k + 1)) : 0, data);
+            return;
+        }
+        if ( !pad && v < powers[k] )
+        {
+            write_decimal(v, k - 1, pad, powers, reciprocals, data);
+            return;
+        }
+        basic_bignum<Allocator> q;
+        basic_bignum<Allocator> r;
+        divide_by_power(v, powers[k], reciprocals[k], q, r);
+        write_decimal(q, k - 1, pad, powers, reciprocals, data);
+        write_decimal(r, k - 1, true, powers, reciprocals, data);
+    }
+
+    template <typename CharT>
+    void read_decimal( const CharT* data, std::size_t length )
+    // *this = the decimal digits, 19 at a time
+    {
+        *this = 0;
+        std::size_t n = length % max_p10_digits;
+        if ( n == 0 )
+        {
+            n = max_p10_digits;
+        }
+        for (std::size_t i = 0; i < length; i += n, n = max_p10_digits)
+        {
+            uint64_t scale = 1;
+            uint64_t d = 0;
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                d = d * 10 + (uint64_t)(data[i + j] - '0');
+                scale *= 10;
+            }
+            *this *= scale;
+            *this += d;
+        }
+    }
+
+    template <typename CharT>
+    void read_decimal( const CharT* data, std::size_t length,
+                       const std::vector<basic_bignum<Allocator>>& powers )
+    // *this = the decimal digits, high and low halves split at a power 10^(19*2^k)
+    {
+        if ( length <= radix_threshold * max_p10_digits )
+        {
+            read_decimal(data, length);
+            return;
+        }
+        std::size_t k = 0;
+        while ( (max_p10_digits << (k + 1)) < length )
+        {
+            ++k;
+        }
+        std::size_t m = max_p10_digits << k;
+        basic_bignum<Allocator> lo;
+        lo.read_decimal(data + (length - m), m, powers);
+        read_decimal(data, length - m, powers);
+        *this *= powers[k];
+        *this += lo;
+    }
+
+    void assign_bytes( const uint8_t* str, std::size_t n )
+    // *this = big endian bytes
+    {
+        set_length((n + 7) / 8);
+        for (std::size_t i = 0; i < length(); ++i)
+        {
+            data_[i] = 0;
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::size_t pos = n - 1 - i;
+            data_[pos / 8] |= uint64_t(str[i]) << (8 * (pos % 8));
+        }
+        neg_ = false;
+        reduce();
+    }
+
     std::size_t length() const { return length_; }
     uint64_t* begin() { return data_; }
     const uint64_t* begin() const { return data_; }
@@ -1382,7 +1681,7 @@ private:
        {
            if ( dynamic_ )
            {
-               delete[] data_;
+               alloc().deallocate(data_, capacity_);
            }
            capacity_ = round_up(length_);
            data_ = alloc().allocate(capacity_);
@@ -1538,20 +1837,35 @@ private:
             neg = false;
         }
 
-        basic_bignum<Allocator> v = 0;
         for (std::size_t i = 0; i < length; i++)
         {
             CharT c = data[i];
             switch (c)
             {
                 case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                    v = (v * 10) + (uint64_t)(c - '0');
                     break;
                 default:
                     JSONCONS_THROW(std::runtime_error(std::string("Invalid digit ") + "\'" + (char)c + "\'"));
             }
         }
 
+        basic_bignum<Allocator> v;
+        if ( length <= radix_threshold * max_p10_digits )
+        {
+            v.read_decimal(data, length);
+        }
+        else
+        {
+            // powers[k] = 10^(19*2^k)
+            std::vector<basic_bignum<Allocator>> powers;
+            powers.emplace_back(uint64_t(max_p10));
+            while ( (max_p10_digits << powers.size()) < length )
+            {
+                powers.push_back(powers.back() * powers.back());
+            }
+            v.read_decimal(data, length, powers);
+        }
+
         if ( neg )
         {
             v.neg_ = true;
@@ -20,17 +20,106 @@
 #include <utility> // std::move
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_exception.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/detail/simd.hpp>
+#include <jsoncons/sink.hpp>
 
 namespace jsoncons {
 
     // Algorithms
 
     namespace detail {
+
+    // The encode and decode prefix functions convert the longest prefix of a contiguous range that 
+    // they can in blocks, and return where the iterator-generic loops should take over. 
+    // Other iterators are not advanced.
+
+    template <class InputIt, class Container>
+    InputIt encode_base64_prefix(InputIt first, InputIt, const char[65], Container&, std::size_t&)
+    {
+        return first;
+    }
+
+    template <class T, class Container>
+    typename std::enable_if<std::is_same<typename std::remove_const<T>::type,uint8_t>::value,T*>::type 
+    encode_base64_prefix(T* first, T* last, const char alphabet[65], Container& result, std::size_t& count)
+    {
+        char buffer[256];
+        while (last - first >= 3)
+        {
+            std::size_t n = 0;
+            while (has_base64_blocks && last - first >= 16 && n + 16 <= sizeof(buffer))
+            {
+                encode_base64_block(first, buffer + n, alphabet[62], alphabet[63]);
+                first += 12;
+                n += 16;
+            }
+            while (last - first >= 3 && n + 4 <= sizeof(buffer))
+            {
+                buffer[n++] = alphabet[first[0] >> 2];
+                buffer[n++] = alphabet[((first[0] & 0x03) << 4) | (first[1] >> 4)];
+                buffer[n++] = alphabet[((first[1] & 0x0f) << 2) | (first[2] >> 6)];
+                buffer[n++] = alphabet[first[2] & 0x3f];
+                first += 3;
+            }
+            append_buffer(result, buffer, n);
+            count += n;
+        }
+        return first;
+    }
+
+    template <class InputIt, class Container>
+    InputIt decode_base64_prefix(InputIt first, InputIt, const uint8_t[256], Container&)
+    {
+        return first;
+    }
+
+    template <class CharT, class Container>
+    typename std::enable_if<sizeof(CharT) == sizeof(uint8_t),CharT*>::type 
+    decode_base64_prefix(CharT* first, CharT* last, const uint8_t reverse_alphabet[256], Container& result)
+    {
+        using value_type = typename Container::value_type;
+
+        const char c62 = reverse_alphabet[static_cast<uint8_t>('+')] == 62 ? '+' : '-';
+        const char c63 = reverse_alphabet[static_cast<uint8_t>('/')] == 63 ? '/' : '_';
+        uint8_t buffer[256];
+        bool more = true;
+        while (more && last - first >= 4)
+        {
+            std::size_t n = 0;
+            while (has_base64_blocks && last - first >= 16 && n + 16 <= sizeof(buffer)
+                   && decode_base64_block(reinterpret_cast<const char*>(first), buffer + n, c62, c63))
+            {
+                first += 16;
+                n += 12;
+            }
+            while (last - first >= 4 && n + 3 <= sizeof(buffer))
+            {
+                uint8_t a = reverse_alphabet[static_cast<uint8_t>(first[0])];
+                uint8_t b = reverse_alphabet[static_cast<uint8_t>(first[1])];
+                uint8_t c = reverse_alphabet[static_cast<uint8_t>(first[2])];
+                uint8_t d = reverse_alphabet[static_cast<uint8_t>(first[3])];
+                if (((a | b | c | d) & 0x80) != 0) // padding or not in the alphabet
+                {
+                    more = false;
+                    break;
+                }
+                buffer[n++] = static_cast<uint8_t>((a << 2) | (b >> 4));
+                buffer[n++] = static_cast<uint8_t>((b << 4) | (c >> 2));
+                buffer[n++] = static_cast<uint8_t>((c << 6) | d);
+                first += 4;
+            }
+            append_buffer(result, reinterpret_cast<const value_type*>(buffer), n);
+        }
+        return first;
+    }
+
     template <class InputIt, class Container>
     typename std::enable_if<std::is_same<typename std::iterator_traits<InputIt>::value_type,uint8_t>::value,size_t>::type
     encode_base64_generic(InputIt first, InputIt last, const char alphabet[65], Container& result)
     {
         std::size_t count = 0;
+        first = encode_base64_prefix(first, last, alphabet, result, count);
         unsigned char a3[3];
         unsigned char a4[4];
         unsigned char fill = alphabet[64];
@@ -98,6 +187,7 @@ namespace jsoncons {
         uint8_t i = 0;
         uint8_t j = 0;
 
+        first = decode_base64_prefix(first, last, reverse_alphabet, result);
         while (first != last && *first != '=')
         {
             if (!f(*first))
@@ -144,13 +234,91 @@ namespace jsoncons {
 
     }
 
+    namespace detail {
+
+    template <class InputIt, class Container>
+    InputIt encode_base16_prefix(InputIt first, InputIt, Container&)
+    {
+        return first;
+    }
+
+    template <class T, class Container>
+    typename std::enable_if<std::is_same<typename std::remove_const<T>::type,uint8_t>::value,T*>::type 
+    encode_base16_prefix(T* first, T* last, Container& result)
+    {
+        static constexpr char characters[] = "0123456789ABCDEF";
+
+        char buffer[256];
+        while (first != last)
+        {
+            std::size_t n = 0;
+            while (has_base16_blocks && last - first >= 16 && n + 32 <= sizeof(buffer))
+            {
+                encode_base16_block(first, buffer + n);
+                first += 16;
+                n += 32;
+            }
+            while (first != last && n + 2 <= sizeof(buffer))
+            {
+                buffer[n++] = characters[*first >> 4];
+                buffer[n++] = characters[*first & 0xf];
+                ++first;
+            }
+            append_buffer(result, buffer, n);
+        }
+        return first;
+    }
+
+    template <class InputIt, class Container>
+    InputIt decode_base16_prefix(InputIt first, InputIt, Container&)
+    {
+        return first;
+    }
+
+    inline
+    uint8_t hex_digit_value(uint8_t c)
+    {
+        return c >= '0' && c <= '9' ? static_cast<uint8_t>(c - '0') 
+            : (c | 0x20) >= 'a' && (c | 0x20) <= 'f' ? static_cast<uint8_t>((c | 0x20) - 'a' + 10) : 0xff;
+    }
+
+    template <class CharT, class Container>
+    typename std::enable_if<sizeof(CharT) == sizeof(uint8_t),CharT*>::type 
+    decode_base16_prefix(CharT* first, CharT* last, Container& result)
+    {
+        using value_type = typename Container::value_type;
+
+        uint8_t buffer[256];
+        bool more = true;
+        while (more && last - first >= 2)
+        {
+            std::size_t n = 0;
+            while (last - first >= 2 && n < sizeof(buffer))
+            {
+                uint8_t hi = hex_digit_value(static_cast<uint8_t>(first[0]));
+                uint8_t lo = hex_digit_value(static_cast<uint8_t>(first[1]));
+                if (((hi | lo) & 0x80) != 0)
+                {
+                    more = false;
+                    break;
+                }
+                buffer[n++] = static_cast<uint8_t>((hi << 4) | lo);
+                first += 2;
+            }
+            append_buffer(result, reinterpret_cast<const value_type*>(buffer), n);
+        }
+        return first;
+    }
+
+    } // namespace detail
+
     template <class InputIt, class Container>
     typename std::enable_if<std::is_same<typename std::iterator_traits<InputIt>::value_type,uint8_t>::value,size_t>::type
     encode_base16(InputIt first, InputIt last, Container& result)
     {
         static constexpr char characters[] = "0123456789ABCDEF";
 
-        for (auto it = first; it != last; ++it)
+        for (auto it = detail::encode_base16_prefix(first, last, result); it != last; ++it)
         {
             uint8_t c = *it;
             result.push_back(characters[c >> 4]);
@@ -270,7 +438,7 @@ namespace jsoncons {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Cannot decode encoded base16 string - odd length"));
         }
 
-        InputIt it = first;
+        InputIt it = detail::decode_base16_prefix(first, last, result);
         while (it != last)
         {
             uint8_t val;
@@ -539,12 +707,12 @@ namespace jsoncons {
         void assign(const uint8_t* s, std::size_t count)
         {
             data_.clear();
-            data_.insert(s, s+count);
+            data_.insert(data_.end(), s, s+count);
         }
 
         void append(const uint8_t* s, std::size_t count)
         {
-            data_.insert(s, s+count);
+            data_.insert(data_.end(), s, s+count);
         }
 
         void clear()
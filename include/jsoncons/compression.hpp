@@ -0,0 +1,783 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_COMPRESSION_HPP
+#define JSONCONS_COMPRESSION_HPP
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <memory> // std::unique_ptr, std::addressof
+#include <cstring> // std::memcpy
+#include <exception>
+#include <type_traits> // std::conditional
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+
+// Compressed sources and sinks are available when their library's header is found,
+// unless disabled with JSONCONS_NO_ZLIB or JSONCONS_NO_ZSTD. The program must then
+// link with the library (-lz, -lzstd).
+
+#if !defined(JSONCONS_HAS_ZLIB) && !defined(JSONCONS_NO_ZLIB)
+#  if defined(__has_include)
+#    if __has_include(<zlib.h>)
+#      define JSONCONS_HAS_ZLIB 1
+#    endif
+#  endif
+#endif
+
+#if !defined(JSONCONS_HAS_ZSTD) && !defined(JSONCONS_NO_ZSTD)
+#  if defined(__has_include)
+#    if __has_include(<zstd.h>)
+#      define JSONCONS_HAS_ZSTD 1
+#    endif
+#  endif
+#endif
+
+#if defined(JSONCONS_HAS_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(JSONCONS_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace jsoncons {
+namespace detail {
+
+    template <class CharT>
+    using compressed_traits_type = typename std::conditional<std::is_same<CharT,uint8_t>::value,
+                                                             byte_traits,
+                                                             std::char_traits<CharT>>::type;
+
+    // Common part of the decompressing sources. Decoder decompresses from the
+    // compressed input it is given into a byte range, and reports the end of input.
+
+    template <class CharT,class Decoder>
+    class decompressing_source
+    {
+        static_assert(sizeof(CharT) == 1, "Compressed sources read single byte characters");
+    public:
+        using value_type = CharT;
+        using traits_type = compressed_traits_type<CharT>;
+
+        static constexpr std::size_t default_buffer_length = 16384;
+    private:
+        basic_null_istream<char> null_is_;
+        std::istream* stream_ptr_;
+        std::streambuf* sbuf_;
+        Decoder decoder_;
+        std::vector<uint8_t> input_;
+        std::vector<value_type> output_;
+        std::size_t output_pos_;
+        std::size_t output_end_;
+        std::size_t position_;
+        bool exhausted_;
+        bool eof_;
+        bool is_error_;
+
+        // Noncopyable
+        decompressing_source(const decompressing_source&) = delete;
+        decompressing_source& operator=(const decompressing_source&) = delete;
+    public:
+        decompressing_source()
+            : stream_ptr_(&null_is_), sbuf_(null_is_.rdbuf()),
+              output_pos_(0), output_end_(0), position_(0), exhausted_(true), eof_(false), is_error_(false)
+        {
+        }
+
+        decompressing_source(std::istream& is, std::size_t buflen = default_buffer_length)
+            : stream_ptr_(std::addressof(is)), sbuf_(is.rdbuf()),
+              input_(buflen), output_(buflen),
+              output_pos_(0), output_end_(0), position_(0), exhausted_(false), eof_(false), is_error_(!decoder_)
+        {
+        }
+
+        decompressing_source(decompressing_source&& other) noexcept
+            : stream_ptr_(&null_is_), sbuf_(null_is_.rdbuf()),
+              output_pos_(0), output_end_(0), position_(0), exhausted_(true), eof_(false), is_error_(false)
+        {
+            swap(other);
+        }
+
+        ~decompressing_source() noexcept = default;
+
+        decompressing_source& operator=(decompressing_source&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        // True once a request could not be satisfied, as for stream_source
+        bool eof() const
+        {
+            return eof_;
+        }
+
+        bool is_error() const
+        {
+            return is_error_;
+        }
+
+        std::size_t position() const
+        {
+            return position_;
+        }
+
+        std::size_t get(value_type& c)
+        {
+            if (output_pos_ == output_end_ && !fill_output())
+            {
+                return 0;
+            }
+            c = output_[output_pos_++];
+            ++position_;
+            return 1;
+        }
+
+        int get()
+        {
+            if (output_pos_ == output_end_ && !fill_output())
+            {
+                return traits_type::eof();
+            }
+            ++position_;
+            return static_cast<uint8_t>(output_[output_pos_++]);
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0)
+            {
+                if (output_pos_ == output_end_ && !fill_output())
+                {
+                    return;
+                }
+                std::size_t n = (std::min)(count, output_end_ - output_pos_);
+                output_pos_ += n;
+                position_ += n;
+                count -= n;
+            }
+        }
+
+        int peek()
+        {
+            if (output_pos_ == output_end_ && !fill_output())
+            {
+                return traits_type::eof();
+            }
+            return static_cast<uint8_t>(output_[output_pos_]);
+        }
+
+        // Decompresses straight into p once data left over from get and peek is used up
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t n = (std::min)(length, output_end_ - output_pos_);
+            if (n > 0)
+            {
+                std::memcpy(p, output_.data() + output_pos_, n);
+                output_pos_ += n;
+            }
+            if (n < length)
+            {
+                n += decompress(reinterpret_cast<uint8_t*>(p) + n, length - n);
+                if (n < length)
+                {
+                    eof_ = true;
+                }
+            }
+            position_ += n;
+            return n;
+        }
+    private:
+        void swap(decompressing_source& other) noexcept
+        {
+            // Each keeps its own null stream
+            bool is_null = stream_ptr_ == &null_is_;
+            bool other_is_null = other.stream_ptr_ == &other.null_is_;
+            std::swap(stream_ptr_, other.stream_ptr_);
+            std::swap(sbuf_, other.sbuf_);
+            if (other_is_null)
+            {
+                stream_ptr_ = &null_is_;
+                sbuf_ = null_is_.rdbuf();
+            }
+            if (is_null)
+            {
+                other.stream_ptr_ = &other.null_is_;
+                other.sbuf_ = other.null_is_.rdbuf();
+            }
+            std::swap(decoder_, other.decoder_);
+            input_.swap(other.input_);
+            output_.swap(other.output_);
+            std::swap(output_pos_, other.output_pos_);
+            std::swap(output_end_, other.output_end_);
+            std::swap(position_, other.position_);
+            std::swap(exhausted_, other.exhausted_);
+            std::swap(eof_, other.eof_);
+            std::swap(is_error_, other.is_error_);
+        }
+
+        bool fill_output()
+        {
+            output_pos_ = 0;
+            output_end_ = decompress(reinterpret_cast<uint8_t*>(output_.data()), output_.size());
+            if (output_end_ == 0)
+            {
+                eof_ = true;
+                return false;
+            }
+            return true;
+        }
+
+        std::size_t decompress(uint8_t* data, std::size_t length)
+        {
+            std::size_t count = 0;
+            while (count < length && !exhausted_)
+            {
+                bool more_input = !decoder_.input_exhausted() || fill_input();
+                std::size_t before = count;
+                if (!decoder_.decompress(data + count, length - count, count))
+                {
+                    exhausted_ = true;
+                    is_error_ = true;
+                }
+                else if (!more_input && count == before)
+                {
+                    // The decoder holds no more output
+                    exhausted_ = true;
+                    if (decoder_.partial())
+                    {
+                        is_error_ = true;
+                    }
+                }
+            }
+            return count;
+        }
+
+        bool fill_input()
+        {
+            JSONCONS_TRY
+            {
+                std::streamsize count = sbuf_->sgetn(reinterpret_cast<char*>(input_.data()), input_.size()); // never negative
+                if (count <= 0)
+                {
+                    stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
+                    decoder_.set_input(input_.data(), 0);
+                    return false;
+                }
+                decoder_.set_input(input_.data(), static_cast<std::size_t>(count));
+                return true;
+            }
+            JSONCONS_CATCH(const std::exception&)
+            {
+                stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::badbit | std::ios::eofbit);
+                is_error_ = true;
+                return false;
+            }
+        }
+    };
+
+    // Common part of the compressing sinks. Encoder compresses the bytes it is given
+    // into blocks of output that are written to the stream.
+
+    template <class CharT,class Encoder>
+    class compressing_sink
+    {
+        static_assert(sizeof(CharT) == 1, "Compressed sinks write single byte characters");
+    public:
+        using value_type = CharT;
+        using output_type = std::basic_ostream<char>;
+
+        static constexpr std::size_t default_buffer_length = 16384;
+    private:
+        std::basic_ostream<char>* stream_ptr_;
+        Encoder encoder_;
+        std::vector<CharT> buffer_;
+        std::vector<uint8_t> output_;
+        CharT* begin_buffer_;
+        const CharT* end_buffer_;
+        CharT* p_;
+
+        // Noncopyable
+        compressing_sink(const compressing_sink&) = delete;
+        compressing_sink& operator=(const compressing_sink&) = delete;
+    public:
+        compressing_sink(compressing_sink&&) = default;
+
+        compressing_sink(std::basic_ostream<char>& os, int level, std::size_t buflen)
+            : stream_ptr_(std::addressof(os)), encoder_(level),
+              buffer_(buflen), output_(buflen),
+              begin_buffer_(buffer_.data()), end_buffer_(begin_buffer_+buffer_.size()), p_(begin_buffer_)
+        {
+            if (!encoder_)
+            {
+                stream_ptr_->setstate(std::ios::badbit);
+            }
+        }
+
+        // Writes the remaining output and ends the compressed stream
+        ~compressing_sink() noexcept
+        {
+            if (encoder_)
+            {
+                compress(begin_buffer_, buffer_length(), Encoder::finish);
+                stream_ptr_->flush();
+            }
+        }
+
+        compressing_sink& operator=(compressing_sink&&) = default;
+
+        // Compresses pending output so that everything appended so far can be
+        // decompressed from the stream
+        void flush()
+        {
+            compress(begin_buffer_, buffer_length(), Encoder::flush);
+            stream_ptr_->flush();
+            p_ = begin_buffer_;
+        }
+
+        void append(const CharT* s, std::size_t length)
+        {
+            std::size_t diff = end_buffer_ - p_;
+            if (diff >= length)
+            {
+                std::memcpy(p_, s, length);
+                p_ += length;
+            }
+            else
+            {
+                compress(begin_buffer_, buffer_length(), Encoder::proceed);
+                p_ = begin_buffer_;
+                if (length < buffer_.size())
+                {
+                    std::memcpy(p_, s, length);
+                    p_ += length;
+                }
+                else
+                {
+                    compress(s, length, Encoder::proceed);
+                }
+            }
+        }
+
+        void push_back(CharT ch)
+        {
+            if (p_ < end_buffer_)
+            {
+                *p_++ = ch;
+            }
+            else
+            {
+                compress(begin_buffer_, buffer_length(), Encoder::proceed);
+                p_ = begin_buffer_;
+                *p_++ = ch;
+            }
+        }
+
+        // Returns room for at least length characters, the first count of
+        // which a following call to commit(count) adds to the output
+        CharT* reserve(std::size_t length)
+        {
+            if (static_cast<std::size_t>(end_buffer_ - p_) < length)
+            {
+                compress(begin_buffer_, buffer_length(), Encoder::proceed);
+                if (buffer_.size() < length)
+                {
+                    buffer_.resize(length);
+                    begin_buffer_ = buffer_.data();
+                    end_buffer_ = begin_buffer_ + buffer_.size();
+                }
+                p_ = begin_buffer_;
+            }
+            return p_;
+        }
+
+        void commit(std::size_t count)
+        {
+            p_ += count;
+        }
+    private:
+        std::size_t buffer_length() const
+        {
+            return p_ - begin_buffer_;
+        }
+
+        void compress(const CharT* data, std::size_t length, typename Encoder::mode_type mode)
+        {
+            if (!encoder_)
+            {
+                return;
+            }
+            const std::size_t max_input_length = std::size_t(1) << 30;
+            do
+            {
+                std::size_t n = (std::min)(length, max_input_length);
+                encoder_.set_input(reinterpret_cast<const uint8_t*>(data), n);
+                data += n;
+                length -= n;
+                bool more = true;
+                while (more)
+                {
+                    std::size_t count = 0;
+                    if (!encoder_.compress(output_.data(), output_.size(), count, length == 0 ? mode : Encoder::proceed, more))
+                    {
+                        stream_ptr_->setstate(std::ios::badbit);
+                        return;
+                    }
+                    stream_ptr_->write(reinterpret_cast<const char*>(output_.data()), count);
+                }
+            }
+            while (length > 0);
+        }
+    };
+
+#if defined(JSONCONS_HAS_ZLIB)
+
+    class gzip_decoder
+    {
+        std::unique_ptr<z_stream> stream_;
+        bool partial_;
+    public:
+        gzip_decoder()
+            : stream_(new z_stream()), partial_(false)
+        {
+            // Accept gzip or zlib headers
+            if (inflateInit2(stream_.get(), 15 + 32) != Z_OK)
+            {
+                stream_.reset();
+            }
+        }
+
+        gzip_decoder(gzip_decoder&&) = default;
+
+        ~gzip_decoder() noexcept
+        {
+            if (stream_)
+            {
+                inflateEnd(stream_.get());
+            }
+        }
+
+        gzip_decoder& operator=(gzip_decoder&&) = default;
+
+        explicit operator bool() const
+        {
+            return stream_ != nullptr;
+        }
+
+        bool input_exhausted() const
+        {
+            return !stream_ || stream_->avail_in == 0;
+        }
+
+        // A gzip member has been started but not finished
+        bool partial() const
+        {
+            return partial_;
+        }
+
+        void set_input(const uint8_t* data, std::size_t length)
+        {
+            stream_->next_in = const_cast<Bytef*>(data);
+            stream_->avail_in = static_cast<uInt>(length);
+        }
+
+        bool decompress(uint8_t* data, std::size_t length, std::size_t& count)
+        {
+            if (!stream_)
+            {
+                return false;
+            }
+            stream_->next_out = data;
+            stream_->avail_out = static_cast<uInt>((std::min)(length, std::size_t(1) << 30));
+            uInt available_in = stream_->avail_in;
+            uInt available_out = stream_->avail_out;
+            int rc = inflate(stream_.get(), Z_NO_FLUSH);
+            count += available_out - stream_->avail_out;
+            if (stream_->avail_in != available_in || stream_->avail_out != available_out)
+            {
+                partial_ = true;
+            }
+            switch (rc)
+            {
+                case Z_STREAM_END:
+                    // Concatenated members make up a single stream
+                    partial_ = false;
+                    return inflateReset(stream_.get()) == Z_OK;
+                case Z_OK:
+                case Z_BUF_ERROR:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+    };
+
+    class gzip_encoder
+    {
+        std::unique_ptr<z_stream> stream_;
+    public:
+        using mode_type = int;
+        static constexpr int proceed = Z_NO_FLUSH;
+        static constexpr int flush = Z_SYNC_FLUSH;
+        static constexpr int finish = Z_FINISH;
+
+        gzip_encoder(int level)
+            : stream_(new z_stream())
+        {
+            // Write a gzip header
+            if (deflateInit2(stream_.get(), level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            {
+                stream_.reset();
+            }
+        }
+
+        gzip_encoder(gzip_encoder&&) = default;
+
+        ~gzip_encoder() noexcept
+        {
+            if (stream_)
+            {
+                deflateEnd(stream_.get());
+            }
+        }
+
+        gzip_encoder& operator=(gzip_encoder&&) = default;
+
+        explicit operator bool() const
+        {
+            return stream_ != nullptr;
+        }
+
+        void set_input(const uint8_t* data, std::size_t length)
+        {
+            stream_->next_in = const_cast<Bytef*>(data);
+            stream_->avail_in = static_cast<uInt>(length);
+        }
+
+        bool compress(uint8_t* data, std::size_t length, std::size_t& count, int mode, bool& more)
+        {
+            stream_->next_out = data;
+            stream_->avail_out = static_cast<uInt>(length);
+            int rc = deflate(stream_.get(), mode);
+            if (rc == Z_STREAM_ERROR)
+            {
+                return false;
+            }
+            count = length - stream_->avail_out;
+            more = stream_->avail_out == 0 || (mode == Z_FINISH && rc != Z_STREAM_END);
+            if (mode == Z_FINISH && rc == Z_STREAM_END)
+            {
+                deflateReset(stream_.get());
+            }
+            return true;
+        }
+    };
+
+#endif // defined(JSONCONS_HAS_ZLIB)
+
+#if defined(JSONCONS_HAS_ZSTD)
+
+    class zstd_decoder
+    {
+        struct context_deleter
+        {
+            void operator()(ZSTD_DCtx* context) const noexcept
+            {
+                ZSTD_freeDCtx(context);
+            }
+        };
+
+        std::unique_ptr<ZSTD_DCtx,context_deleter> context_;
+        ZSTD_inBuffer input_;
+        bool partial_;
+    public:
+        zstd_decoder()
+            : context_(ZSTD_createDCtx()), input_{nullptr,0,0}, partial_(false)
+        {
+        }
+
+        explicit operator bool() const
+        {
+            return context_ != nullptr;
+        }
+
+        bool input_exhausted() const
+        {
+            return input_.pos == input_.size;
+        }
+
+        // A frame has been started but not finished
+        bool partial() const
+        {
+            return partial_;
+        }
+
+        void set_input(const uint8_t* data, std::size_t length)
+        {
+            input_.src = data;
+            input_.size = length;
+            input_.pos = 0;
+        }
+
+        bool decompress(uint8_t* data, std::size_t length, std::size_t& count)
+        {
+            if (!context_)
+            {
+                return false;
+            }
+            ZSTD_outBuffer output = {data, length, 0};
+            std::size_t input_pos = input_.pos;
+            std::size_t rc = ZSTD_decompressStream(context_.get(), &output, &input_);
+            count += output.pos;
+            if (ZSTD_isError(rc))
+            {
+                return false;
+            }
+            if (input_.pos != input_pos || output.pos != 0)
+            {
+                // Zero when a frame is complete and fully flushed
+                partial_ = rc != 0;
+            }
+            return true;
+        }
+    };
+
+    class zstd_encoder
+    {
+        struct context_deleter
+        {
+            void operator()(ZSTD_CCtx* context) const noexcept
+            {
+                ZSTD_freeCCtx(context);
+            }
+        };
+
+        std::unique_ptr<ZSTD_CCtx,context_deleter> context_;
+        ZSTD_inBuffer input_;
+    public:
+        using mode_type = ZSTD_EndDirective;
+        static constexpr ZSTD_EndDirective proceed = ZSTD_e_continue;
+        static constexpr ZSTD_EndDirective flush = ZSTD_e_flush;
+        static constexpr ZSTD_EndDirective finish = ZSTD_e_end;
+
+        zstd_encoder(int level)
+            : context_(ZSTD_createCCtx()), input_{nullptr,0,0}
+        {
+            if (context_ && ZSTD_isError(ZSTD_CCtx_setParameter(context_.get(), ZSTD_c_compressionLevel, level)))
+            {
+                context_.reset();
+            }
+        }
+
+        explicit operator bool() const
+        {
+            return context_ != nullptr;
+        }
+
+        void set_input(const uint8_t* data, std::size_t length)
+        {
+            input_.src = data;
+            input_.size = length;
+            input_.pos = 0;
+        }
+
+        bool compress(uint8_t* data, std::size_t length, std::size_t& count, ZSTD_EndDirective mode, bool& more)
+        {
+            ZSTD_outBuffer output = {data, length, 0};
+            std::size_t remaining = ZSTD_compressStream2(context_.get(), &output, &input_, mode);
+            if (ZSTD_isError(remaining))
+            {
+                return false;
+            }
+            count = output.pos;
+            more = mode == ZSTD_e_continue ? input_.pos < input_.size : remaining != 0;
+            return true;
+        }
+    };
+
+#endif // defined(JSONCONS_HAS_ZSTD)
+
+} // namespace detail
+
+#if defined(JSONCONS_HAS_ZLIB)
+
+    // basic_gzip_source
+
+    // Reads gzip (or zlib) compressed input from a stream in chunks,
+    // decompressing straight into the reader's buffer
+
+    template <class CharT>
+    class basic_gzip_source : public detail::decompressing_source<CharT,detail::gzip_decoder>
+    {
+        using base_type = detail::decompressing_source<CharT,detail::gzip_decoder>;
+    public:
+        using base_type::base_type;
+    };
+
+    // basic_gzip_sink
+
+    template <class CharT>
+    class basic_gzip_sink : public detail::compressing_sink<CharT,detail::gzip_encoder>
+    {
+        using base_type = detail::compressing_sink<CharT,detail::gzip_encoder>;
+    public:
+        basic_gzip_sink(std::basic_ostream<char>& os,
+                        int level = Z_DEFAULT_COMPRESSION,
+                        std::size_t buflen = base_type::default_buffer_length)
+            : base_type(os, level, buflen)
+        {
+        }
+    };
+
+    using gzip_source = basic_gzip_source<char>;
+    using binary_gzip_source = basic_gzip_source<uint8_t>;
+    using gzip_sink = basic_gzip_sink<char>;
+    using binary_gzip_sink = basic_gzip_sink<uint8_t>;
+
+#endif // defined(JSONCONS_HAS_ZLIB)
+
+#if defined(JSONCONS_HAS_ZSTD)
+
+    // basic_zstd_source
+
+    // Reads zstd compressed input from a stream in chunks,
+    // decompressing straight into the reader's buffer
+
+    template <class CharT>
+    class basic_zstd_source : public detail::decompressing_source<CharT,detail::zstd_decoder>
+    {
+        using base_type = detail::decompressing_source<CharT,detail::zstd_decoder>;
+    public:
+        using base_type::base_type;
+    };
+
+    // basic_zstd_sink
+
+    template <class CharT>
+    class basic_zstd_sink : public detail::compressing_sink<CharT,detail::zstd_encoder>
+    {
+        using base_type = detail::compressing_sink<CharT,detail::zstd_encoder>;
+    public:
+        basic_zstd_sink(std::basic_ostream<char>& os,
+                        int level = 0,
+                        std::size_t buflen = base_type::default_buffer_length)
+            : base_type(os, level, buflen)
+        {
+        }
+    };
+
+    using zstd_source = basic_zstd_source<char>;
+    using binary_zstd_source = basic_zstd_source<uint8_t>;
+    using zstd_sink = basic_zstd_sink<char>;
+    using binary_zstd_sink = basic_zstd_sink<uint8_t>;
+
+#endif // defined(JSONCONS_HAS_ZSTD)
+
+} // namespace jsoncons
+
+#endif
@@ -226,5 +226,17 @@
 #  define JSONCONS_CPP14_CONSTEXPR
 #endif
 
+// Native 64x64->128 bit multiplication and 128/64 bit division
+#if !defined(JSONCONS_NO_INT128)
+    #if defined(__SIZEOF_INT128__)
+        #define JSONCONS_HAS_INT128
+    #elif defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+        #define JSONCONS_HAS_UMUL128
+        #if _MSC_VER >= 1920
+            #define JSONCONS_HAS_UDIV128
+        #endif
+    #endif
+#endif
+
 #endif // JSONCONS_COMPILER_SUPPORT_HPP
 
@@ -277,6 +277,10 @@ namespace detail {
     using
     container_reserve_t = decltype(std::declval<Container>().reserve(typename Container::size_type()));
 
+    template<class Container, class T>
+    using
+    container_append_t = decltype(std::declval<Container>().append(std::declval<const T*>(), std::size_t()));
+
     template<class Container>
     using
     container_data_t = decltype(std::declval<Container>().data());
@@ -372,6 +376,12 @@ namespace detail {
     using
     has_reserve = is_detected<container_reserve_t, Container>;
 
+    // has_append
+
+    template<class Container, class T>
+    using
+    has_append = is_detected<container_append_t, Container, T>;
+
     // has_push_back
 
     template<class Container>
@@ -162,6 +162,111 @@ bool is_base10(const CharT* s, std::size_t length)
     return state == integer_chars_state::decimal ? true : false;
 }
 
+enum class number_chars_state {initial,minus,zero,integer,fraction1,fraction2,exp1,exp2,exp3};
+
+// Checks that s is a number in JSON syntax, e.g. a bigdec that can be written without quotes
+template <class CharT>
+bool is_json_number(const CharT* s, std::size_t length)
+{
+    number_chars_state state = number_chars_state::initial;
+
+    const CharT* end = s + length; 
+    for (;s < end; ++s)
+    {
+        switch(state)
+        {
+            case number_chars_state::initial:
+            case number_chars_state::minus:
+                switch(*s)
+                {
+                    case '0':
+                        state = number_chars_state::zero;
+                        break;
+                    case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                        state = number_chars_state::integer;
+                        break;
+                    case '-':
+                        if (state != number_chars_state::initial)
+                        {
+                            return false;
+                        }
+                        state = number_chars_state::minus;
+                        break;
+                    default:
+                        return false;
+                }
+                break;
+            case number_chars_state::zero:
+            case number_chars_state::integer:
+                switch(*s)
+                {
+                    case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                        if (state == number_chars_state::zero)
+                        {
+                            return false;
+                        }
+                        break;
+                    case '.':
+                        state = number_chars_state::fraction1;
+                        break;
+                    case 'e':case 'E':
+                        state = number_chars_state::exp1;
+                        break;
+                    default:
+                        return false;
+                }
+                break;
+            case number_chars_state::fraction1:
+            case number_chars_state::fraction2:
+                switch(*s)
+                {
+                    case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                        state = number_chars_state::fraction2;
+                        break;
+                    case 'e':case 'E':
+                        if (state == number_chars_state::fraction1)
+                        {
+                            return false;
+                        }
+                        state = number_chars_state::exp1;
+                        break;
+                    default:
+                        return false;
+                }
+                break;
+            case number_chars_state::exp1:
+            case number_chars_state::exp2:
+                switch(*s)
+                {
+                    case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                        state = number_chars_state::exp3;
+                        break;
+                    case '+':case '-':
+                        if (state == number_chars_state::exp2)
+                        {
+                            return false;
+                        }
+                        state = number_chars_state::exp2;
+                        break;
+                    default:
+                        return false;
+                }
+                break;
+            case number_chars_state::exp3:
+                switch(*s)
+                {
+                    case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                        break;
+                    default:
+                        return false;
+                }
+                break;
+        }
+    }
+    return state == number_chars_state::zero || state == number_chars_state::integer ||
+           state == number_chars_state::fraction2 || state == number_chars_state::exp3;
+}
+
 template <class T, class CharT>
 typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value,to_integer_result<T>>::type
 to_integer(const CharT* s, std::size_t length)
@@ -0,0 +1,472 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SIMD_HPP
+#define JSONCONS_DETAIL_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized scanning is used when the target supports SSE2 (all x86-64 targets) or AVX2,
+// and can be turned off by defining JSONCONS_NO_SIMD
+
+#if !defined(JSONCONS_NO_SIMD)
+#  if defined(__AVX2__)
+#    define JSONCONS_HAS_AVX2
+#  endif
+#  if defined(__SSSE3__) || defined(__AVX2__)
+#    define JSONCONS_HAS_SSSE3
+#  endif
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define JSONCONS_HAS_SSE2
+#  endif
+#endif
+
+#if defined(JSONCONS_HAS_AVX2)
+#  include <immintrin.h>
+#elif defined(JSONCONS_HAS_SSSE3)
+#  include <tmmintrin.h>
+#elif defined(JSONCONS_HAS_SSE2)
+#  include <emmintrin.h>
+#endif
+#if (defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2)) && defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+namespace jsoncons {
+namespace detail {
+
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2)
+    // x must not be zero
+    inline
+    unsigned count_trailing_zeros(uint32_t x)
+    {
+    #if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward(&index, x);
+        return static_cast<unsigned>(index);
+    #else
+        return static_cast<unsigned>(__builtin_ctz(x));
+    #endif
+    }
+#endif
+
+    // Returns a pointer to the first char in [first,last) that a JSON string cannot hold as is:
+    // a quote, backslash, control character or DEL, '/' if escape_solidus, and any byte
+    // of a multi-byte UTF-8 sequence if escape_all_non_ascii. Returns last if there is none.
+    inline
+    const char* find_escape_char(const char* first, const char* last,
+                                 bool escape_all_non_ascii, bool escape_solidus)
+    {
+        const char* p = first;
+    #if defined(JSONCONS_HAS_AVX2)
+        {
+            const __m256i quote = _mm256_set1_epi8('\"');
+            const __m256i backslash = _mm256_set1_epi8('\\');
+            const __m256i solidus = _mm256_set1_epi8(escape_solidus ? '/' : '\"');
+            const __m256i del = _mm256_set1_epi8(0x7f);
+            const __m256i max_control = _mm256_set1_epi8(0x1f);
+            while (last - p >= 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                __m256i special = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, solidus), _mm256_cmpeq_epi8(v, del)));
+                special = _mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_max_epu8(v, max_control), max_control));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+                if (escape_all_non_ascii)
+                {
+                    mask |= static_cast<uint32_t>(_mm256_movemask_epi8(v));
+                }
+                if (mask != 0)
+                {
+                    return p + count_trailing_zeros(mask);
+                }
+                p += 32;
+            }
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        {
+            const __m128i quote = _mm_set1_epi8('\"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i solidus = _mm_set1_epi8(escape_solidus ? '/' : '\"');
+            const __m128i del = _mm_set1_epi8(0x7f);
+            const __m128i max_control = _mm_set1_epi8(0x1f);
+            while (last - p >= 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, solidus), _mm_cmpeq_epi8(v, del)));
+                special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_max_epu8(v, max_control), max_control));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+                if (escape_all_non_ascii)
+                {
+                    mask |= static_cast<uint32_t>(_mm_movemask_epi8(v));
+                }
+                if (mask != 0)
+                {
+                    return p + count_trailing_zeros(mask);
+                }
+                p += 16;
+            }
+        }
+    #endif
+        for (; p != last; ++p)
+        {
+            uint8_t c = static_cast<uint8_t>(*p);
+            if (c <= 0x1f || c == 0x7f || c == '\"' || c == '\\' || (escape_solidus && c == '/') || (escape_all_non_ascii && c >= 0x80))
+            {
+                return p;
+            }
+        }
+        return last;
+    }
+
+    // Returns a pointer to the first char in [first,last) that a JSON parser must look at inside
+    // a string: a quote, backslash, control character, or a byte of a multi-byte UTF-8 sequence.
+    // Returns last if there is none.
+    inline
+    const char* find_string_special(const char* first, const char* last)
+    {
+        const char* p = first;
+    #if defined(JSONCONS_HAS_SSE2)
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i max_control = _mm_set1_epi8(0x1f);
+        while (last - p >= 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                           _mm_cmpeq_epi8(_mm_max_epu8(v, max_control), max_control));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special) | _mm_movemask_epi8(v));
+            if (mask != 0)
+            {
+                return p + count_trailing_zeros(mask);
+            }
+            p += 16;
+        }
+    #endif
+        for (; p != last; ++p)
+        {
+            uint8_t c = static_cast<uint8_t>(*p);
+            if (c <= 0x1f || c == '\"' || c == '\\' || c >= 0x80)
+            {
+                return p;
+            }
+        }
+        return last;
+    }
+
+    // UTF-8 validation by table lookup on the high and low nibbles of each byte and its predecessor,
+    // after Keiser and Lemire, "Validating UTF-8 in less than one instruction per byte" (2021).
+    // The error flags of the three lookups are ANDed, so a flag survives only if all three agree.
+
+    namespace utf8_flags {
+        const uint8_t too_short = 1 << 0;      // lead byte not followed by enough continuation bytes
+        const uint8_t too_long = 1 << 1;       // ASCII followed by a continuation byte
+        const uint8_t overlong_3 = 1 << 2;
+        const uint8_t too_large = 1 << 3;      // above U+10FFFF
+        const uint8_t surrogate = 1 << 4;
+        const uint8_t overlong_2 = 1 << 5;
+        const uint8_t too_large_1000 = 1 << 6;
+        const uint8_t overlong_4 = 1 << 6;
+        const uint8_t two_conts = 1 << 7;      // continuation following continuation
+        const uint8_t carry = too_short | too_long | two_conts;
+    }
+
+#if defined(JSONCONS_HAS_SSSE3)
+    #define JSONCONS_UTF8_TABLES(SETR) \
+        const auto byte_1_high = SETR( \
+            too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long, \
+            two_conts, two_conts, two_conts, two_conts, \
+            too_short | overlong_2, \
+            too_short, \
+            too_short | overlong_3 | surrogate, \
+            too_short | too_large | too_large_1000 | overlong_4); \
+        const auto byte_1_low = SETR( \
+            carry | overlong_3 | overlong_2 | overlong_4, \
+            carry | overlong_2, \
+            carry, \
+            carry, \
+            carry | too_large, \
+            carry | too_large | too_large_1000, \
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000, \
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000, \
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000, \
+            carry | too_large | too_large_1000, \
+            carry | too_large | too_large_1000 | surrogate, \
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000); \
+        const auto byte_2_high = SETR( \
+            too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short, \
+            too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4, \
+            too_long | overlong_2 | two_conts | overlong_3 | too_large, \
+            too_long | overlong_2 | two_conts | surrogate | too_large, \
+            too_long | overlong_2 | two_conts | surrogate | too_large, \
+            too_short, too_short, too_short, too_short)
+
+    inline
+    __m128i setr_epi8x16(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint8_t b5, uint8_t b6, uint8_t b7,
+                         uint8_t b8, uint8_t b9, uint8_t b10, uint8_t b11, uint8_t b12, uint8_t b13, uint8_t b14, uint8_t b15)
+    {
+        return _mm_setr_epi8(static_cast<char>(b0), static_cast<char>(b1), static_cast<char>(b2), static_cast<char>(b3),
+                             static_cast<char>(b4), static_cast<char>(b5), static_cast<char>(b6), static_cast<char>(b7),
+                             static_cast<char>(b8), static_cast<char>(b9), static_cast<char>(b10), static_cast<char>(b11),
+                             static_cast<char>(b12), static_cast<char>(b13), static_cast<char>(b14), static_cast<char>(b15));
+    }
+#endif
+
+#if defined(JSONCONS_HAS_AVX2)
+    inline
+    __m256i setr_epi8x32(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint8_t b5, uint8_t b6, uint8_t b7,
+                         uint8_t b8, uint8_t b9, uint8_t b10, uint8_t b11, uint8_t b12, uint8_t b13, uint8_t b14, uint8_t b15)
+    {
+        __m128i lo = setr_epi8x16(b0,b1,b2,b3,b4,b5,b6,b7,b8,b9,b10,b11,b12,b13,b14,b15);
+        return _mm256_broadcastsi128_si256(lo);
+    }
+
+    // Returns non-zero bytes where the 32 bytes of input, preceded by prev_input, are not valid UTF-8,
+    // not counting sequences left incomplete at the end of input
+    inline
+    __m256i utf8_errors(__m256i input, __m256i prev_input)
+    {
+        using namespace utf8_flags;
+        JSONCONS_UTF8_TABLES(setr_epi8x32);
+
+        const __m256i low_nibble = _mm256_set1_epi8(0x0f);
+        __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+        __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+        __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+        __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+
+        __m256i special_cases = _mm256_and_si256(
+            _mm256_and_si256(
+                _mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble)),
+                _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, low_nibble))),
+            _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble)));
+
+        // The third and fourth bytes of three and four byte sequences must be continuations
+        __m256i is_third_byte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xe0u - 0x80)));
+        __m256i is_fourth_byte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xf0u - 0x80)));
+        __m256i must23_80 = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), 
+                                             _mm256_set1_epi8(static_cast<char>(0x80)));
+        return _mm256_xor_si256(must23_80, special_cases);
+    }
+#elif defined(JSONCONS_HAS_SSSE3)
+    // Returns non-zero bytes where the 16 bytes of input, preceded by prev_input, are not valid UTF-8,
+    // not counting sequences left incomplete at the end of input
+    inline
+    __m128i utf8_errors(__m128i input, __m128i prev_input)
+    {
+        using namespace utf8_flags;
+        JSONCONS_UTF8_TABLES(setr_epi8x16);
+
+        const __m128i low_nibble = _mm_set1_epi8(0x0f);
+        __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+        __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+        __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+
+        __m128i special_cases = _mm_and_si128(
+            _mm_and_si128(
+                _mm_shuffle_epi8(byte_1_high, _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble)),
+                _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, low_nibble))),
+            _mm_shuffle_epi8(byte_2_high, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble)));
+
+        // The third and fourth bytes of three and four byte sequences must be continuations
+        __m128i is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xe0u - 0x80)));
+        __m128i is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xf0u - 0x80)));
+        __m128i must23_80 = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), 
+                                          _mm_set1_epi8(static_cast<char>(0x80)));
+        return _mm_xor_si128(must23_80, special_cases);
+    }
+#endif
+#if defined(JSONCONS_HAS_SSSE3)
+    #undef JSONCONS_UTF8_TABLES
+#endif
+
+    // Whether skip_valid_utf8 validates multi-byte sequences, or only skips ASCII
+#if defined(JSONCONS_HAS_SSSE3)
+    const bool skips_multibyte_utf8 = true;
+#else
+    const bool skips_multibyte_utf8 = false;
+#endif
+
+    // Returns a pointer p such that [first,p) is valid UTF-8 and p is at the start of a sequence. 
+    // p may stop short of last anywhere before an error or the end, so callers validate
+    // the bytes from p on by other means.
+    inline
+    const uint8_t* skip_valid_utf8(const uint8_t* first, const uint8_t* last)
+    {
+        const uint8_t* p = first;
+    #if defined(JSONCONS_HAS_AVX2)
+        // Non-zero where a block ends with the lead byte of a sequence that needs more bytes
+        const __m256i max_value = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
+                                                   -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
+                                                   static_cast<char>(0xf0u - 1), static_cast<char>(0xe0u - 1), static_cast<char>(0xc0u - 1));
+        __m256i prev_input = _mm256_setzero_si256();
+        while (last - p >= 32)
+        {
+            __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            __m256i errors = _mm256_movemask_epi8(input) == 0 ? _mm256_subs_epu8(prev_input, max_value) 
+                                                               : utf8_errors(input, prev_input);
+            if (!_mm256_testz_si256(errors, errors))
+            {
+                break;
+            }
+            prev_input = input;
+            p += 32;
+        }
+    #elif defined(JSONCONS_HAS_SSSE3)
+        const __m128i max_value = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                static_cast<char>(0xf0u - 1), static_cast<char>(0xe0u - 1), static_cast<char>(0xc0u - 1));
+        const __m128i zero = _mm_setzero_si128();
+        __m128i prev_input = zero;
+        while (last - p >= 16)
+        {
+            __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i errors = _mm_movemask_epi8(input) == 0 ? _mm_subs_epu8(prev_input, max_value) 
+                                                           : utf8_errors(input, prev_input);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(errors, zero)) != 0xffff)
+            {
+                break;
+            }
+            prev_input = input;
+            p += 16;
+        }
+    #elif defined(JSONCONS_HAS_SSE2)
+        // ASCII only
+        while (last - p >= 16)
+        {
+            __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(input));
+            if (mask != 0)
+            {
+                return p + count_trailing_zeros(mask);
+            }
+            p += 16;
+        }
+    #else
+        (void)last;
+    #endif
+        // Back up to the lead byte of a sequence that may continue past p
+        const uint8_t* start = p;
+        while (start > first && p - start < 3 && (*(start-1) & 0xc0) == 0x80)
+        {
+            --start;
+        }
+        if (start > first && *(start-1) >= 0xc0)
+        {
+            --start;
+        }
+        return start;
+    }
+
+    // Base64 by vector shuffles and multiplies, after Mula and Lemire, "Faster Base64 Encoding 
+    // and Decoding using AVX2 Instructions" (2018). c62 and c63 are the last two chars of the alphabet.
+
+#if defined(JSONCONS_HAS_SSSE3)
+    const bool has_base64_blocks = true;
+
+    // Encodes the first 12 of the 16 bytes at in as 16 chars at out
+    inline
+    void encode_base64_block(const uint8_t* in, char* out, char c62, char c63)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        v = _mm_shuffle_epi8(v, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+        // Spread each 24 bits over four bytes of 6 bits
+        const __m128i t0 = _mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00));
+        const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        const __m128i t2 = _mm_and_si128(v, _mm_set1_epi32(0x003f03f0));
+        const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(t1, t3);
+
+        // Map each range of indices (0-25, 26-51, 52-61, 62, 63) to the offset of its chars 
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        range = _mm_or_si128(range, _mm_and_si128(less, _mm_set1_epi8(13)));
+        const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, 
+                                              '0' - 52, '0' - 52, '0' - 52, '0' - 52, 
+                                              static_cast<char>(c62 - 62), static_cast<char>(c63 - 63), 'A', 0, 0);
+        __m128i result = _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), result);
+    }
+
+    // Decodes 16 chars at in into 12 bytes at out, writing 16 bytes. Returns false, writing nothing, 
+    // if any of the chars is not in the alphabet, including padding.
+    inline
+    bool decode_base64_block(const char* in, uint8_t* out, char c62, char c63)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), v));
+        const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), v));
+        const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), v));
+        const __m128i is62 = _mm_cmpeq_epi8(v, _mm_set1_epi8(c62));
+        const __m128i is63 = _mm_cmpeq_epi8(v, _mm_set1_epi8(c63));
+        __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(_mm_or_si128(digit, is62), is63));
+        if (_mm_movemask_epi8(valid) != 0xffff)
+        {
+            return false;
+        }
+        __m128i shift = _mm_or_si128(
+            _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+            _mm_or_si128(_mm_and_si128(digit, _mm_set1_epi8(52 - '0')), 
+                         _mm_or_si128(_mm_and_si128(is62, _mm_set1_epi8(static_cast<char>(62 - c62))), 
+                                      _mm_and_si128(is63, _mm_set1_epi8(static_cast<char>(63 - c63))))));
+        const __m128i values = _mm_add_epi8(v, shift);
+
+        // Pack each four 6 bit values into 24 bits, then drop every fourth byte
+        const __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        const __m128i result = _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), result);
+        return true;
+    }
+#else
+    const bool has_base64_blocks = false;
+
+    inline
+    void encode_base64_block(const uint8_t*, char*, char, char)
+    {
+    }
+
+    inline
+    bool decode_base64_block(const char*, uint8_t*, char, char)
+    {
+        return false;
+    }
+#endif
+
+#if defined(JSONCONS_HAS_SSE2)
+    const bool has_base16_blocks = true;
+
+    // Encodes the 16 bytes at in as 32 upper case hex digits at out
+    inline
+    void encode_base16_block(const uint8_t* in, char* out)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        const __m128i low_nibble = _mm_set1_epi8(0x0f);
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), low_nibble);
+        __m128i lo = _mm_and_si128(v, low_nibble);
+        // '0' + n, plus 7 more for 'A' to 'F'
+        hi = _mm_add_epi8(_mm_add_epi8(hi, _mm_set1_epi8('0')), _mm_and_si128(_mm_cmpgt_epi8(hi, _mm_set1_epi8(9)), _mm_set1_epi8(7)));
+        lo = _mm_add_epi8(_mm_add_epi8(lo, _mm_set1_epi8('0')), _mm_and_si128(_mm_cmpgt_epi8(lo, _mm_set1_epi8(9)), _mm_set1_epi8(7)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#else
+    const bool has_base16_blocks = false;
+
+    inline
+    void encode_base16_block(const uint8_t*, char*)
+    {
+    }
+#endif
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -17,6 +17,7 @@
 #include <jsoncons/json_options.hpp>
 #include <jsoncons/detail/grisu3.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/sink.hpp>
 
 namespace jsoncons { 
 namespace detail {
@@ -36,40 +37,37 @@ namespace detail {
         using char_type = typename Result::value_type;
 
         char_type buf[255];
-        char_type *p = buf;
-        const char_type* last = buf+255;
+        char_type* const last = buf+255;
+        char_type *p = last;
 
         bool is_negative = value < 0;
 
+        // Digits are written backwards from the end of buf and appended at once
         if (value < 0)
         {
             do
             {
-                *p++ = static_cast<char_type>(48 - (value % 10));
+                *--p = static_cast<char_type>(48 - (value % 10));
             }
-            while ((value /= 10) && (p < last));
+            while ((value /= 10) && (p > buf));
         }
         else
         {
 
             do
             {
-                *p++ = static_cast<char_type>(48 + value % 10);
+                *--p = static_cast<char_type>(48 + value % 10);
             }
-            while ((value /= 10) && (p < last));
+            while ((value /= 10) && (p > buf));
         }
-        JSONCONS_ASSERT(p != last);
+        JSONCONS_ASSERT(p != buf);
 
-        std::size_t count = (p - buf);
         if (is_negative)
         {
-            result.push_back('-');
-            ++count;
-        }
-        while (--p >= buf)
-        {
-            result.push_back(*p);
+            *--p = '-';
         }
+        std::size_t count = (last - p);
+        append_buffer(result, p, count);
 
         return count;
     }
@@ -481,6 +479,15 @@ namespace detail {
 
         write_double& operator=(const write_double&) = default;
 
+        // The most characters written by operator() with general format and no precision,
+        // e.g. -1.2345678901234567e-308
+        static constexpr std::size_t max_general_length = 32;
+
+        bool is_general() const
+        {
+            return float_format_ == float_chars_format::general && precision_ == 0;
+        }
+
         template<class Result>
         std::size_t operator()(double val, Result& result)
         {
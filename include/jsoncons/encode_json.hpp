@@ -65,6 +65,106 @@ namespace jsoncons {
         }
     }
 
+    // to exactly sized string
+
+    template <class T, class CharT>
+    typename std::enable_if<is_basic_json<T>::value>::type
+    encode_json(exact_size_arg_t,
+                const T& val,
+                std::basic_string<CharT>& s, 
+                const basic_json_encode_options<CharT>& options = basic_json_encode_options<CharT>(), 
+                indenting line_indent = indenting::no_indent)
+    {
+        val.dump(exact_size_arg, s, options, line_indent);
+    }
+
+    template <class T, class CharT>
+    typename std::enable_if<!is_basic_json<T>::value>::type
+    encode_json(exact_size_arg_t,
+                const T& val,
+                std::basic_string<CharT>& s, 
+                const basic_json_encode_options<CharT>& options = basic_json_encode_options<CharT>(), 
+                indenting line_indent = indenting::no_indent)
+    {
+        // Measure the output, then write it into s grown once by exactly that length
+        std::size_t length = 0;
+        if (line_indent == indenting::indent)
+        {
+            basic_json_encoder<CharT,jsoncons::counting_sink<CharT>> encoder(length, options);
+            encode_json(val, encoder);
+        }
+        else
+        {
+            basic_json_compressed_encoder<CharT,jsoncons::counting_sink<CharT>> encoder(length, options);
+            encode_json(val, encoder);
+        }
+
+        // On failure s is restored to its original size
+        std::size_t offset = s.size();
+        s.resize(offset + length);
+        JSONCONS_TRY
+        {
+            if (line_indent == indenting::indent)
+            {
+                basic_json_encoder<CharT,jsoncons::unchecked_sink<CharT>> encoder(&s[0] + offset, options);
+                encode_json(val, encoder);
+            }
+            else
+            {
+                basic_json_compressed_encoder<CharT,jsoncons::unchecked_sink<CharT>> encoder(&s[0] + offset, options);
+                encode_json(val, encoder);
+            }
+        }
+        JSONCONS_CATCH(...)
+        {
+            s.resize(offset);
+            JSONCONS_RETHROW;
+        }
+    }
+
+    // to gather buffer
+
+    template <class T, class CharT>
+    typename std::enable_if<is_basic_json<T>::value>::type
+    encode_json(const T& val,
+                gather_buffer<CharT>& buf, 
+                const basic_json_encode_options<CharT>& options = basic_json_encode_options<CharT>(), 
+                indenting line_indent = indenting::no_indent)
+    {
+        // The strings of val outlive the segments, so long runs that need no escaping are referenced
+        using sink_type = jsoncons::detail::referencing_gather_sink<CharT>;
+        if (line_indent == indenting::indent)
+        {
+            basic_json_encoder<CharT,sink_type> encoder(sink_type(buf), options);
+            val.dump(encoder);
+        }
+        else
+        {
+            basic_json_compressed_encoder<CharT,sink_type> encoder(sink_type(buf), options);
+            val.dump(encoder);
+        }
+    }
+
+    template <class T, class CharT>
+    typename std::enable_if<!is_basic_json<T>::value>::type
+    encode_json(const T& val,
+                gather_buffer<CharT>& buf, 
+                const basic_json_encode_options<CharT>& options = basic_json_encode_options<CharT>(), 
+                indenting line_indent = indenting::no_indent)
+    {
+        // ser_traits may pass strings of temporaries, so all output is copied
+        if (line_indent == indenting::indent)
+        {
+            basic_json_encoder<CharT,gather_sink<CharT>> encoder(gather_sink<CharT>(buf), options);
+            encode_json(val, encoder);
+        }
+        else
+        {
+            basic_json_compressed_encoder<CharT,gather_sink<CharT>> encoder(gather_sink<CharT>(buf), options);
+            encode_json(val, encoder);
+        }
+    }
+
     // to stream
 
     template <class T, class CharT>
@@ -19,15 +19,151 @@
 #include <utility> // std::move
 #include <cassert> // assert
 #include <type_traits> // std::enable_if
+#include <atomic> // std::atomic
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/allocator_holder.hpp>
+#include <jsoncons/typed_array_view.hpp>
 
 namespace jsoncons {
 
+    namespace detail {
+
+    // A policy is copy-on-write if it has a member type copy_on_write that is std::true_type
+    template <class Policy, class Enable = void>
+    struct is_copy_on_write_policy : std::false_type {};
+
+    template <class Policy>
+    struct is_copy_on_write_policy<Policy,typename std::enable_if<Policy::copy_on_write::value>::type> : std::true_type {};
+
+    // Reference count of a container that copy-on-write basic_json values share.
+    // Without copy-on-write, a container has exactly one owner.
+    template <bool CopyOnWrite>
+    class container_ref_count
+    {
+    public:
+        void add_ref() const noexcept {}
+        bool release() const noexcept {return true;}
+        bool is_shared() const noexcept {return false;}
+    };
+
+    template <>
+    class container_ref_count<true>
+    {
+        mutable std::atomic<std::size_t> count_;
+    public:
+        container_ref_count() noexcept
+            : count_(1)
+        {
+        }
+
+        container_ref_count(const container_ref_count&) noexcept
+            : count_(1)
+        {
+        }
+
+        container_ref_count& operator=(const container_ref_count&) noexcept
+        {
+            return *this;
+        }
+
+        void add_ref() const noexcept
+        {
+            count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Returns true if the caller held the last reference
+        bool release() const noexcept
+        {
+            return count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+        bool is_shared() const noexcept
+        {
+            return count_.load(std::memory_order_acquire) > 1;
+        }
+    };
+
+    // The size in bytes of a basic_json value, 16 unless a policy has a member type variant_size
+    template <class Policy, class Enable = void>
+    struct policy_variant_size : std::integral_constant<std::size_t,16> {};
+
+    template <class Policy>
+    struct policy_variant_size<Policy,typename std::enable_if<(Policy::variant_size::value > 0)>::type> 
+        : std::integral_constant<std::size_t,Policy::variant_size::value> {};
+
+    // A policy caches hashes if it has a member type cache_hash that is std::true_type
+    template <class Policy, class Enable = void>
+    struct is_cached_hash_policy : std::false_type {};
+
+    template <class Policy>
+    struct is_cached_hash_policy<Policy,typename std::enable_if<Policy::cache_hash::value>::type> : std::true_type {};
+
+    // Structural hash of a container whose elements are not themselves arrays or objects,
+    // computed on demand and cleared by non-const access
+    template <bool CacheHash>
+    class container_hash_cache
+    {
+    public:
+        bool get_cached_hash(std::size_t&) const noexcept {return false;}
+        void set_cached_hash(std::size_t) const noexcept {}
+        void invalidate_hash() const noexcept {}
+        bool hash_differs(const container_hash_cache&) const noexcept {return false;}
+    };
+
+    template <>
+    class container_hash_cache<true>
+    {
+        // 0 means not computed
+        mutable std::atomic<std::size_t> hash_;
+    public:
+        container_hash_cache() noexcept
+            : hash_(0)
+        {
+        }
+
+        container_hash_cache(const container_hash_cache& other) noexcept
+            : hash_(other.hash_.load(std::memory_order_relaxed))
+        {
+        }
+
+        container_hash_cache& operator=(const container_hash_cache& other) noexcept
+        {
+            hash_.store(other.hash_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+        bool get_cached_hash(std::size_t& h) const noexcept
+        {
+            h = hash_.load(std::memory_order_relaxed);
+            return h != 0;
+        }
+
+        void set_cached_hash(std::size_t h) const noexcept
+        {
+            hash_.store(h != 0 ? h : 1, std::memory_order_relaxed);
+        }
+
+        void invalidate_hash() const noexcept
+        {
+            hash_.store(0, std::memory_order_relaxed);
+        }
+
+        // True if both hashes are cached and differ, in which case the containers are not equal
+        bool hash_differs(const container_hash_cache& other) const noexcept
+        {
+            std::size_t h1, h2;
+            return get_cached_hash(h1) && other.get_cached_hash(h2) && h1 != h2;
+        }
+    };
+
+    } // namespace detail
+
     // json_array
 
     template <class Json>
-    class json_array : public allocator_holder<typename Json::allocator_type>
+    class json_array : public allocator_holder<typename Json::allocator_type>, 
+        public detail::container_ref_count<detail::is_copy_on_write_policy<typename Json::implementation_policy>::value>,
+        public detail::container_hash_cache<detail::is_cached_hash_policy<typename Json::implementation_policy>::value>
     {
     public:
         using allocator_type = typename Json::allocator_type;
@@ -78,6 +214,8 @@ namespace jsoncons {
         }
         json_array(const json_array& val)
             : allocator_holder<allocator_type>(val.get_allocator()),
+              detail::container_ref_count<detail::is_copy_on_write_policy<typename Json::implementation_policy>::value>(),
+              detail::container_hash_cache<detail::is_cached_hash_policy<typename Json::implementation_policy>::value>(val),
               elements_(val.elements_)
         {
         }
@@ -269,6 +407,14 @@ namespace jsoncons {
 
         bool operator==(const json_array<Json>& rhs) const
         {
+            if (this == &rhs)
+            {
+                return true;
+            }
+            if (this->hash_differs(rhs))
+            {
+                return false;
+            }
             return elements_ == rhs.elements_;
         }
 
@@ -290,6 +436,11 @@ namespace jsoncons {
                 {
                     case storage_kind::array_value:
                     {
+                        // A shared container still has other owners 
+                        if (static_cast<const value_type&>(current).array_value().is_shared())
+                        {
+                            break;
+                        }
                         for (auto&& item : current.array_range())
                         {
                             if (item.size() > 0) // non-empty object or array
@@ -303,6 +454,10 @@ namespace jsoncons {
                     }
                     case storage_kind::object_value:
                     {
+                        if (static_cast<const value_type&>(current).object_value().is_shared())
+                        {
+                            break;
+                        }
                         for (auto&& kv : current.object_range())
                         {
                             if (kv.value().size() > 0) // non-empty object or array
@@ -321,6 +476,274 @@ namespace jsoncons {
         }
     };
 
+    // json_typed_array
+
+    // Packed storage for a homogeneous array of numbers. The elements are kept
+    // in one contiguous buffer; an array of json values is only built, once, 
+    // when the elements are accessed by reference.
+    template <class Json>
+    class json_typed_array : public allocator_holder<typename Json::allocator_type>, 
+        public detail::container_ref_count<detail::is_copy_on_write_policy<typename Json::implementation_policy>::value>
+    {
+    public:
+        using allocator_type = typename Json::allocator_type;
+        using value_type = Json;
+        using array_type = json_array<Json>;
+    private:
+        using word_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint64_t>;
+        using word_pointer = typename std::allocator_traits<word_allocator_type>::pointer;
+        using array_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<array_type>;
+        using array_pointer = typename std::allocator_traits<array_allocator_type>::pointer;
+
+        typed_array_type type_;
+        std::size_t size_;
+        std::size_t word_count_;
+        word_pointer words_;
+        mutable std::atomic<array_type*> elements_;
+    public:
+        using allocator_holder<allocator_type>::get_allocator;
+
+        template <class T>
+        json_typed_array(const span<const T>& data, const allocator_type& alloc = allocator_type())
+            : allocator_holder<allocator_type>(alloc), 
+              type_(jsoncons::detail::typed_array_element_traits<T>::type), 
+              size_(data.size()), word_count_(0), words_(nullptr), elements_(nullptr)
+        {
+            assign(data.data(), data.size()*sizeof(T));
+        }
+
+        json_typed_array(half_array_arg_t, const span<const uint16_t>& data, const allocator_type& alloc = allocator_type())
+            : allocator_holder<allocator_type>(alloc), 
+              type_(typed_array_type::half_value), 
+              size_(data.size()), word_count_(0), words_(nullptr), elements_(nullptr)
+        {
+            assign(data.data(), data.size()*sizeof(uint16_t));
+        }
+
+        json_typed_array(const json_typed_array& other)
+            : allocator_holder<allocator_type>(other.get_allocator()), 
+              detail::container_ref_count<detail::is_copy_on_write_policy<typename Json::implementation_policy>::value>(),
+              type_(other.type_), size_(other.size_), word_count_(0), words_(nullptr), elements_(nullptr)
+        {
+            assign(other.data(), other.size_in_bytes());
+        }
+
+        json_typed_array(const json_typed_array& other, const allocator_type& alloc)
+            : allocator_holder<allocator_type>(alloc), 
+              type_(other.type_), size_(other.size_), word_count_(0), words_(nullptr), elements_(nullptr)
+        {
+            assign(other.data(), other.size_in_bytes());
+        }
+
+        ~json_typed_array() noexcept
+        {
+            release_elements();
+            if (words_ != nullptr)
+            {
+                word_allocator_type alloc(get_allocator());
+                std::allocator_traits<word_allocator_type>::deallocate(alloc, words_, word_count_);
+            }
+        }
+
+        json_typed_array& operator=(const json_typed_array&) = delete;
+
+        typed_array_type type() const
+        {
+            return type_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        const void* data() const
+        {
+            return jsoncons::detail::to_plain_pointer(words_);
+        }
+
+        std::size_t size_in_bytes() const
+        {
+            return size_*jsoncons::detail::typed_array_element_size(type_);
+        }
+
+        typed_array_view view() const
+        {
+            switch (type_)
+            {
+                case typed_array_type::uint8_value:
+                    return typed_array_view(static_cast<const uint8_t*>(data()), size_);
+                case typed_array_type::uint16_value:
+                    return typed_array_view(static_cast<const uint16_t*>(data()), size_);
+                case typed_array_type::uint32_value:
+                    return typed_array_view(static_cast<const uint32_t*>(data()), size_);
+                case typed_array_type::uint64_value:
+                    return typed_array_view(static_cast<const uint64_t*>(data()), size_);
+                case typed_array_type::int8_value:
+                    return typed_array_view(static_cast<const int8_t*>(data()), size_);
+                case typed_array_type::int16_value:
+                    return typed_array_view(static_cast<const int16_t*>(data()), size_);
+                case typed_array_type::int32_value:
+                    return typed_array_view(static_cast<const int32_t*>(data()), size_);
+                case typed_array_type::int64_value:
+                    return typed_array_view(static_cast<const int64_t*>(data()), size_);
+                case typed_array_type::half_value:
+                    return typed_array_view(half_array_arg, static_cast<const uint16_t*>(data()), size_);
+                case typed_array_type::float_value:
+                    return typed_array_view(static_cast<const float*>(data()), size_);
+                case typed_array_type::double_value:
+                    return typed_array_view(static_cast<const double*>(data()), size_);
+                default:
+                    return typed_array_view();
+            }
+        }
+
+        // Returns element i by value
+        Json at(std::size_t i) const
+        {
+            switch (type_)
+            {
+                case typed_array_type::uint8_value:
+                    return Json(static_cast<const uint8_t*>(data())[i], semantic_tag::none);
+                case typed_array_type::uint16_value:
+                    return Json(static_cast<const uint16_t*>(data())[i], semantic_tag::none);
+                case typed_array_type::uint32_value:
+                    return Json(static_cast<const uint32_t*>(data())[i], semantic_tag::none);
+                case typed_array_type::uint64_value:
+                    return Json(static_cast<const uint64_t*>(data())[i], semantic_tag::none);
+                case typed_array_type::int8_value:
+                    return Json(static_cast<const int8_t*>(data())[i], semantic_tag::none);
+                case typed_array_type::int16_value:
+                    return Json(static_cast<const int16_t*>(data())[i], semantic_tag::none);
+                case typed_array_type::int32_value:
+                    return Json(static_cast<const int32_t*>(data())[i], semantic_tag::none);
+                case typed_array_type::int64_value:
+                    return Json(static_cast<const int64_t*>(data())[i], semantic_tag::none);
+                case typed_array_type::half_value:
+                    return Json(half_arg, static_cast<const uint16_t*>(data())[i], semantic_tag::none);
+                case typed_array_type::float_value:
+                    return Json(static_cast<double>(static_cast<const float*>(data())[i]), semantic_tag::none);
+                case typed_array_type::double_value:
+                    return Json(static_cast<const double*>(data())[i], semantic_tag::none);
+                default:
+                    return Json();
+            }
+        }
+
+        // Builds an array of json values holding the same elements
+        array_type to_array() const
+        {
+            array_type a(get_allocator());
+            a.reserve(size_);
+            for (std::size_t i = 0; i < size_; ++i)
+            {
+                a.push_back(at(i));
+            }
+            return a;
+        }
+
+        // Moves out the elements as an array of json values, reusing the array 
+        // built by elements() if there is one
+        array_type take_array()
+        {
+            array_type* p = elements_.exchange(nullptr, std::memory_order_acq_rel);
+            if (p == nullptr)
+            {
+                return to_array();
+            }
+            array_type a(std::move(*p));
+            destroy_elements(p);
+            return a;
+        }
+
+        // Returns the elements as an array of json values, built on first use, for const
+        // accessors that return references to elements. Safe to call concurrently from several readers.
+        const array_type& elements() const
+        {
+            array_type* p = elements_.load(std::memory_order_acquire);
+            if (p == nullptr)
+            {
+                array_allocator_type alloc(get_allocator());
+                array_pointer ptr = std::allocator_traits<array_allocator_type>::allocate(alloc, 1);
+                JSONCONS_TRY
+                {
+                    std::allocator_traits<array_allocator_type>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr), to_array());
+                }
+                JSONCONS_CATCH(...)
+                {
+                    std::allocator_traits<array_allocator_type>::deallocate(alloc, ptr, 1);
+                    JSONCONS_RETHROW;
+                }
+                array_type* expected = nullptr;
+                if (elements_.compare_exchange_strong(expected, jsoncons::detail::to_plain_pointer(ptr), 
+                                                      std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    p = jsoncons::detail::to_plain_pointer(ptr);
+                }
+                else
+                {
+                    destroy_elements(jsoncons::detail::to_plain_pointer(ptr));
+                    p = expected;
+                }
+            }
+            return *p;
+        }
+
+        bool operator==(const json_typed_array& rhs) const
+        {
+            if (size_ != rhs.size_)
+            {
+                return false;
+            }
+            if (type_ == rhs.type_ && type_ != typed_array_type::half_value && 
+                type_ != typed_array_type::float_value && type_ != typed_array_type::double_value)
+            {
+                return size_ == 0 || std::memcmp(data(), rhs.data(), size_in_bytes()) == 0;
+            }
+            for (std::size_t i = 0; i < size_; ++i)
+            {
+                if (at(i) != rhs.at(i))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    private:
+        void assign(const void* p, std::size_t length)
+        {
+            if (length > 0)
+            {
+                word_allocator_type alloc(get_allocator());
+                word_count_ = (length + sizeof(uint64_t) - 1)/sizeof(uint64_t);
+                words_ = std::allocator_traits<word_allocator_type>::allocate(alloc, word_count_);
+                std::memcpy(jsoncons::detail::to_plain_pointer(words_), p, length);
+            }
+        }
+
+        void release_elements() noexcept
+        {
+            array_type* p = elements_.load(std::memory_order_acquire);
+            if (p != nullptr)
+            {
+                destroy_elements(p);
+            }
+        }
+
+        void destroy_elements(array_type* p) const noexcept
+        {
+            array_allocator_type alloc(get_allocator());
+            array_pointer ptr = std::pointer_traits<array_pointer>::pointer_to(*p);
+            std::allocator_traits<array_allocator_type>::destroy(alloc, p);
+            std::allocator_traits<array_allocator_type>::deallocate(alloc, ptr, 1);
+        }
+    };
+
     struct sorted_unique_range_tag
     {
         explicit sorted_unique_range_tag() = default; 
@@ -530,7 +953,9 @@ namespace jsoncons {
     // Sort keys
     template <class KeyT,class Json>
     class json_object<KeyT,Json,typename std::enable_if<std::is_same<typename Json::implementation_policy::key_order,sort_key_order>::value>::type> : 
-        public allocator_holder<typename Json::allocator_type>
+        public allocator_holder<typename Json::allocator_type>, 
+        public detail::container_ref_count<detail::is_copy_on_write_policy<typename Json::implementation_policy>::value>,
+        public detail::container_hash_cache<detail::is_cached_hash_policy<typename Json::implementation_policy>::value>
     {
     public:
         using allocator_type = typename Json::allocator_type;
@@ -563,6 +988,8 @@ namespace jsoncons {
 
         json_object(const json_object& val)
             : allocator_holder<allocator_type>(val.get_allocator()),
+              detail::container_ref_count<detail::is_copy_on_write_policy<typename Json::implementation_policy>::value>(),
+              detail::container_hash_cache<detail::is_cached_hash_policy<typename Json::implementation_policy>::value>(val),
               members_(val.members_)
         {
         }
@@ -753,8 +1180,26 @@ namespace jsoncons {
             {
                 members_.emplace_back(convert(*s));
             }
-            std::stable_sort(members_.begin(),members_.end(),
-                             [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;});
+            normalize();
+        }
+
+        // Appends a member without maintaining key order or uniqueness.
+        // normalize() must be called after the last member is appended.
+        template <class... Args>
+        Json& append_unchecked(key_type&& name, Args&&... args)
+        {
+            members_.emplace_back(std::move(name), std::forward<Args>(args)...);
+            return members_.back().value();
+        }
+
+        // Sorts the members by key, keeping the first of any duplicates
+        void normalize()
+        {
+            auto less = [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;};
+            if (!std::is_sorted(members_.begin(), members_.end(), less))
+            {
+                std::stable_sort(members_.begin(),members_.end(), less);
+            }
             auto it = std::unique(members_.begin(), members_.end(),
                                   [](const key_value_type& a, const key_value_type& b) -> bool { return !(a.key().compare(b.key()));});
             members_.erase(it, members_.end());
@@ -1181,6 +1626,14 @@ namespace jsoncons {
 
         bool operator==(const json_object& rhs) const
         {
+            if (this == &rhs)
+            {
+                return true;
+            }
+            if (this->hash_differs(rhs))
+            {
+                return false;
+            }
             return members_ == rhs.members_;
         }
 
@@ -1213,7 +1666,9 @@ namespace jsoncons {
     // Preserve order
     template <class KeyT,class Json>
     class json_object<KeyT,Json,typename std::enable_if<std::is_same<typename Json::implementation_policy::key_order,preserve_key_order>::value>::type> : 
-        public allocator_holder<typename Json::allocator_type>
+        public allocator_holder<typename Json::allocator_type>, 
+        public detail::container_ref_count<detail::is_copy_on_write_policy<typename Json::implementation_policy>::value>,
+        public detail::container_hash_cache<detail::is_cached_hash_policy<typename Json::implementation_policy>::value>
     {
     public:
         using allocator_type = typename Json::allocator_type;
@@ -1249,6 +1704,8 @@ namespace jsoncons {
 
         json_object(const json_object& val)
             : allocator_holder<allocator_type>(val.get_allocator()), 
+              detail::container_ref_count<detail::is_copy_on_write_policy<typename Json::implementation_policy>::value>(),
+              detail::container_hash_cache<detail::is_cached_hash_policy<typename Json::implementation_policy>::value>(val),
               members_(val.members_),
               index_(val.index_)
         {
@@ -1460,6 +1917,14 @@ namespace jsoncons {
             }
         }
 
+        void erase(const_iterator pos) 
+        {
+            if (pos != members_.end())
+            {
+                erase(pos, pos + 1);
+            }
+        }
+
         void erase(const_iterator first, const_iterator last) 
         {
             std::size_t pos1 = first == members_.end() ? members_.size() : first - members_.begin();
@@ -1507,7 +1972,21 @@ namespace jsoncons {
             {
                 members_.emplace_back(convert(*s));
             }
+            normalize();
+        }
+
+        // Appends a member without updating the index or checking for duplicates.
+        // normalize() must be called after the last member is appended.
+        template <class... Args>
+        Json& append_unchecked(key_type&& name, Args&&... args)
+        {
+            members_.emplace_back(std::move(name), std::forward<Args>(args)...);
+            return members_.back().value();
+        }
 
+        // Removes all but the first of any duplicate keys and rebuilds the index
+        void normalize()
+        {
             build_index();
             auto last_unique = std::unique(index_.begin(), index_.end(),
                 [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
@@ -1874,6 +2353,14 @@ namespace jsoncons {
 
         bool operator==(const json_object& rhs) const
         {
+            if (this == &rhs)
+            {
+                return true;
+            }
+            if (this->hash_differs(rhs))
+            {
+                return false;
+            }
             return members_ == rhs.members_;
         }
      
@@ -72,7 +72,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
                       const Allocator& alloc = Allocator(),
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(filter),
          buffer_(alloc),
@@ -200,7 +200,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler,
                       std::error_code& ec,
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(filter),
          buffer_(alloc),
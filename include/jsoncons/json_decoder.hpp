@@ -13,7 +13,10 @@
 #include <memory> // std::allocator
 #include <iterator> // std::make_move_iterator
 #include <utility> // std::move
+#include <unordered_map>
+#include <functional> // std::equal_to
 #include <jsoncons/json_exception.hpp>
+#include <jsoncons/shared_key.hpp>
 #include <jsoncons/json_visitor.hpp>
 
 namespace jsoncons {
@@ -53,23 +56,48 @@ private:
         stack_item& operator=(stack_item&&) = default;
     };
 
-    enum class structure_type {root_t, array_t, object_t};
+    // array_t and object_t stage their members on item_stack_ until the end of the container,
+    // sized_array_t and sized_object_t have a length hint and receive their members directly
+    enum class structure_type {root_t, array_t, object_t, sized_array_t, sized_object_t};
 
     struct structure_info
     {
         structure_type type_;
         std::size_t container_index_;
+        array* array_;
+        object* object_;
 
         structure_info(structure_type type, std::size_t offset)
-            : type_(type), container_index_(offset)
+            : type_(type), container_index_(offset), array_(nullptr), object_(nullptr)
         {
         }
 
+        structure_info(array* a)
+            : type_(structure_type::sized_array_t), container_index_(0), array_(a), object_(nullptr)
+        {
+        }
+
+        structure_info(object* o)
+            : type_(structure_type::sized_object_t), container_index_(0), array_(nullptr), object_(o)
+        {
+        }
+    };
+
+    struct key_hash
+    {
+        std::size_t operator()(const string_view_type& s) const noexcept
+        {
+            return detail::fnv1a_hash(s.data(), s.length());
+        }
     };
 
+    // Bounds the memory held by the key pool when keys are not repeated, e.g. ids used as keys
+    static constexpr std::size_t max_key_pool_size = 4096;
+
     using temp_allocator_type = TempAllocator;
     typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<stack_item> stack_item_allocator_type;
     typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<structure_info> structure_info_allocator_type;
+    typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<std::pair<const string_view_type,key_type>> key_pool_allocator_type;
  
     json_string_allocator string_allocator_;
     json_byte_allocator_type byte_allocator_;
@@ -83,6 +111,7 @@ private:
     key_type name_;
     std::vector<stack_item,stack_item_allocator_type> item_stack_;
     std::vector<structure_info,structure_info_allocator_type> structure_stack_;
+    std::unordered_map<string_view_type,key_type,key_hash,std::equal_to<string_view_type>,key_pool_allocator_type> key_pool_;
     bool is_valid_;
 
 public:
@@ -97,6 +126,7 @@ public:
           name_(string_allocator_),
           item_stack_(stack_item_allocator_),
           structure_stack_(size_t_allocator_),
+          key_pool_(0, key_hash(), std::equal_to<string_view_type>(), key_pool_allocator_type(temp_alloc)),
           is_valid_(false) 
 
     {
@@ -117,6 +147,7 @@ public:
           name_(string_allocator_),
           item_stack_(),
           structure_stack_(),
+          key_pool_(),
           is_valid_(false) 
 
     {
@@ -138,6 +169,7 @@ public:
           name_(string_allocator_),
           item_stack_(stack_item_allocator_),
           structure_stack_(size_t_allocator_),
+          key_pool_(0, key_hash(), std::equal_to<string_view_type>(), key_pool_allocator_type(temp_alloc)),
           is_valid_(false) 
 
     {
@@ -191,9 +223,23 @@ private:
         return true;
     }
 
+    bool visit_begin_object(std::size_t length, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        object& o = begin_sized_container(json_object_arg, tag, object_allocator_).object_value();
+        o.reserve(capacity_hint(length));
+        structure_stack_.emplace_back(&o);
+        return true;
+    }
+
     bool visit_end_object(const ser_context&, std::error_code&) override
     {
-        JSONCONS_ASSERT(structure_stack_.size() > 0);
+        JSONCONS_ASSERT(structure_stack_.size() > 1);
+        if (structure_stack_.back().type_ == structure_type::sized_object_t)
+        {
+            structure_stack_.back().object_->normalize();
+            structure_stack_.pop_back();
+            return end_sized_container();
+        }
         JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::object_t);
         const size_t structure_index = structure_stack_.back().container_index_;
         JSONCONS_ASSERT(item_stack_.size() > structure_index);
@@ -207,14 +253,7 @@ private:
         );
         item_stack_.erase(item_stack_.begin()+structure_index+1, item_stack_.end());
         structure_stack_.pop_back();
-        if (structure_stack_.back().type_ == structure_type::root_t)
-        {
-            result_.swap(item_stack_.front().value_);
-            item_stack_.pop_back();
-            is_valid_ = true;
-            return false;
-        }
-        return true;
+        return end_staged_container();
     }
 
     bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
@@ -229,9 +268,22 @@ private:
         return true;
     }
 
+    bool visit_begin_array(std::size_t length, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        array& a = begin_sized_container(json_array_arg, tag, array_allocator_).array_value();
+        a.reserve(capacity_hint(length));
+        structure_stack_.emplace_back(&a);
+        return true;
+    }
+
     bool visit_end_array(const ser_context&, std::error_code&) override
     {
         JSONCONS_ASSERT(structure_stack_.size() > 1);
+        if (structure_stack_.back().type_ == structure_type::sized_array_t)
+        {
+            structure_stack_.pop_back();
+            return end_sized_container();
+        }
         JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::array_t);
         const size_t container_index = structure_stack_.back().container_index_;
         JSONCONS_ASSERT(item_stack_.size() > container_index);
@@ -254,93 +306,155 @@ private:
         }
 
         structure_stack_.pop_back();
-        if (structure_stack_.back().type_ == structure_type::root_t)
-        {
-            result_.swap(item_stack_.front().value_);
-            item_stack_.pop_back();
-            is_valid_ = true;
-            return false;
-        }
-        return true;
+        return end_staged_container();
     }
 
-    bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+    // Length hints come from the input and are not trusted beyond this
+    static std::size_t capacity_hint(std::size_t length)
     {
-        name_ = key_type(name.data(),name.length(),string_allocator_);
-        return true;
+        return length < 65536 ? length : 65536;
     }
 
-    bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
+    // A sized container is constructed where it will finally live: inside its parent if the
+    // parent is also sized, otherwise on the item stack like any other staged value. Either
+    // way the returned value's storage stays put while its members are appended.
+    template <class... Args>
+    Json& begin_sized_container(Args&& ... args)
+    {
+        structure_info& parent = structure_stack_.back();
+        switch (parent.type_)
+        {
+            case structure_type::sized_array_t:
+                return parent.array_->emplace_back(std::forward<Args>(args)...);
+            case structure_type::sized_object_t:
+                return parent.object_->append_unchecked(std::move(name_), std::forward<Args>(args)...);
+            case structure_type::root_t:
+                item_stack_.clear();
+                is_valid_ = false;
+                JSONCONS_FALLTHROUGH;
+            default:
+                item_stack_.emplace_back(std::forward<key_type>(name_), std::forward<Args>(args)...);
+                return item_stack_.back().value_;
+        }
+    }
+
+    bool end_sized_container()
     {
         switch (structure_stack_.back().type_)
         {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), sv, tag, string_allocator_);
-                break;
             case structure_type::root_t:
-                result_ = Json(sv, tag, string_allocator_);
+                result_.swap(item_stack_.front().value_);
+                item_stack_.pop_back();
                 is_valid_ = true;
                 return false;
+            default:
+                return true;
         }
-        return true;
     }
 
-    bool visit_byte_string(const byte_string_view& b, 
-                              semantic_tag tag, 
-                              const ser_context&,
-                              std::error_code&) override
+    // The finished container is on top of the item stack
+    bool end_staged_container()
     {
         switch (structure_stack_.back().type_)
         {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), b, tag, byte_allocator_);
-                break;
             case structure_type::root_t:
-                result_ = Json(b, tag, byte_allocator_);
+                result_.swap(item_stack_.front().value_);
+                item_stack_.pop_back();
                 is_valid_ = true;
                 return false;
+            case structure_type::sized_array_t:
+                structure_stack_.back().array_->emplace_back(std::move(item_stack_.back().value_));
+                item_stack_.pop_back();
+                return true;
+            case structure_type::sized_object_t:
+                structure_stack_.back().object_->append_unchecked(std::move(item_stack_.back().name_), std::move(item_stack_.back().value_));
+                item_stack_.pop_back();
+                return true;
+            default:
+                return true;
         }
-        return true;
     }
 
-    bool visit_int64(int64_t value, 
-                        semantic_tag tag, 
-                        const ser_context&,
-                        std::error_code&) override
+    template <class... Args>
+    bool emplace_value(Args&& ... args)
     {
-        switch (structure_stack_.back().type_)
+        structure_info& parent = structure_stack_.back();
+        switch (parent.type_)
         {
             case structure_type::object_t:
             case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
+                item_stack_.emplace_back(std::forward<key_type>(name_), std::forward<Args>(args)...);
+                break;
+            case structure_type::sized_array_t:
+                parent.array_->emplace_back(std::forward<Args>(args)...);
+                break;
+            case structure_type::sized_object_t:
+                parent.object_->append_unchecked(std::move(name_), std::forward<Args>(args)...);
                 break;
             case structure_type::root_t:
-                result_ = Json(value,tag);
+                result_ = Json(std::forward<Args>(args)...);
                 is_valid_ = true;
                 return false;
         }
         return true;
     }
 
+    bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+    {
+        make_key(name, detail::is_shared_key<key_type>());
+        return true;
+    }
+
+    void make_key(const string_view_type& name, std::false_type)
+    {
+        name_ = key_type(name.data(),name.length(),string_allocator_);
+    }
+
+    // Shared keys are interned, so that the members of homogeneous objects share key storage
+    void make_key(const string_view_type& name, std::true_type)
+    {
+        auto it = key_pool_.find(name);
+        if (it != key_pool_.end())
+        {
+            name_ = it->second;
+        }
+        else
+        {
+            name_ = key_type(name.data(),name.length(),string_allocator_);
+            if (key_pool_.size() < max_key_pool_size)
+            {
+                key_pool_.emplace(string_view_type(name_), name_);
+            }
+        }
+    }
+
+    bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return emplace_value(sv, tag, string_allocator_);
+    }
+
+    bool visit_byte_string(const byte_string_view& b, 
+                              semantic_tag tag, 
+                              const ser_context&,
+                              std::error_code&) override
+    {
+        return emplace_value(b, tag, byte_allocator_);
+    }
+
+    bool visit_int64(int64_t value, 
+                        semantic_tag tag, 
+                        const ser_context&,
+                        std::error_code&) override
+    {
+        return emplace_value(value, tag);
+    }
+
     bool visit_uint64(uint64_t value, 
                          semantic_tag tag, 
                          const ser_context&,
                          std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(value,tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        return emplace_value(value, tag);
     }
 
     bool visit_half(uint16_t value, 
@@ -348,18 +462,7 @@ private:
                        const ser_context&,
                        std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), half_arg, value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(half_arg, value, tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        return emplace_value(half_arg, value, tag);
     }
 
     bool visit_double(double value, 
@@ -367,50 +470,86 @@ private:
                          const ser_context&,
                          std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(value, tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        return emplace_value(value, tag);
+    }
+
+    bool visit_number_text(const string_view_type& sv, 
+                           semantic_tag, 
+                           const ser_context&,
+                           std::error_code&) override
+    {
+        return emplace_value(lazy_number_arg, sv, string_allocator_);
     }
 
     bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), value, tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(value, tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        return emplace_value(value, tag);
+    }
+
+    bool visit_typed_array(const span<const uint8_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const span<const uint16_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const span<const uint32_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const span<const uint64_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const span<const int8_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const span<const int16_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const span<const int32_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const span<const int64_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(half_arg_t, const span<const uint16_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return emplace_value(typed_array_arg, half_arg, s, tag, array_allocator_);
+    }
+
+    bool visit_typed_array(const span<const float>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const span<const double>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    template <class T>
+    bool typed_array_value(const span<const T>& s, semantic_tag tag)
+    {
+        return emplace_value(typed_array_arg, s, tag, array_allocator_);
     }
 
     bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
     {
-        switch (structure_stack_.back().type_)
-        {
-            case structure_type::object_t:
-            case structure_type::array_t:
-                item_stack_.emplace_back(std::forward<key_type>(name_), null_type(), tag);
-                break;
-            case structure_type::root_t:
-                result_ = Json(null_type(), tag);
-                is_valid_ = true;
-                return false;
-        }
-        return true;
+        return emplace_value(null_type(), tag);
     }
 };
 
@@ -0,0 +1,999 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_DOCUMENT_VIEW_HPP
+#define JSONCONS_JSON_DOCUMENT_VIEW_HPP
+
+#include <string>
+#include <vector>
+#include <istream> // std::basic_istream
+#include <memory> // std::allocator
+#include <iterator>
+#include <type_traits>
+#include <system_error>
+#include <jsoncons/basic_json.hpp>
+
+namespace jsoncons {
+
+    enum class tape_item_kind : uint8_t
+    {
+        null_value,
+        bool_value,
+        int64_value,
+        uint64_value,
+        half_value,
+        double_value,
+        string_value,
+        byte_string_value,
+        key,
+        begin_array,
+        end_array,
+        begin_object,
+        end_object
+    };
+
+    // One token of a document. Strings and byte strings refer to the tape's character and byte buffers,
+    // containers record their number of elements and the index one past their end_array/end_object item.
+
+    struct tape_item
+    {
+        tape_item_kind kind;
+        semantic_tag tag;
+        std::size_t length;
+        union
+        {
+            bool bool_val;
+            int64_t int64_val;
+            uint64_t uint64_val;
+            uint16_t half_val;
+            double double_val;
+            std::size_t offset;
+            std::size_t skip;
+        };
+
+        tape_item(tape_item_kind kind, semantic_tag tag)
+            : kind(kind), tag(tag), length(0), uint64_val(0)
+        {
+        }
+    };
+
+    // basic_json_tape holds the flat token stream of one document, with all string and byte string
+    // content in two buffers. Clearing it keeps the capacity, so a tape may be reused across documents.
+
+    template <class CharT,class Allocator=std::allocator<char>>
+    class basic_json_tape
+    {
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+    private:
+        using item_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<tape_item>;
+        using char_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<char_type>;
+        using byte_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint8_t>;
+
+        std::vector<tape_item,item_allocator_type> items_;
+        std::vector<char_type,char_allocator_type> chars_;
+        std::vector<uint8_t,byte_allocator_type> bytes_;
+    public:
+        basic_json_tape(const allocator_type& alloc = allocator_type())
+            : items_(item_allocator_type(alloc)), chars_(char_allocator_type(alloc)), bytes_(byte_allocator_type(alloc))
+        {
+        }
+
+        void clear()
+        {
+            items_.clear();
+            chars_.clear();
+            bytes_.clear();
+        }
+
+        bool empty() const
+        {
+            return items_.empty();
+        }
+
+        std::size_t size() const
+        {
+            return items_.size();
+        }
+
+        const tape_item& operator[](std::size_t i) const
+        {
+            return items_[i];
+        }
+
+        tape_item& operator[](std::size_t i)
+        {
+            return items_[i];
+        }
+
+        // Index one past the value that starts at i
+        std::size_t next(std::size_t i) const
+        {
+            switch (items_[i].kind)
+            {
+                case tape_item_kind::begin_array:
+                case tape_item_kind::begin_object:
+                    return items_[i].skip;
+                default:
+                    return i + 1;
+            }
+        }
+
+        string_view_type string_at(std::size_t i) const
+        {
+            return string_view_type(chars_.data() + items_[i].offset, items_[i].length);
+        }
+
+        byte_string_view bytes_at(std::size_t i) const
+        {
+            return byte_string_view(bytes_.data() + items_[i].offset, items_[i].length);
+        }
+
+        std::size_t push_back(tape_item_kind kind, semantic_tag tag)
+        {
+            items_.emplace_back(kind, tag);
+            return items_.size() - 1;
+        }
+
+        std::size_t push_back(tape_item_kind kind, const string_view_type& sv, semantic_tag tag)
+        {
+            items_.emplace_back(kind, tag);
+            items_.back().offset = chars_.size();
+            items_.back().length = sv.size();
+            chars_.insert(chars_.end(), sv.begin(), sv.end());
+            return items_.size() - 1;
+        }
+
+        std::size_t push_back(const byte_string_view& b, semantic_tag tag)
+        {
+            items_.emplace_back(tape_item_kind::byte_string_value, tag);
+            items_.back().offset = bytes_.size();
+            items_.back().length = b.size();
+            bytes_.insert(bytes_.end(), b.begin(), b.end());
+            return items_.size() - 1;
+        }
+
+        tape_item& back()
+        {
+            return items_.back();
+        }
+    };
+
+    // basic_json_tape_builder writes the events it receives onto a tape
+
+    template <class CharT,class Allocator=std::allocator<char>>
+    class basic_json_tape_builder final : public basic_json_visitor<CharT>
+    {
+    public:
+        using char_type = CharT;
+        using typename basic_json_visitor<CharT>::string_view_type;
+        using tape_type = basic_json_tape<CharT,Allocator>;
+    private:
+        tape_type* tape_;
+        std::vector<std::size_t> stack_;
+        bool is_valid_;
+    public:
+        basic_json_tape_builder(tape_type& tape)
+            : tape_(std::addressof(tape)), is_valid_(false)
+        {
+            stack_.reserve(100);
+        }
+
+        void reset(tape_type& tape)
+        {
+            tape_ = std::addressof(tape);
+            stack_.clear();
+            is_valid_ = false;
+        }
+
+        bool is_valid() const
+        {
+            return is_valid_;
+        }
+    private:
+        void visit_flush() override
+        {
+        }
+
+        bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            stack_.push_back(tape_->push_back(tape_item_kind::begin_object, tag));
+            return true;
+        }
+
+        bool visit_end_object(const ser_context&, std::error_code&) override
+        {
+            return end_container(tape_item_kind::end_object);
+        }
+
+        bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            stack_.push_back(tape_->push_back(tape_item_kind::begin_array, tag));
+            return true;
+        }
+
+        bool visit_end_array(const ser_context&, std::error_code&) override
+        {
+            return end_container(tape_item_kind::end_array);
+        }
+
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            tape_->push_back(tape_item_kind::key, name, semantic_tag::none);
+            return true;
+        }
+
+        bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            tape_->push_back(tape_item_kind::string_value, sv, tag);
+            return end_value();
+        }
+
+        bool visit_byte_string(const byte_string_view& b, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            tape_->push_back(b, tag);
+            return end_value();
+        }
+
+        bool visit_int64(int64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            tape_->push_back(tape_item_kind::int64_value, tag);
+            tape_->back().int64_val = value;
+            return end_value();
+        }
+
+        bool visit_uint64(uint64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            tape_->push_back(tape_item_kind::uint64_value, tag);
+            tape_->back().uint64_val = value;
+            return end_value();
+        }
+
+        bool visit_half(uint16_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            tape_->push_back(tape_item_kind::half_value, tag);
+            tape_->back().half_val = value;
+            return end_value();
+        }
+
+        bool visit_double(double value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            tape_->push_back(tape_item_kind::double_value, tag);
+            tape_->back().double_val = value;
+            return end_value();
+        }
+
+        bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            tape_->push_back(tape_item_kind::bool_value, tag);
+            tape_->back().bool_val = value;
+            return end_value();
+        }
+
+        bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            tape_->push_back(tape_item_kind::null_value, tag);
+            return end_value();
+        }
+
+        bool end_container(tape_item_kind kind)
+        {
+            JSONCONS_ASSERT(!stack_.empty());
+            std::size_t begin = stack_.back();
+            stack_.pop_back();
+            tape_->push_back(kind, semantic_tag::none);
+            (*tape_)[begin].skip = tape_->size();
+            return end_value();
+        }
+
+        bool end_value()
+        {
+            if (stack_.empty())
+            {
+                is_valid_ = true;
+            }
+            else
+            {
+                ++(*tape_)[stack_.back()].length;
+            }
+            return true;
+        }
+    };
+
+    template <class CharT,class Allocator>
+    class basic_json_document_view;
+
+    template <class CharT,class Allocator>
+    class basic_json_document_member
+    {
+    public:
+        using char_type = CharT;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+        using view_type = basic_json_document_view<CharT,Allocator>;
+    private:
+        const basic_json_tape<CharT,Allocator>* tape_;
+        std::size_t index_;
+    public:
+        basic_json_document_member(const basic_json_tape<CharT,Allocator>* tape, std::size_t index)
+            : tape_(tape), index_(index)
+        {
+        }
+
+        string_view_type key() const
+        {
+            return tape_->string_at(index_);
+        }
+
+        view_type value() const
+        {
+            return view_type(tape_, index_+1);
+        }
+    };
+
+    // basic_json_document_view is a read-only handle to a value on a tape, with basic_json-like accessors.
+    // It is cheap to copy and is valid as long as the tape is not cleared or reused.
+
+    template <class CharT,class Allocator=std::allocator<char>>
+    class basic_json_document_view
+    {
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+        using tape_type = basic_json_tape<CharT,Allocator>;
+        using member_type = basic_json_document_member<CharT,Allocator>;
+
+        class array_iterator
+        {
+            const tape_type* tape_;
+            std::size_t index_;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = basic_json_document_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const basic_json_document_view*;
+            using reference = basic_json_document_view;
+
+            array_iterator(const tape_type* tape, std::size_t index)
+                : tape_(tape), index_(index)
+            {
+            }
+
+            basic_json_document_view operator*() const
+            {
+                return basic_json_document_view(tape_, index_);
+            }
+
+            array_iterator& operator++()
+            {
+                index_ = tape_->next(index_);
+                return *this;
+            }
+
+            array_iterator operator++(int)
+            {
+                array_iterator temp(*this);
+                ++*this;
+                return temp;
+            }
+
+            friend bool operator==(const array_iterator& lhs, const array_iterator& rhs)
+            {
+                return lhs.index_ == rhs.index_;
+            }
+
+            friend bool operator!=(const array_iterator& lhs, const array_iterator& rhs)
+            {
+                return lhs.index_ != rhs.index_;
+            }
+        };
+
+        class object_iterator
+        {
+            const tape_type* tape_;
+            std::size_t index_;
+            member_type member_;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = member_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const member_type*;
+            using reference = const member_type&;
+
+            object_iterator(const tape_type* tape, std::size_t index)
+                : tape_(tape), index_(index), member_(tape, index)
+            {
+            }
+
+            const member_type& operator*() const
+            {
+                return member_;
+            }
+
+            const member_type* operator->() const
+            {
+                return std::addressof(member_);
+            }
+
+            object_iterator& operator++()
+            {
+                index_ = tape_->next(index_+1);
+                member_ = member_type(tape_, index_);
+                return *this;
+            }
+
+            object_iterator operator++(int)
+            {
+                object_iterator temp(*this);
+                ++*this;
+                return temp;
+            }
+
+            friend bool operator==(const object_iterator& lhs, const object_iterator& rhs)
+            {
+                return lhs.index_ == rhs.index_;
+            }
+
+            friend bool operator!=(const object_iterator& lhs, const object_iterator& rhs)
+            {
+                return lhs.index_ != rhs.index_;
+            }
+        };
+
+        using array_range_type = range<array_iterator>;
+        using object_range_type = range<object_iterator>;
+    private:
+        const tape_type* tape_;
+        std::size_t index_;
+
+        const tape_item& item() const
+        {
+            return (*tape_)[index_];
+        }
+    public:
+        basic_json_document_view(const tape_type* tape, std::size_t index)
+            : tape_(tape), index_(index)
+        {
+        }
+
+        json_type type() const
+        {
+            switch (item().kind)
+            {
+                case tape_item_kind::null_value:
+                    return json_type::null_value;
+                case tape_item_kind::bool_value:
+                    return json_type::bool_value;
+                case tape_item_kind::int64_value:
+                    return json_type::int64_value;
+                case tape_item_kind::uint64_value:
+                    return json_type::uint64_value;
+                case tape_item_kind::half_value:
+                    return json_type::half_value;
+                case tape_item_kind::double_value:
+                    return json_type::double_value;
+                case tape_item_kind::string_value:
+                    return json_type::string_value;
+                case tape_item_kind::byte_string_value:
+                    return json_type::byte_string_value;
+                case tape_item_kind::begin_array:
+                    return json_type::array_value;
+                case tape_item_kind::begin_object:
+                    return json_type::object_value;
+                default:
+                    JSONCONS_UNREACHABLE();
+            }
+        }
+
+        semantic_tag tag() const
+        {
+            return item().tag;
+        }
+
+        bool is_null() const
+        {
+            return item().kind == tape_item_kind::null_value;
+        }
+
+        bool is_bool() const
+        {
+            return item().kind == tape_item_kind::bool_value;
+        }
+
+        bool is_int64() const
+        {
+            return item().kind == tape_item_kind::int64_value ||
+                   (item().kind == tape_item_kind::uint64_value && item().uint64_val <= static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()));
+        }
+
+        bool is_uint64() const
+        {
+            return item().kind == tape_item_kind::uint64_value ||
+                   (item().kind == tape_item_kind::int64_value && item().int64_val >= 0);
+        }
+
+        bool is_double() const
+        {
+            return item().kind == tape_item_kind::double_value;
+        }
+
+        bool is_number() const
+        {
+            switch (item().kind)
+            {
+                case tape_item_kind::int64_value:
+                case tape_item_kind::uint64_value:
+                case tape_item_kind::half_value:
+                case tape_item_kind::double_value:
+                    return true;
+                case tape_item_kind::string_value:
+                    return item().tag == semantic_tag::bigint || item().tag == semantic_tag::bigdec || item().tag == semantic_tag::bigfloat;
+                default:
+                    return false;
+            }
+        }
+
+        bool is_string() const
+        {
+            return item().kind == tape_item_kind::string_value;
+        }
+
+        bool is_byte_string() const
+        {
+            return item().kind == tape_item_kind::byte_string_value;
+        }
+
+        bool is_array() const
+        {
+            return item().kind == tape_item_kind::begin_array;
+        }
+
+        bool is_object() const
+        {
+            return item().kind == tape_item_kind::begin_object;
+        }
+
+        std::size_t size() const
+        {
+            switch (item().kind)
+            {
+                case tape_item_kind::begin_array:
+                case tape_item_kind::begin_object:
+                    return item().length;
+                default:
+                    return 0;
+            }
+        }
+
+        bool empty() const
+        {
+            switch (item().kind)
+            {
+                case tape_item_kind::string_value:
+                case tape_item_kind::byte_string_value:
+                case tape_item_kind::begin_array:
+                case tape_item_kind::begin_object:
+                    return item().length == 0;
+                default:
+                    return false;
+            }
+        }
+
+        array_range_type array_range() const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+            }
+            return array_range_type(array_iterator(tape_, index_+1), array_iterator(tape_, item().skip-1));
+        }
+
+        object_range_type object_range() const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+            }
+            return object_range_type(object_iterator(tape_, index_+1), object_iterator(tape_, item().skip-1));
+        }
+
+        basic_json_document_view at(std::size_t i) const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
+            }
+            if (i >= item().length)
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            std::size_t pos = index_+1;
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                pos = tape_->next(pos);
+            }
+            return basic_json_document_view(tape_, pos);
+        }
+
+        basic_json_document_view operator[](std::size_t i) const
+        {
+            return at(i);
+        }
+
+        object_iterator find(const string_view_type& name) const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+            }
+            std::size_t end = item().skip-1;
+            std::size_t pos = index_+1;
+            while (pos < end && tape_->string_at(pos) != name)
+            {
+                pos = tape_->next(pos+1);
+            }
+            return object_iterator(tape_, pos);
+        }
+
+        bool contains(const string_view_type& name) const
+        {
+            return is_object() && find(name) != object_iterator(tape_, item().skip-1);
+        }
+
+        basic_json_document_view at(const string_view_type& name) const
+        {
+            auto it = find(name);
+            if (it == object_iterator(tape_, item().skip-1))
+            {
+                JSONCONS_THROW(key_not_found(name.data(),name.length()));
+            }
+            return it->value();
+        }
+
+        basic_json_document_view operator[](const string_view_type& name) const
+        {
+            return at(name);
+        }
+
+        string_view_type as_string_view() const
+        {
+            if (!is_string())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
+            }
+            return tape_->string_at(index_);
+        }
+
+        byte_string_view as_byte_string_view() const
+        {
+            if (!is_byte_string())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
+            }
+            return tape_->bytes_at(index_);
+        }
+
+        bool as_bool() const
+        {
+            switch (item().kind)
+            {
+                case tape_item_kind::bool_value:
+                    return item().bool_val;
+                case tape_item_kind::int64_value:
+                    return item().int64_val != 0;
+                case tape_item_kind::uint64_value:
+                    return item().uint64_val != 0;
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a bool"));
+            }
+        }
+
+        template <class T>
+        T as_integer() const
+        {
+            switch (item().kind)
+            {
+                case tape_item_kind::string_value:
+                {
+                    auto result = jsoncons::detail::to_integer<T>(as_string_view().data(), as_string_view().length());
+                    if (!result)
+                    {
+                        JSONCONS_THROW(json_runtime_error<std::runtime_error>(result.error_code().message()));
+                    }
+                    return result.value();
+                }
+                case tape_item_kind::half_value:
+                    return static_cast<T>(item().half_val);
+                case tape_item_kind::double_value:
+                    return static_cast<T>(item().double_val);
+                case tape_item_kind::int64_value:
+                    return static_cast<T>(item().int64_val);
+                case tape_item_kind::uint64_value:
+                    return static_cast<T>(item().uint64_val);
+                case tape_item_kind::bool_value:
+                    return static_cast<T>(item().bool_val ? 1 : 0);
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an integer"));
+            }
+        }
+
+        double as_double() const
+        {
+            switch (item().kind)
+            {
+                case tape_item_kind::string_value:
+                {
+                    jsoncons::detail::to_double_t to_double;
+                    std::basic_string<char_type> s(as_string_view().data(), as_string_view().length());
+                    return to_double(s.c_str(), s.length());
+                }
+                case tape_item_kind::half_value:
+                    return jsoncons::detail::decode_half(item().half_val);
+                case tape_item_kind::double_value:
+                    return item().double_val;
+                case tape_item_kind::int64_value:
+                    return static_cast<double>(item().int64_val);
+                case tape_item_kind::uint64_value:
+                    return static_cast<double>(item().uint64_val);
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Not a double"));
+            }
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,bool>::value,T>::type
+        as() const
+        {
+            return as_bool();
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_integral<T>::value && !std::is_same<T,bool>::value,T>::type
+        as() const
+        {
+            return as_integer<T>();
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_floating_point<T>::value,T>::type
+        as() const
+        {
+            return static_cast<T>(as_double());
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,string_view_type>::value,T>::type
+        as() const
+        {
+            return as_string_view();
+        }
+
+        template <class T>
+        typename std::enable_if<jsoncons::detail::is_basic_string<T>::value && std::is_same<typename T::value_type,char_type>::value,T>::type
+        as() const
+        {
+            if (is_string())
+            {
+                return T(as_string_view().data(), as_string_view().length());
+            }
+            T s;
+            basic_json_compressed_encoder<char_type,jsoncons::string_sink<T>> encoder(s);
+            dump(encoder);
+            return s;
+        }
+
+        // Materializes the value as a basic_json (or any type with a json_decoder)
+        template <class T>
+        typename std::enable_if<is_basic_json<T>::value,T>::type
+        as() const
+        {
+            json_decoder<T> decoder;
+            dump(decoder);
+            return decoder.get_result();
+        }
+
+        void dump(basic_json_visitor<char_type>& visitor) const
+        {
+            std::error_code ec;
+            dump(visitor, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+
+        void dump(basic_json_visitor<char_type>& visitor, std::error_code& ec) const
+        {
+            const ser_context context{};
+            std::size_t end = tape_->next(index_);
+            bool more = true;
+            for (std::size_t i = index_; more && i < end; ++i)
+            {
+                const tape_item& t = (*tape_)[i];
+                switch (t.kind)
+                {
+                    case tape_item_kind::null_value:
+                        more = visitor.null_value(t.tag, context, ec);
+                        break;
+                    case tape_item_kind::bool_value:
+                        more = visitor.bool_value(t.bool_val, t.tag, context, ec);
+                        break;
+                    case tape_item_kind::int64_value:
+                        more = visitor.int64_value(t.int64_val, t.tag, context, ec);
+                        break;
+                    case tape_item_kind::uint64_value:
+                        more = visitor.uint64_value(t.uint64_val, t.tag, context, ec);
+                        break;
+                    case tape_item_kind::half_value:
+                        more = visitor.half_value(t.half_val, t.tag, context, ec);
+                        break;
+                    case tape_item_kind::double_value:
+                        more = visitor.double_value(t.double_val, t.tag, context, ec);
+                        break;
+                    case tape_item_kind::string_value:
+                        more = visitor.string_value(tape_->string_at(i), t.tag, context, ec);
+                        break;
+                    case tape_item_kind::byte_string_value:
+                        more = visitor.byte_string_value(tape_->bytes_at(i), t.tag, context, ec);
+                        break;
+                    case tape_item_kind::key:
+                        more = visitor.key(tape_->string_at(i), context, ec);
+                        break;
+                    case tape_item_kind::begin_array:
+                        more = visitor.begin_array(t.length, t.tag, context, ec);
+                        break;
+                    case tape_item_kind::end_array:
+                        more = visitor.end_array(context, ec);
+                        break;
+                    case tape_item_kind::begin_object:
+                        more = visitor.begin_object(t.length, t.tag, context, ec);
+                        break;
+                    case tape_item_kind::end_object:
+                        more = visitor.end_object(context, ec);
+                        break;
+                }
+            }
+            if (!ec)
+            {
+                visitor.flush();
+            }
+        }
+
+        template <class SAllocator=std::allocator<char_type>>
+        std::basic_string<char_type,std::char_traits<char_type>,SAllocator> to_string() const
+        {
+            return as<std::basic_string<char_type,std::char_traits<char_type>,SAllocator>>();
+        }
+
+        friend std::basic_ostream<char_type>& operator<<(std::basic_ostream<char_type>& os, const basic_json_document_view& v)
+        {
+            basic_json_compressed_encoder<char_type> encoder(os);
+            v.dump(encoder);
+            return os;
+        }
+    };
+
+    // basic_json_document owns the tape of a parsed document. Parsing another document into it
+    // reuses the tape's buffers.
+
+    template <class CharT,class Allocator=std::allocator<char>>
+    class basic_json_document
+    {
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+        using tape_type = basic_json_tape<CharT,Allocator>;
+        using view_type = basic_json_document_view<CharT,Allocator>;
+    private:
+        tape_type tape_;
+    public:
+        basic_json_document(const allocator_type& alloc = allocator_type())
+            : tape_(alloc)
+        {
+        }
+
+        basic_json_document(const basic_json_document&) = delete;
+        basic_json_document(basic_json_document&&) = default;
+        basic_json_document& operator=(const basic_json_document&) = delete;
+        basic_json_document& operator=(basic_json_document&&) = default;
+
+        void parse(const string_view_type& s,
+                   const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        {
+            std::error_code ec;
+            parse(s, options, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+
+        void parse(const string_view_type& s,
+                   const basic_json_decode_options<char_type>& options,
+                   std::error_code& ec)
+        {
+            tape_.clear();
+            basic_json_tape_builder<CharT,Allocator> builder(tape_);
+            basic_json_parser<char_type> parser(options);
+
+            auto result = unicons::skip_bom(s.begin(), s.end());
+            if (result.ec != unicons::encoding_errc())
+            {
+                ec = result.ec;
+                return;
+            }
+            std::size_t offset = result.it - s.begin();
+            parser.update(s.data()+offset,s.size()-offset);
+            parser.parse_some(builder, ec);
+            if (ec) return;
+            parser.finish_parse(builder, ec);
+            if (ec) return;
+            parser.check_done(ec);
+            if (ec) return;
+            if (!builder.is_valid())
+            {
+                ec = json_errc::unexpected_eof;
+            }
+        }
+
+        void parse(std::basic_istream<char_type>& is,
+                   const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        {
+            tape_.clear();
+            basic_json_tape_builder<CharT,Allocator> builder(tape_);
+            basic_json_reader<char_type,stream_source<char_type>> reader(is, builder, options);
+            reader.read();
+            if (!builder.is_valid())
+            {
+                JSONCONS_THROW(json_runtime_error<std::runtime_error>("Failed to parse json stream"));
+            }
+        }
+
+        bool empty() const
+        {
+            return tape_.empty();
+        }
+
+        void clear()
+        {
+            tape_.clear();
+        }
+
+        view_type root() const
+        {
+            if (tape_.empty())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Empty document"));
+            }
+            return view_type(std::addressof(tape_), 0);
+        }
+
+        const tape_type& tape() const
+        {
+            return tape_;
+        }
+
+        // For building the tape from another event source, e.g. a cbor_reader,
+        // with a basic_json_tape_builder
+        tape_type& tape()
+        {
+            return tape_;
+        }
+    };
+
+    using json_tape_builder = basic_json_tape_builder<char>;
+    using wjson_tape_builder = basic_json_tape_builder<wchar_t>;
+    using json_document = basic_json_document<char>;
+    using wjson_document = basic_json_document<wchar_t>;
+    using json_document_view = basic_json_document_view<char>;
+    using wjson_document_view = basic_json_document_view<wchar_t>;
+
+} // namespace jsoncons
+
+#endif
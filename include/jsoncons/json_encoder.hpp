@@ -23,6 +23,8 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/sink.hpp>
 #include <jsoncons/detail/write_number.hpp>
+#include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd.hpp>
 
 namespace jsoncons { 
 namespace detail {
@@ -39,6 +41,22 @@ namespace detail {
         return cp >= 0x80;
     }
 
+    template <class CharT>
+    const CharT* find_escape_char(const CharT* first, const CharT* last,
+                                  bool escape_all_non_ascii, bool escape_solidus)
+    {
+        for (const CharT* p = first; p != last; ++p)
+        {
+            CharT c = *p;
+            if (is_control_character(c) || c == '\"' || c == '\\' || (escape_solidus && c == '/') 
+                || (escape_all_non_ascii && is_non_ascii_codepoint(c)))
+            {
+                return p;
+            }
+        }
+        return last;
+    }
+
     template <class CharT, class Sink>
     size_t escape_string(const CharT* s, std::size_t length,
                          bool escape_all_non_ascii, bool escape_solidus,
@@ -49,6 +67,20 @@ namespace detail {
         const CharT* end = s + length;
         for (const CharT* it = begin; it != end; ++it)
         {
+            // Append the run of chars that need no escaping in one call, a slice of 
+            // the caller's string that a gathering sink may reference in place
+            const CharT* next = find_escape_char(it, end, escape_all_non_ascii, escape_solidus);
+            if (next != it)
+            {
+                std::size_t n = static_cast<std::size_t>(next - it);
+                append_external(sink, it, n);
+                count += n;
+                it = next;
+                if (it == end)
+                {
+                    break;
+                }
+            }
             CharT c = *it;
             switch (c)
             {
@@ -186,6 +218,20 @@ namespace detail {
         return sink;
     }
 
+    // Writes a finite double, in space reserved up front when its length is bounded
+    template <class Sink>
+    std::size_t write_finite_double(write_double& fp, double value, Sink& sink)
+    {
+        if (fp.is_general())
+        {
+            sink_reservation<Sink,write_double::max_general_length> reservation(sink);
+            std::size_t count = fp(value, reservation);
+            reservation.commit();
+            return count;
+        }
+        return fp(value, sink);
+    }
+
 } // namespace detail
 
     template<class CharT,class Sink=jsoncons::stream_sink<CharT>,class Allocator=std::allocator<char>>
@@ -317,6 +363,7 @@ namespace detail {
         std::basic_string<CharT> close_object_brace_str_;
         std::basic_string<CharT> open_array_bracket_str_;
         std::basic_string<CharT> close_array_bracket_str_;
+        std::basic_string<CharT> new_line_str_;
         int nesting_depth_;
 
         // Noncopyable and nonmoveable
@@ -338,6 +385,7 @@ namespace detail {
              stack_(alloc),
              indent_amount_(0), 
              column_(0),
+             new_line_str_(options.new_line_chars()),
              nesting_depth_(0)
         {
             switch (options.spaces_around_colon())
@@ -824,7 +872,7 @@ namespace detail {
             }
             else
             {
-                std::size_t length = fp_(value, sink_);
+                std::size_t length = jsoncons::detail::write_finite_double(fp_, value, sink_);
                 column_ += length;
             }
 
@@ -832,6 +880,33 @@ namespace detail {
             return true;
         }
 
+        bool visit_number_text(const string_view_type& sv, 
+                               semantic_tag tag,
+                               const ser_context& context,
+                               std::error_code& ec) override
+        {
+            if (!jsoncons::detail::is_json_number(sv.data(), sv.length()))
+            {
+                static const jsoncons::detail::to_double_t to_double;
+                return visit_double(to_double(sv.data(), sv.length()), tag, context, ec);
+            }
+            if (!stack_.empty()) 
+            {
+                if (stack_.back().is_array())
+                {
+                    begin_scalar_value();
+                }
+                if (!stack_.back().is_multi_line() && column_ >= options_.line_length_limit())
+                {
+                    break_line();
+                }
+            }
+            sink_.append(sv.data(), sv.size());
+            column_ += sv.size();
+            end_value();
+            return true;
+        }
+
         bool visit_int64(int64_t value, 
                             semantic_tag,
                             const ser_context&,
@@ -945,7 +1020,7 @@ namespace detail {
                         sink_.push_back('~');
                         ++column_;
                     }
-                    std::size_t length = encode_base64(v.begin(), v.end(), sink_);
+                    std::size_t length = encode_base64(v.data(), v.data() + v.size(), sink_);
                     sink_.push_back('\"');
                     column_ += (length+2);
                     break;
@@ -963,7 +1038,7 @@ namespace detail {
                         sink_.push_back('~');
                         ++column_;
                     }
-                    std::size_t length = encode_base64url(v.begin(), v.end(), sink_);
+                    std::size_t length = encode_base64url(v.data(), v.data() + v.size(), sink_);
                     sink_.push_back('\"');
                     column_ += (length+2);
                     break;
@@ -999,21 +1074,19 @@ namespace detail {
 
         void new_line()
         {
-            sink_.append(options_.new_line_chars().data(),options_.new_line_chars().length());
-            for (int i = 0; i < indent_amount_; ++i)
-            {
-                sink_.push_back(' ');
-            }
-            column_ = indent_amount_;
+            new_line(static_cast<std::size_t>(indent_amount_));
         }
 
         void new_line(std::size_t len)
         {
-            sink_.append(options_.new_line_chars().data(),options_.new_line_chars().length());
-            for (std::size_t i = 0; i < len; ++i)
+            // new_line_str_ holds the new line characters followed by spaces,
+            // grown as the indentation deepens
+            std::size_t length = options_.new_line_chars().length() + len;
+            if (new_line_str_.length() < length)
             {
-                sink_.push_back(' ');
+                new_line_str_.resize((std::max)(length, 2*new_line_str_.length()), ' ');
             }
+            sink_.append(new_line_str_.data(), length);
             column_ = len;
         }
 
@@ -1042,6 +1115,11 @@ namespace detail {
             static constexpr std::array<CharT,5> k{'f','a','l','s','e'};
             return k;
         }
+        static const std::array<CharT, 2>& quote_colon_k()
+        {
+            static constexpr std::array<CharT,2> k{'\"',':'};
+            return k;
+        }
     public:
         using allocator_type = Allocator;
         using char_type = CharT;
@@ -1200,8 +1278,7 @@ namespace detail {
 
             sink_.push_back('\"');
             jsoncons::detail::escape_string(name.data(), name.length(),options_.escape_all_non_ascii(),options_.escape_solidus(),sink_);
-            sink_.push_back('\"');
-            sink_.push_back(':');
+            sink_.append(quote_colon_k().data(), quote_colon_k().size());
             return true;
         }
 
@@ -1242,7 +1319,7 @@ namespace detail {
                     {
                         sink_.push_back('~');
                     }
-                    encode_base64(v.begin(), v.end(), sink_);
+                    encode_base64(v.data(), v.data() + v.size(), sink_);
                     sink_.push_back('\"');
                     break;
                 }
@@ -1258,7 +1335,7 @@ namespace detail {
                     {
                         sink_.push_back('~');
                     }
-                    encode_base64url(v.begin(), v.end(), sink_);
+                    encode_base64url(v.data(), v.data() + v.size(), sink_);
                     sink_.push_back('\"');
                     break;
                 }
@@ -1426,7 +1503,7 @@ namespace detail {
             }
             else
             {
-                fp_(value, sink_);
+                jsoncons::detail::write_finite_double(fp_, value, sink_);
             }
 
             if (!stack_.empty())
@@ -1436,6 +1513,28 @@ namespace detail {
             return true;
         }
 
+        bool visit_number_text(const string_view_type& sv, 
+                               semantic_tag tag,
+                               const ser_context& context,
+                               std::error_code& ec) override
+        {
+            if (!jsoncons::detail::is_json_number(sv.data(), sv.length()))
+            {
+                static const jsoncons::detail::to_double_t to_double;
+                return visit_double(to_double(sv.data(), sv.length()), tag, context, ec);
+            }
+            if (!stack_.empty() && stack_.back().is_array() && stack_.back().count() > 0)
+            {
+                sink_.push_back(',');
+            }
+            sink_.append(sv.data(), sv.size());
+            if (!stack_.empty())
+            {
+                stack_.back().increment_count();
+            }
+            return true;
+        }
+
         bool visit_int64(int64_t value, 
                             semantic_tag,
                             const ser_context&,
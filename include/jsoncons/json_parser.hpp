@@ -21,6 +21,7 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd.hpp>
 
 #define JSONCONS_ILLEGAL_CONTROL_CHARACTER \
         case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b: \
@@ -31,6 +32,37 @@ namespace jsoncons {
 
 namespace detail {
 
+    template <class CharT>
+    const CharT* find_string_special(const CharT* first, const CharT* last)
+    {
+        for (const CharT* p = first; p != last; ++p)
+        {
+            uint32_t c = static_cast<uint32_t>(*p);
+            if (c <= 0x1f || c == '\"' || c == '\\')
+            {
+                return p;
+            }
+        }
+        return last;
+    }
+
+    // Returns the length of the UTF-8 sequence at first, or 0 if it is invalid or extends past last
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) == sizeof(uint8_t),std::size_t>::type
+    legal_utf8_length(const CharT* first, const CharT* last)
+    {
+        std::size_t length = static_cast<std::size_t>(unicons::trailing_bytes_for_utf8[static_cast<uint8_t>(*first)]) + 1;
+        return length <= static_cast<std::size_t>(last - first) && unicons::is_legal_utf8(first, length) == unicons::conv_errc() 
+            ? length : 0;
+    }
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) != sizeof(uint8_t),std::size_t>::type
+    legal_utf8_length(const CharT*, const CharT*)
+    {
+        return 0;
+    }
+
 }
 
 enum class json_parse_state : uint8_t 
@@ -152,6 +184,7 @@ private:
     json_parse_state state_;
     bool more_;
     bool done_;
+    bool validate_string_;
 
     std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type> string_buffer_;
     jsoncons::detail::to_double_t to_double_;
@@ -198,6 +231,7 @@ public:
          state_(json_parse_state::start),
          more_(true),
          done_(false),
+         validate_string_(false),
          string_buffer_(alloc),
          state_stack_(alloc)
     {
@@ -438,6 +472,7 @@ public:
         state_ = json_parse_state::start;
         more_ = true;
         done_ = false;
+        validate_string_ = false;
         line_ = 1;
         column_ = 1;
         nesting_depth_ = 0;
@@ -2103,6 +2138,11 @@ exp3:
 string_u1:
         while (input_ptr_ < local_input_end)
         {
+            input_ptr_ = jsoncons::detail::find_string_special(input_ptr_, local_input_end);
+            if (input_ptr_ == local_input_end)
+            {
+                break;
+            }
             switch (*input_ptr_)
             {
                 JSONCONS_ILLEGAL_CONTROL_CHARACTER:
@@ -2195,6 +2235,18 @@ string_u1:
                     return;
                 }
             default:
+                // A multi-byte UTF-8 sequence, validated here so that end_string_value 
+                // need not make a second pass over the string
+                {
+                    std::size_t length = jsoncons::detail::legal_utf8_length(input_ptr_, local_input_end);
+                    if (length > 0)
+                    {
+                        input_ptr_ += length;
+                        continue;
+                    }
+                    // Invalid or split across buffers, leave it to end_string_value
+                    validate_string_ = true;
+                }
                 break;
             }
             ++input_ptr_;
@@ -2260,6 +2312,7 @@ escape:
             cp_ = 0;
             ++input_ptr_;
             ++column_;
+            validate_string_ = true;
             goto escape_u1;
         default:    
             err_handler_(json_errc::illegal_escaped_character, *this);
@@ -2613,6 +2666,10 @@ private:
             {
                 more_ = visitor.string_value(string_buffer_, semantic_tag::bigdec, *this, ec);
             }
+            else if (options_.lazy_number())
+            {
+                more_ = visitor.number_text_value(string_buffer_, semantic_tag::none, *this, ec);
+            }
             else
             {
                 double d = to_double_(string_buffer_.c_str(), string_buffer_.length());
@@ -2679,12 +2736,16 @@ private:
     void end_string_value(const CharT* s, std::size_t length, basic_json_visitor<CharT>& visitor, std::error_code& ec) 
     {
         string_view_type sv(s, length);
-        auto result = unicons::validate(s,s+length);
-        if (result.ec != unicons::conv_errc())
+        if (validate_string_ || sizeof(CharT) != sizeof(uint8_t))
         {
-            translate_conv_errc(result.ec,ec);
-            column_ += (result.it - s);
-            return;
+            validate_string_ = false;
+            auto result = unicons::validate(s,s+length);
+            if (result.ec != unicons::conv_errc())
+            {
+                translate_conv_errc(result.ec,ec);
+                column_ += (result.it - s);
+                return;
+            }
         }
         switch (parent())
         {
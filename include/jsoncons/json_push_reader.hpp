@@ -0,0 +1,164 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_PUSH_READER_HPP
+#define JSONCONS_JSON_PUSH_READER_HPP
+
+#include <memory> // std::allocator
+#include <string>
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_parser.hpp>
+
+namespace jsoncons {
+
+// basic_json_push_reader
+
+// Parses a sequence of JSON texts fed in chunks as they arrive, sending events to
+// a visitor as soon as they are recognized. Partial tokens at the end of a chunk
+// are copied, so the caller's buffer may be reused as soon as feed returns.
+
+template <class CharT,class TempAllocator=std::allocator<char>>
+class basic_json_push_reader : public ser_context
+{
+public:
+    using char_type = CharT;
+    using string_view_type = jsoncons::basic_string_view<CharT>;
+private:
+    basic_json_visitor<CharT>& visitor_;
+    basic_json_parser<CharT,TempAllocator> parser_;
+    bool stopped_;
+
+    // Noncopyable and nonmoveable
+    basic_json_push_reader(const basic_json_push_reader&) = delete;
+    basic_json_push_reader& operator=(const basic_json_push_reader&) = delete;
+public:
+    basic_json_push_reader(basic_json_visitor<CharT>& visitor,
+                           const TempAllocator& alloc = TempAllocator())
+        : basic_json_push_reader(visitor, basic_json_decode_options<CharT>(), alloc)
+    {
+    }
+
+    basic_json_push_reader(basic_json_visitor<CharT>& visitor,
+                           const basic_json_decode_options<CharT>& options,
+                           const TempAllocator& alloc = TempAllocator())
+        : visitor_(visitor),
+          parser_(options, alloc),
+          stopped_(false)
+    {
+    }
+
+    void feed(const string_view_type& sv)
+    {
+        feed(sv.data(), sv.size());
+    }
+
+    void feed(const CharT* data, std::size_t length)
+    {
+        std::error_code ec;
+        feed(data, length, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+    }
+
+    void feed(const string_view_type& sv, std::error_code& ec)
+    {
+        feed(sv.data(), sv.size(), ec);
+    }
+
+    void feed(const CharT* data, std::size_t length, std::error_code& ec)
+    {
+        if (stopped_)
+        {
+            return;
+        }
+        parser_.update(data, length);
+        // A completed root value is only flushed on the next call to parse_some
+        while (!parser_.source_exhausted() || parser_.state() == json_parse_state::before_done)
+        {
+            if (parser_.done())
+            {
+                parser_.reset();
+            }
+            parser_.parse_some(visitor_, ec);
+            if (ec)
+            {
+                stopped_ = true;
+                return;
+            }
+            // A visitor returning false at the end of a root value (as json_decoder does)
+            // completes that value rather than stopping
+            if (parser_.stopped() && !parser_.done() && parser_.state() != json_parse_state::before_done)
+            {
+                stopped_ = true;
+                return;
+            }
+        }
+    }
+
+    void finish()
+    {
+        std::error_code ec;
+        finish(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+    }
+
+    // Signals the end of input, completing a trailing number
+    // or reporting unexpected_eof inside a value
+    void finish(std::error_code& ec)
+    {
+        parser_.update(nullptr, 0);
+        while (!stopped_ && !parser_.finished())
+        {
+            if (parser_.state() == json_parse_state::start)
+            {
+                return;
+            }
+            parser_.parse_some(visitor_, ec);
+            if (ec)
+            {
+                stopped_ = true;
+                return;
+            }
+        }
+    }
+
+    // Parsing has stopped, because of an error or because the visitor returned false
+    bool stopped() const
+    {
+        return stopped_;
+    }
+
+    void reset()
+    {
+        parser_.reset();
+        stopped_ = false;
+    }
+
+    std::size_t line() const override
+    {
+        return parser_.line();
+    }
+
+    std::size_t column() const override
+    {
+        return parser_.column();
+    }
+};
+
+using json_push_reader = basic_json_push_reader<char>;
+using wjson_push_reader = basic_json_push_reader<wchar_t>;
+
+}
+
+#endif
+
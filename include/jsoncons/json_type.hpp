@@ -36,7 +36,10 @@ namespace jsoncons {
         byte_string_value = 0x08,
         array_value = 0x09,
         empty_object_value = 0x0a,
-        object_value = 0x0b
+        object_value = 0x0b,
+        typed_array_value = 0x0c,
+        short_number_value = 0x0d,
+        long_number_value = 0x0e
     };
 
 } // jsoncons
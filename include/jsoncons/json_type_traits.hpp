@@ -22,6 +22,7 @@
 #include <jsoncons/bignum.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/typed_array_view.hpp>
 #include <string>
 #include <tuple>
 #include <map>
@@ -93,6 +94,34 @@ namespace detail {
         !is_json_type_traits_unspecialized<Json,typename std::iterator_traits<typename T::iterator>::value_type>::value
     >::type> : std::true_type {};
 
+    // array_element_as
+
+    // Converts an array element to a number with one storage kind check, other kinds 
+    // take the general path 
+    template <class T, class Json>
+    typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T,bool>::value,T>::type
+    array_element_as(const Json& item)
+    {
+        switch (item.storage())
+        {
+            case storage_kind::int64_value:
+                return static_cast<T>(item.template as_integer<int64_t>());
+            case storage_kind::uint64_value:
+                return static_cast<T>(item.template as_integer<uint64_t>());
+            case storage_kind::double_value:
+                return static_cast<T>(item.as_double());
+            default:
+                return item.template as<T>();
+        }
+    }
+
+    template <class T, class Json>
+    typename std::enable_if<!(std::is_arithmetic<T>::value && !std::is_same<T,bool>::value),T>::type
+    array_element_as(const Json& item)
+    {
+        return item.template as<T>();
+    }
+
 } // namespace detail
 
     // is_json_type_traits_specialized
@@ -368,8 +397,26 @@ namespace detail {
         typedef typename std::iterator_traits<typename T::iterator>::value_type value_type;
         using allocator_type = typename Json::allocator_type;
 
+        // Containers of numbers are filled from an ordinary array in one pass, 
+        // sized once and written through data() when they are contiguous
+        using is_number_container = std::integral_constant<bool, 
+            std::is_arithmetic<value_type>::value && !std::is_same<value_type,bool>::value>;
+        using is_sizable = std::integral_constant<bool, 
+            jsoncons::detail::has_data_and_size<T>::value &&
+            std::is_constructible<T,std::size_t>::value>;
+
+        // Sizable containers of typed array element types convert to and from packed 
+        // typed array storage with a memcpy
+        using is_packable = std::integral_constant<bool, 
+            jsoncons::detail::typed_array_element_traits<value_type>::value && is_sizable::value>;
+
         static bool is(const Json& j) noexcept
         {
+            if (j.is_typed_array() && jsoncons::detail::typed_array_element_traits<value_type>::value &&
+                j.as_typed_array_view().type() == element_type())
+            {
+                return true;
+            }
             bool result = j.is_array();
             if (result)
             {
@@ -389,16 +436,15 @@ namespace detail {
         static typename std::enable_if<!std::is_same<Ty,uint8_t>::value,T>::type
         as(const Json& j)
         {
+            if (j.is_typed_array() && std::is_arithmetic<value_type>::value)
+            {
+                return from_typed_array(j.as_typed_array_view(), 
+                                        std::integral_constant<bool, std::is_arithmetic<value_type>::value>(), 
+                                        is_packable());
+            }
             if (j.is_array())
             {
-                T result;
-                visit_reserve_(typename std::integral_constant<bool, jsoncons::detail::has_reserve<T>::value>::type(),result,j.size());
-                for (const auto& item : j.array_range())
-                {
-                    result.push_back(item.template as<value_type>());
-                }
-
-                return result;
+                return from_array(j, is_number_container(), is_sizable());
             }
             else 
             {
@@ -412,16 +458,13 @@ namespace detail {
         {
             converter<T> convert{};
             std::error_code ec;
+            if (j.is_typed_array())
+            {
+                return from_typed_array(j.as_typed_array_view(), std::true_type(), is_packable());
+            }
             if (j.is_array())
             {
-                T result;
-                visit_reserve_(typename std::integral_constant<bool, jsoncons::detail::has_reserve<T>::value>::type(),result,j.size());
-                for (const auto& item : j.array_range())
-                {
-                    result.push_back(item.template as<value_type>());
-                }
-
-                return result;
+                return from_array(j, is_number_container(), is_sizable());
             }
             else if (j.is_byte_string_view())
             {
@@ -445,32 +488,103 @@ namespace detail {
 
         static Json to_json(const T& val)
         {
-            Json j(json_array_arg);
-            auto first = std::begin(val);
-            auto last = std::end(val);
-            size_t size = std::distance(first,last);
-            j.reserve(size);
-            for (auto it = first; it != last; ++it)
-            {
-                j.push_back(*it);
-            }
-            return j;
+            return to_json(val, allocator_type());
         }
 
         static Json to_json(const T& val, const allocator_type& alloc)
         {
-            Json j(json_array_arg, alloc);
+            return to_json_(val, alloc, is_packable());
+        }
+
+        static Json to_json_(const T& val, const allocator_type& alloc, std::true_type)
+        {
+            return Json(typed_array_arg, val, semantic_tag::none, alloc);
+        }
+
+        static Json to_json_(const T& val, const allocator_type& alloc, std::false_type)
+        {
+            Json j(json_array_arg, semantic_tag::none, alloc);
             auto first = std::begin(val);
             auto last = std::end(val);
             size_t size = std::distance(first, last);
             j.reserve(size);
             for (auto it = first; it != last; ++it)
             {
-                j.push_back(*it);
+                j.emplace_back(*it);
             }
             return j;
         }
 
+        template <class IsNumberContainer>
+        static T from_array(const Json& j, IsNumberContainer, std::false_type)
+        {
+            T result;
+            visit_reserve_(typename std::integral_constant<bool, jsoncons::detail::has_reserve<T>::value>::type(),result,j.size());
+            for (const auto& item : j.array_range())
+            {
+                result.push_back(jsoncons::detail::array_element_as<value_type>(item));
+            }
+            return result;
+        }
+
+        static T from_array(const Json& j, std::true_type, std::true_type)
+        {
+            T result(j.size());
+            auto p = result.data();
+            for (const auto& item : j.array_range())
+            {
+                *p++ = jsoncons::detail::array_element_as<value_type>(item);
+            }
+            return result;
+        }
+
+        static T from_array(const Json& j, std::false_type, std::true_type)
+        {
+            return from_array(j, std::false_type(), std::false_type());
+        }
+
+        static T from_typed_array(const typed_array_view&, std::false_type, std::false_type)
+        {
+            JSONCONS_THROW(ser_error(convert_errc::not_vector));
+        }
+
+        static T from_typed_array(const typed_array_view& v, std::true_type, std::true_type)
+        {
+            if (v.type() == element_type())
+            {
+                T result(v.size());
+                if (v.size() > 0)
+                {
+                    std::memcpy(result.data(), v.data(typename jsoncons::detail::typed_array_element_traits<value_type>::arg_type()).data(), v.size()*sizeof(value_type));
+                }
+                return result;
+            }
+            return from_typed_array(v, std::true_type(), std::false_type());
+        }
+
+        static T from_typed_array(const typed_array_view& v, std::true_type, std::false_type)
+        {
+            T result;
+            visit_reserve_(typename std::integral_constant<bool, jsoncons::detail::has_reserve<T>::value>::type(),result,v.size());
+            jsoncons::detail::append_typed_array(v, result);
+            return result;
+        }
+
+        static typed_array_type element_type()
+        {
+            return element_type_(std::integral_constant<bool,jsoncons::detail::typed_array_element_traits<value_type>::value>());
+        }
+
+        static typed_array_type element_type_(std::true_type)
+        {
+            return jsoncons::detail::typed_array_element_traits<value_type>::type;
+        }
+
+        static typed_array_type element_type_(std::false_type)
+        {
+            return typed_array_type();
+        }
+
         static void visit_reserve_(std::true_type, T& v, size_t size)
         {
             v.reserve(size);
@@ -725,35 +839,93 @@ namespace detail {
         {
             std::array<E, N> buff;
             JSONCONS_ASSERT(j.size() == N);
-            for (size_t i = 0; i < N; i++)
+            if (j.is_typed_array() && from_typed_array(j.as_typed_array_view(), buff, std::integral_constant<bool,jsoncons::detail::typed_array_element_traits<E>::value>()))
+            {
+                return buff;
+            }
+            std::size_t i = 0;
+            for (const auto& item : j.array_range())
             {
-                buff[i] = j[i].template as<E>();
+                buff[i++] = jsoncons::detail::array_element_as<E>(item);
             }
             return buff;
         }
 
         static Json to_json(const std::array<E, N>& val)
         {
-            Json j(json_array_arg);
-            j.reserve(N);
-            for (auto it = val.begin(); it != val.end(); ++it)
-            {
-                j.push_back(*it);
-            }
-            return j;
+            return to_json(val, allocator_type());
         }
 
         static Json to_json(const std::array<E, N>& val, 
                             const allocator_type& alloc)
         {
-            Json j(json_array_arg, alloc);
+            return to_json_(val, alloc, std::integral_constant<bool,jsoncons::detail::typed_array_element_traits<E>::value>());
+        }
+    private:
+        static Json to_json_(const std::array<E, N>& val, const allocator_type& alloc, std::true_type)
+        {
+            return Json(typed_array_arg, val, semantic_tag::none, alloc);
+        }
+
+        static Json to_json_(const std::array<E, N>& val, const allocator_type& alloc, std::false_type)
+        {
+            Json j(json_array_arg, semantic_tag::none, alloc);
             j.reserve(N);
             for (auto it = val.begin(); it != val.end(); ++it)
             {
-                j.push_back(*it);
+                j.emplace_back(*it);
             }
             return j;
         }
+
+        // Copies the packed elements if their type is E
+        static bool from_typed_array(const typed_array_view& v, std::array<E, N>& buff, std::true_type)
+        {
+            if (v.type() != jsoncons::detail::typed_array_element_traits<E>::type)
+            {
+                return false;
+            }
+            if (N > 0)
+            {
+                std::memcpy(buff.data(), v.data(typename jsoncons::detail::typed_array_element_traits<E>::arg_type()).data(), N*sizeof(E));
+            }
+            return true;
+        }
+
+        static bool from_typed_array(const typed_array_view&, std::array<E, N>&, std::false_type)
+        {
+            return false;
+        }
+    };
+
+    // span
+
+    // A span of const numbers is a view of the packed storage of a typed array with the same
+    // element type, and converts to a typed array with a single copy.
+    template<class Json, class T>
+    struct json_type_traits<Json, span<const T>,
+                            typename std::enable_if<jsoncons::detail::typed_array_element_traits<T>::value>::type>
+    {
+        using allocator_type = typename Json::allocator_type;
+
+        static bool is(const Json& j) noexcept
+        {
+            return j.is_typed_array() && j.as_typed_array_view().type() == jsoncons::detail::typed_array_element_traits<T>::type;
+        }
+
+        static span<const T> as(const Json& j)
+        {
+            if (!is(j))
+            {
+                JSONCONS_THROW(ser_error(convert_errc::not_vector));
+            }
+            return j.as_typed_array_view().data(typename jsoncons::detail::typed_array_element_traits<T>::arg_type());
+        }
+
+        static Json to_json(const span<const T>& val, const allocator_type& alloc = allocator_type())
+        {
+            return Json(typed_array_arg, val, semantic_tag::none, alloc);
+        }
     };
 
 namespace detail
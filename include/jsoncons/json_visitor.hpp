@@ -15,6 +15,7 @@
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/tag_type.hpp>
 #include <jsoncons/byte_string.hpp>
+#include <jsoncons/detail/parse_number.hpp>
 
 namespace jsoncons {
 
@@ -180,7 +181,7 @@ namespace jsoncons {
                                semantic_tag tag=semantic_tag::none, 
                                const ser_context& context=ser_context())
         {
-            return byte_string_value(byte_string(p, size), tag, context);
+            return byte_string_value(byte_string_view(p, size), tag, context);
         }
 
         bool uint64_value(uint64_t value, 
@@ -235,6 +236,19 @@ namespace jsoncons {
             return more;
         }
 
+        bool number_text_value(const string_view_type& value, 
+                               semantic_tag tag = semantic_tag::none, 
+                               const ser_context& context=ser_context())
+        {
+            std::error_code ec;
+            bool more = visit_number_text(value, tag, context, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec, context.line(), context.column()));
+            }
+            return more;
+        }
+
         bool begin_object(semantic_tag tag,
                           const ser_context& context,
                           std::error_code& ec)
@@ -313,7 +327,7 @@ namespace jsoncons {
                                const ser_context& context,
                                std::error_code& ec)
         {
-            return byte_string_value(byte_string(p, size), tag, context, ec);
+            return byte_string_value(byte_string_view(p, size), tag, context, ec);
         }
 
         bool uint64_value(uint64_t value, 
@@ -348,6 +362,14 @@ namespace jsoncons {
             return visit_double(value, tag, context, ec);
         }
 
+        bool number_text_value(const string_view_type& value, 
+                               semantic_tag tag, 
+                               const ser_context& context,
+                               std::error_code& ec)
+        {
+            return visit_number_text(value, tag, context, ec);
+        }
+
         template <class T>
         bool typed_array(const span<T>& data, 
                          semantic_tag tag=semantic_tag::none,
@@ -487,7 +509,7 @@ namespace jsoncons {
                 default:
                     break;
             }
-            return byte_string_value(byte_string(p, size), tag, context);
+            return byte_string_value(byte_string_view(p, size), tag, context);
         }
 
         JSONCONS_DEPRECATED_MSG("Instead, use string_value with semantic_tag::bigint") 
@@ -670,6 +692,17 @@ namespace jsoncons {
                                const ser_context& context,
                                std::error_code& ec) = 0;
 
+        // The unconverted text of a number, as kept by a lazy number. JSON encoders write
+        // the text as it is, other visitors receive the double it denotes.
+        virtual bool visit_number_text(const string_view_type& value, 
+                                       semantic_tag tag,
+                                       const ser_context& context,
+                                       std::error_code& ec)
+        {
+            static const jsoncons::detail::to_double_t to_double;
+            return visit_double(to_double(value.data(), value.length()), tag, context, ec);
+        }
+
         virtual bool visit_typed_array(const span<const uint8_t>& s, 
                                     semantic_tag tag,
                                     const ser_context& context, 
@@ -1170,6 +1203,14 @@ namespace jsoncons {
             return more0 && more1;
         }
 
+        bool visit_number_text(const string_view_type& value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            bool more0 =  destination0_.number_text_value(value, tag, context, ec);
+            bool more1 =  destination1_.number_text_value(value, tag, context, ec);
+
+            return more0 && more1;
+        }
+
         bool visit_bool(bool value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
         {
             bool more0 =  destination0_.bool_value(value, tag, context, ec);
@@ -179,7 +179,7 @@ namespace jsoncons {
                                semantic_tag tag=semantic_tag::none, 
                                const ser_context& context=ser_context())
         {
-            return byte_string_value(byte_string(p, size), tag, context);
+            return byte_string_value(byte_string_view(p, size), tag, context);
         }
 
         bool uint64_value(uint64_t value, 
@@ -312,7 +312,7 @@ namespace jsoncons {
                                const ser_context& context,
                                std::error_code& ec)
         {
-            return byte_string_value(byte_string(p, size), tag, context, ec);
+            return byte_string_value(byte_string_view(p, size), tag, context, ec);
         }
 
         bool uint64_value(uint64_t value, 
@@ -0,0 +1,301 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PREFETCHING_SOURCE_HPP
+#define JSONCONS_PREFETCHING_SOURCE_HPP
+
+#include <vector>
+#include <memory> // std::unique_ptr
+#include <cstring> // std::memcpy
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <type_traits> // std::enable_if
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+
+namespace jsoncons {
+
+    // prefetching_source
+
+    // Reads from Src on a background thread into a ring of chunk buffers,
+    // so that reading ahead overlaps with parsing the current chunk
+
+    template <class Src>
+    class prefetching_source
+    {
+    public:
+        using value_type = typename Src::value_type;
+        using traits_type = typename Src::traits_type;
+
+        static constexpr std::size_t default_chunk_size = 65536;
+        static constexpr std::size_t default_depth = 2;
+    private:
+        struct shared_state
+        {
+            Src source;
+            std::size_t chunk_size;
+            std::vector<std::vector<value_type>> chunks;
+            std::size_t head;
+            std::size_t count;
+            bool done;
+            bool is_error;
+            bool stop;
+            std::mutex mutex;
+            std::condition_variable not_empty;
+            std::condition_variable not_full;
+            std::thread thread;
+
+            template <class Source>
+            shared_state(Source&& source, std::size_t chunk_size, std::size_t depth)
+                : source(std::forward<Source>(source)),
+                  chunk_size(chunk_size == 0 ? 1 : chunk_size),
+                  chunks(depth == 0 ? 1 : depth),
+                  head(0), count(0), done(false), is_error(false), stop(false)
+            {
+            }
+        };
+
+        std::unique_ptr<shared_state> state_;
+        std::vector<value_type> current_;
+        std::size_t current_pos_;
+        std::size_t position_;
+        bool eof_;
+
+        // Noncopyable
+        prefetching_source(const prefetching_source&) = delete;
+        prefetching_source& operator=(const prefetching_source&) = delete;
+    public:
+        prefetching_source()
+            : current_pos_(0), position_(0), eof_(true)
+        {
+        }
+
+        template <class Source,
+                  class = typename std::enable_if<!std::is_same<typename std::decay<Source>::type,prefetching_source>::value>::type>
+        prefetching_source(Source&& source,
+                           std::size_t chunk_size = default_chunk_size,
+                           std::size_t depth = default_depth)
+            : state_(new shared_state(std::forward<Source>(source), chunk_size, depth)),
+              current_pos_(0), position_(0), eof_(false)
+        {
+            shared_state* state = state_.get();
+            state_->thread = std::thread([state](){fill(*state);});
+        }
+
+        prefetching_source(prefetching_source&& other) noexcept
+            : state_(std::move(other.state_)), current_(std::move(other.current_)),
+              current_pos_(other.current_pos_), position_(other.position_), eof_(other.eof_)
+        {
+            other.current_pos_ = 0;
+            other.eof_ = true;
+        }
+
+        ~prefetching_source() noexcept
+        {
+            close();
+        }
+
+        prefetching_source& operator=(prefetching_source&& other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                state_ = std::move(other.state_);
+                current_ = std::move(other.current_);
+                current_pos_ = other.current_pos_;
+                position_ = other.position_;
+                eof_ = other.eof_;
+                other.current_pos_ = 0;
+                other.eof_ = true;
+            }
+            return *this;
+        }
+
+        bool eof() const
+        {
+            return eof_;
+        }
+
+        bool is_error() const
+        {
+            if (!state_)
+            {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            return state_->is_error;
+        }
+
+        std::size_t position() const
+        {
+            return position_;
+        }
+
+        std::size_t get(value_type& c)
+        {
+            if (current_pos_ == current_.size() && !next_chunk())
+            {
+                return 0;
+            }
+            c = current_[current_pos_++];
+            ++position_;
+            return 1;
+        }
+
+        int get()
+        {
+            if (current_pos_ == current_.size() && !next_chunk())
+            {
+                return traits_type::eof();
+            }
+            ++position_;
+            return to_int(current_[current_pos_++]);
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0)
+            {
+                if (current_pos_ == current_.size() && !next_chunk())
+                {
+                    return;
+                }
+                std::size_t n = (std::min)(count, current_.size() - current_pos_);
+                current_pos_ += n;
+                position_ += n;
+                count -= n;
+            }
+        }
+
+        int peek()
+        {
+            if (current_pos_ == current_.size() && !next_chunk())
+            {
+                return traits_type::eof();
+            }
+            return to_int(current_[current_pos_]);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t unread = length;
+            while (unread > 0)
+            {
+                if (current_pos_ == current_.size() && !next_chunk())
+                {
+                    break;
+                }
+                std::size_t n = (std::min)(unread, current_.size() - current_pos_);
+                std::memcpy(p, current_.data() + current_pos_, n*sizeof(value_type));
+                p += n;
+                current_pos_ += n;
+                unread -= n;
+            }
+            position_ += length - unread;
+            return length - unread;
+        }
+    private:
+        static int to_int(value_type c)
+        {
+            return static_cast<int>(static_cast<typename std::make_unsigned<value_type>::type>(c));
+        }
+
+        // Exchanges the consumed chunk for the next filled one,
+        // waiting for the background thread if necessary
+        bool next_chunk()
+        {
+            if (eof_)
+            {
+                return false;
+            }
+            std::unique_lock<std::mutex> lock(state_->mutex);
+            state_->not_empty.wait(lock, [this](){return state_->count > 0 || state_->done;});
+            if (state_->count == 0)
+            {
+                eof_ = true;
+                return false;
+            }
+            current_.swap(state_->chunks[state_->head]);
+            state_->head = (state_->head + 1) % state_->chunks.size();
+            --state_->count;
+            current_pos_ = 0;
+            lock.unlock();
+            state_->not_full.notify_one();
+            return true;
+        }
+
+        void close() noexcept
+        {
+            if (state_)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(state_->mutex);
+                    state_->stop = true;
+                }
+                state_->not_full.notify_one();
+                state_->thread.join();
+                state_.reset();
+            }
+        }
+
+        // Runs on the background thread, filling free chunks until the source
+        // is exhausted or the prefetching_source is destroyed
+        static void fill(shared_state& state) noexcept
+        {
+            bool is_error = false;
+            JSONCONS_TRY
+            {
+                bool more = true;
+                while (more)
+                {
+                    std::size_t index;
+                    {
+                        std::unique_lock<std::mutex> lock(state.mutex);
+                        state.not_full.wait(lock, [&state](){return state.count < state.chunks.size() || state.stop;});
+                        if (state.stop)
+                        {
+                            return;
+                        }
+                        index = (state.head + state.count) % state.chunks.size();
+                    }
+                    // The free chunk at index belongs to this thread until it is counted
+                    std::vector<value_type>& chunk = state.chunks[index];
+                    chunk.resize(state.chunk_size);
+                    std::size_t n = state.source.read(chunk.data(), chunk.size());
+                    chunk.resize(n);
+                    more = !state.source.eof() && !state.source.is_error();
+                    is_error = state.source.is_error();
+                    if (n > 0)
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        ++state.count;
+                    }
+                    state.not_empty.notify_one();
+                }
+            }
+            JSONCONS_CATCH(const std::exception&)
+            {
+                is_error = true;
+            }
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.done = true;
+                state.is_error = is_error;
+            }
+            state.not_empty.notify_one();
+        }
+    };
+
+    template <class Src>
+    constexpr std::size_t prefetching_source<Src>::default_chunk_size;
+    template <class Src>
+    constexpr std::size_t prefetching_source<Src>::default_depth;
+
+} // namespace jsoncons
+
+#endif
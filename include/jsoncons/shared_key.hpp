@@ -0,0 +1,452 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_SHARED_KEY_HPP
+#define JSONCONS_SHARED_KEY_HPP
+
+#include <string>
+#include <ostream>
+#include <atomic>
+#include <memory> // std::allocator
+#include <utility> // std::move
+#include <cstring> // std::memcpy
+#include <functional> // std::hash
+#include <iterator>
+#include <type_traits>
+#include <jsoncons/config/jsoncons_config.hpp>
+
+namespace jsoncons {
+
+    // basic_shared_key is an immutable string whose copies share one reference counted buffer.
+    // Used as an object key type (see shared_key_policy), equal keys produced by json_decoder
+    // share storage, and comparisons between keys that share storage take a pointer comparison.
+
+    template <class CharT, class Traits = std::char_traits<CharT>, class Allocator = std::allocator<CharT>>
+    class basic_shared_key
+    {
+    public:
+        using value_type = CharT;
+        using traits_type = Traits;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using const_reference = const CharT&;
+        using reference = const CharT&;
+        using const_pointer = const CharT*;
+        using pointer = const CharT*;
+        using const_iterator = const CharT*;
+        using iterator = const CharT*;
+        using string_view_type = jsoncons::basic_string_view<CharT,Traits>;
+    private:
+        struct rep
+        {
+            std::atomic<std::size_t> count_;
+            std::size_t length_;
+
+            rep(std::size_t length)
+                : count_(1), length_(length)
+            {
+            }
+
+            CharT* data()
+            {
+                return reinterpret_cast<CharT*>(reinterpret_cast<char*>(this) + header_size());
+            }
+        };
+
+        using byte_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<rep>;
+        using byte_allocator_traits = std::allocator_traits<byte_allocator_type>;
+
+        allocator_type alloc_;
+        rep* rep_;
+    public:
+        basic_shared_key()
+            : alloc_(), rep_(nullptr)
+        {
+        }
+
+        explicit basic_shared_key(const allocator_type& alloc)
+            : alloc_(alloc), rep_(nullptr)
+        {
+        }
+
+        basic_shared_key(const CharT* s, size_type length, const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), rep_(create(s, length))
+        {
+        }
+
+        basic_shared_key(const CharT* s, const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), rep_(create(s, Traits::length(s)))
+        {
+        }
+
+        template <class InputIt>
+        basic_shared_key(InputIt first, InputIt last, const allocator_type& alloc = allocator_type(),
+                         typename std::enable_if<!std::is_integral<InputIt>::value>::type* = 0)
+            : alloc_(alloc), rep_(nullptr)
+        {
+            std::basic_string<CharT,Traits> s(first, last);
+            rep_ = create(s.data(), s.length());
+        }
+
+        template <class SAllocator>
+        basic_shared_key(const std::basic_string<CharT,Traits,SAllocator>& s, const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), rep_(create(s.data(), s.length()))
+        {
+        }
+
+        explicit basic_shared_key(const string_view_type& sv, const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), rep_(create(sv.data(), sv.length()))
+        {
+        }
+
+        basic_shared_key(const basic_shared_key& other) noexcept
+            : alloc_(other.alloc_), rep_(other.rep_)
+        {
+            if (rep_ != nullptr)
+            {
+                rep_->count_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        basic_shared_key(const basic_shared_key& other, const allocator_type& alloc)
+            : alloc_(alloc), rep_(nullptr)
+        {
+            if (alloc_ == other.alloc_)
+            {
+                rep_ = other.rep_;
+                if (rep_ != nullptr)
+                {
+                    rep_->count_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            else
+            {
+                rep_ = create(other.data(), other.size());
+            }
+        }
+
+        basic_shared_key(basic_shared_key&& other) noexcept
+            : alloc_(std::move(other.alloc_)), rep_(other.rep_)
+        {
+            other.rep_ = nullptr;
+        }
+
+        ~basic_shared_key() noexcept
+        {
+            release();
+        }
+
+        basic_shared_key& operator=(const basic_shared_key& other) noexcept
+        {
+            if (rep_ != other.rep_)
+            {
+                basic_shared_key temp(other);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        basic_shared_key& operator=(basic_shared_key&& other) noexcept
+        {
+            if (this != &other)
+            {
+                swap(other);
+            }
+            return *this;
+        }
+
+        void swap(basic_shared_key& other) noexcept
+        {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+            swap(rep_, other.rep_);
+        }
+
+        allocator_type get_allocator() const
+        {
+            return alloc_;
+        }
+
+        const CharT* data() const
+        {
+            return rep_ != nullptr ? rep_->data() : empty_data();
+        }
+
+        const CharT* c_str() const
+        {
+            return data();
+        }
+
+        size_type size() const
+        {
+            return rep_ != nullptr ? rep_->length_ : 0;
+        }
+
+        size_type length() const
+        {
+            return size();
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        const_iterator begin() const
+        {
+            return data();
+        }
+
+        const_iterator end() const
+        {
+            return data() + size();
+        }
+
+        const CharT& operator[](size_type pos) const
+        {
+            return data()[pos];
+        }
+
+        // true if both keys refer to the same buffer
+        bool shares_storage_with(const basic_shared_key& other) const
+        {
+            return rep_ != nullptr && rep_ == other.rep_;
+        }
+
+        operator string_view_type() const noexcept
+        {
+            return string_view_type(data(), size());
+        }
+
+        int compare(const basic_shared_key& other) const
+        {
+            if (rep_ == other.rep_)
+            {
+                return 0;
+            }
+            return compare(other.data(), other.size());
+        }
+
+        int compare(const string_view_type& s) const
+        {
+            return compare(s.data(), s.length());
+        }
+
+        int compare(const CharT* s) const
+        {
+            return compare(s, Traits::length(s));
+        }
+
+        template <class SAllocator>
+        int compare(const std::basic_string<CharT,Traits,SAllocator>& s) const
+        {
+            return compare(s.data(), s.length());
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const basic_shared_key& key)
+        {
+            os.write(key.data(), key.size());
+            return os;
+        }
+
+    private:
+        static const CharT* empty_data()
+        {
+            static const CharT s[1] = {0};
+            return s;
+        }
+
+        static constexpr std::size_t header_size()
+        {
+            return (sizeof(rep) + sizeof(CharT) - 1) / sizeof(CharT) * sizeof(CharT);
+        }
+
+        static std::size_t rep_count(std::size_t length)
+        {
+            return (header_size() + (length+1)*sizeof(CharT) + sizeof(rep) - 1) / sizeof(rep);
+        }
+
+        int compare(const CharT* s, std::size_t length) const
+        {
+            const std::size_t len = size();
+            int result = Traits::compare(data(), s, (std::min)(len, length));
+            if (result != 0)
+            {
+                return result;
+            }
+            return len < length ? -1 : (len == length ? 0 : 1);
+        }
+
+        rep* create(const CharT* s, std::size_t length)
+        {
+            if (length == 0)
+            {
+                return nullptr;
+            }
+            byte_allocator_type alloc(alloc_);
+            const std::size_t n = rep_count(length);
+            rep* p = byte_allocator_traits::allocate(alloc, n);
+            ::new(static_cast<void*>(p)) rep(length);
+            CharT* d = p->data();
+            std::memcpy(d, s, length*sizeof(CharT));
+            d[length] = 0;
+            return p;
+        }
+
+        void release() noexcept
+        {
+            if (rep_ != nullptr && rep_->count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                byte_allocator_type alloc(alloc_);
+                const std::size_t n = rep_count(rep_->length_);
+                rep_->~rep();
+                byte_allocator_traits::deallocate(alloc, rep_, n);
+            }
+            rep_ = nullptr;
+        }
+    };
+
+    // ==
+    template <class CharT,class Traits,class Allocator>
+    bool operator==(const basic_shared_key<CharT,Traits,Allocator>& lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return lhs.shares_storage_with(rhs) || lhs.compare(rhs) == 0;
+    }
+    template <class CharT,class Traits,class Allocator>
+    bool operator==(const basic_shared_key<CharT,Traits,Allocator>& lhs, const jsoncons::basic_string_view<CharT,Traits>& rhs)
+    {
+        return lhs.compare(rhs) == 0;
+    }
+    template <class CharT,class Traits,class Allocator>
+    bool operator==(const jsoncons::basic_string_view<CharT,Traits>& lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return rhs.compare(lhs) == 0;
+    }
+    template <class CharT,class Traits,class Allocator>
+    bool operator==(const basic_shared_key<CharT,Traits,Allocator>& lhs, const CharT* rhs)
+    {
+        return lhs.compare(rhs) == 0;
+    }
+    template <class CharT,class Traits,class Allocator>
+    bool operator==(const CharT* lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return rhs.compare(lhs) == 0;
+    }
+    template <class CharT,class Traits,class Allocator,class SAllocator>
+    bool operator==(const basic_shared_key<CharT,Traits,Allocator>& lhs, const std::basic_string<CharT,Traits,SAllocator>& rhs)
+    {
+        return lhs.compare(rhs) == 0;
+    }
+    template <class CharT,class Traits,class Allocator,class SAllocator>
+    bool operator==(const std::basic_string<CharT,Traits,SAllocator>& lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return rhs.compare(lhs) == 0;
+    }
+
+    // !=
+    template <class CharT,class Traits,class Allocator>
+    bool operator!=(const basic_shared_key<CharT,Traits,Allocator>& lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class CharT,class Traits,class Allocator>
+    bool operator!=(const basic_shared_key<CharT,Traits,Allocator>& lhs, const jsoncons::basic_string_view<CharT,Traits>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class CharT,class Traits,class Allocator>
+    bool operator!=(const jsoncons::basic_string_view<CharT,Traits>& lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class CharT,class Traits,class Allocator>
+    bool operator!=(const basic_shared_key<CharT,Traits,Allocator>& lhs, const CharT* rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class CharT,class Traits,class Allocator>
+    bool operator!=(const CharT* lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class CharT,class Traits,class Allocator,class SAllocator>
+    bool operator!=(const basic_shared_key<CharT,Traits,Allocator>& lhs, const std::basic_string<CharT,Traits,SAllocator>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class CharT,class Traits,class Allocator,class SAllocator>
+    bool operator!=(const std::basic_string<CharT,Traits,SAllocator>& lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    // <, <=, >, >=
+    template <class CharT,class Traits,class Allocator>
+    bool operator<(const basic_shared_key<CharT,Traits,Allocator>& lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return lhs.compare(rhs) < 0;
+    }
+    template <class CharT,class Traits,class Allocator>
+    bool operator<=(const basic_shared_key<CharT,Traits,Allocator>& lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return lhs.compare(rhs) <= 0;
+    }
+    template <class CharT,class Traits,class Allocator>
+    bool operator>(const basic_shared_key<CharT,Traits,Allocator>& lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return lhs.compare(rhs) > 0;
+    }
+    template <class CharT,class Traits,class Allocator>
+    bool operator>=(const basic_shared_key<CharT,Traits,Allocator>& lhs, const basic_shared_key<CharT,Traits,Allocator>& rhs)
+    {
+        return lhs.compare(rhs) >= 0;
+    }
+
+    template <class CharT,class Traits,class Allocator>
+    void swap(basic_shared_key<CharT,Traits,Allocator>& lhs, basic_shared_key<CharT,Traits,Allocator>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    using shared_key = basic_shared_key<char>;
+    using wshared_key = basic_shared_key<wchar_t>;
+
+    namespace detail {
+
+    template <class CharT>
+    std::size_t fnv1a_hash(const CharT* s, std::size_t length) noexcept
+    {
+        std::size_t h = static_cast<std::size_t>(14695981039346656037ULL);
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            h = (h ^ static_cast<std::size_t>(s[i])) * static_cast<std::size_t>(1099511628211ULL);
+        }
+        return h;
+    }
+
+    template <class T>
+    struct is_shared_key : std::false_type {};
+
+    template <class CharT,class Traits,class Allocator>
+    struct is_shared_key<basic_shared_key<CharT,Traits,Allocator>> : std::true_type {};
+
+    } // namespace detail
+
+} // namespace jsoncons
+
+namespace std {
+    template <class CharT,class Traits,class Allocator>
+    struct hash<jsoncons::basic_shared_key<CharT,Traits,Allocator>>
+    {
+        std::size_t operator()(const jsoncons::basic_shared_key<CharT,Traits,Allocator>& key) const noexcept
+        {
+            return jsoncons::detail::fnv1a_hash(key.data(), key.size());
+        }
+    };
+} // namespace std
+
+#endif
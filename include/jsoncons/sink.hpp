@@ -14,6 +14,7 @@
 #include <cmath>
 #include <exception>
 #include <memory> // std::addressof
+#include <limits> // std::numeric_limits
 #include <cstring> // std::memcpy
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/detail/more_type_traits.hpp>
@@ -98,6 +99,29 @@ namespace jsoncons {
                 push_back(ch);
             }
         }
+
+        // Returns room for at least length characters, the first count of 
+        // which a following call to commit(count) adds to the output
+        CharT* reserve(std::size_t length)
+        {
+            if (static_cast<std::size_t>(end_buffer_ - p_) < length)
+            {
+                stream_ptr_->write(begin_buffer_, buffer_length());
+                if (buffer_.size() < length)
+                {
+                    buffer_.resize(length);
+                    begin_buffer_ = buffer_.data();
+                    end_buffer_ = begin_buffer_ + buffer_.size();
+                }
+                p_ = begin_buffer_;
+            }
+            return p_;
+        }
+
+        void commit(std::size_t count)
+        {
+            p_ += count;
+        }
     private:
 
         std::size_t buffer_length() const
@@ -188,6 +212,27 @@ namespace jsoncons {
                 push_back(ch);
             }
         }
+
+        uint8_t* reserve(std::size_t length)
+        {
+            if (static_cast<std::size_t>(end_buffer_ - p_) < length)
+            {
+                stream_ptr_->write((char*)begin_buffer_, buffer_length());
+                if (buffer_.size() < length)
+                {
+                    buffer_.resize(length);
+                    begin_buffer_ = buffer_.data();
+                    end_buffer_ = begin_buffer_ + buffer_.size();
+                }
+                p_ = begin_buffer_;
+            }
+            return p_;
+        }
+
+        void commit(std::size_t count)
+        {
+            p_ += count;
+        }
     private:
 
         std::size_t buffer_length() const
@@ -206,19 +251,20 @@ namespace jsoncons {
         using output_type = StringT;
     private:
         output_type* buf_ptr;
+        std::size_t reserved_pos_;
 
         // Noncopyable
         string_sink(const string_sink&) = delete;
         string_sink& operator=(const string_sink&) = delete;
     public:
         string_sink(string_sink&& val)
-            : buf_ptr(nullptr)
+            : buf_ptr(nullptr), reserved_pos_(0)
         {
             std::swap(buf_ptr,val.buf_ptr);
         }
 
         string_sink(output_type& buf)
-            : buf_ptr(std::addressof(buf))
+            : buf_ptr(std::addressof(buf)), reserved_pos_(0)
         {
         }
 
@@ -237,6 +283,18 @@ namespace jsoncons {
         {
             buf_ptr->push_back(ch);
         }
+
+        value_type* reserve(std::size_t length)
+        {
+            reserved_pos_ = buf_ptr->size();
+            buf_ptr->resize(reserved_pos_ + length);
+            return &(*buf_ptr)[reserved_pos_];
+        }
+
+        void commit(std::size_t count)
+        {
+            buf_ptr->resize(reserved_pos_ + count);
+        }
     };
 
     // bytes_sink
@@ -248,6 +306,7 @@ namespace jsoncons {
         typedef std::vector<uint8_t> output_type;
     private:
         output_type* buf_ptr;
+        std::size_t reserved_pos_;
 
         // Noncopyable
         bytes_sink(const bytes_sink&) = delete;
@@ -256,7 +315,7 @@ namespace jsoncons {
         bytes_sink(bytes_sink&&) = default;
 
         bytes_sink(output_type& buf)
-            : buf_ptr(std::addressof(buf))
+            : buf_ptr(std::addressof(buf)), reserved_pos_(0)
         {
         }
 
@@ -275,8 +334,497 @@ namespace jsoncons {
         {
             buf_ptr->push_back(ch);
         }
+
+        uint8_t* reserve(std::size_t length)
+        {
+            reserved_pos_ = buf_ptr->size();
+            buf_ptr->resize(reserved_pos_ + length);
+            return buf_ptr->data() + reserved_pos_;
+        }
+
+        void commit(std::size_t count)
+        {
+            buf_ptr->resize(reserved_pos_ + count);
+        }
+    };
+
+    // counting_sink
+
+    // Counts the characters or bytes written, for sizing a buffer before writing to it
+
+    template <class T>
+    class counting_sink
+    {
+    public:
+        using value_type = T;
+        using output_type = std::size_t;
+    private:
+        std::size_t* count_ptr_;
+        std::vector<T> scratch_;
+
+        // Noncopyable
+        counting_sink(const counting_sink&) = delete;
+        counting_sink& operator=(const counting_sink&) = delete;
+    public:
+        counting_sink(counting_sink&&) = default;
+
+        counting_sink(output_type& count)
+            : count_ptr_(std::addressof(count))
+        {
+        }
+
+        counting_sink& operator=(counting_sink&&) = default;
+
+        void flush()
+        {
+        }
+
+        void append(const T*, std::size_t length)
+        {
+            *count_ptr_ += length;
+        }
+
+        void push_back(T)
+        {
+            ++(*count_ptr_);
+        }
+
+        T* reserve(std::size_t length)
+        {
+            if (scratch_.size() < length)
+            {
+                scratch_.resize(length);
+            }
+            return scratch_.data();
+        }
+
+        void commit(std::size_t count)
+        {
+            *count_ptr_ += count;
+        }
+    };
+
+    // unchecked_sink
+
+    // Writes to a buffer already known to be large enough, without capacity checks
+
+    template <class T>
+    class unchecked_sink
+    {
+    public:
+        using value_type = T;
+        using output_type = T*;
+    private:
+        T* p_;
+
+        // Noncopyable
+        unchecked_sink(const unchecked_sink&) = delete;
+        unchecked_sink& operator=(const unchecked_sink&) = delete;
+    public:
+        unchecked_sink(unchecked_sink&&) = default;
+
+        unchecked_sink(output_type p)
+            : p_(p)
+        {
+        }
+
+        unchecked_sink& operator=(unchecked_sink&&) = default;
+
+        void flush()
+        {
+        }
+
+        void append(const T* s, std::size_t length)
+        {
+            std::memcpy(p_, s, length*sizeof(T));
+            p_ += length;
+        }
+
+        void push_back(T ch)
+        {
+            *p_++ = ch;
+        }
+
+        T* reserve(std::size_t)
+        {
+            return p_;
+        }
+
+        void commit(std::size_t count)
+        {
+            p_ += count;
+        }
+    };
+
+    // gather_buffer
+
+    // Output held as a sequence of segments, each either staged in an owned arena or 
+    // referring to data appended with append_external, for writing with writev or sendmsg
+
+    template <class T>
+    class gather_buffer
+    {
+    public:
+        using value_type = T;
+        using segment_type = jsoncons::span<const T>;
+    private:
+        struct entry
+        {
+            const T* data; // nullptr for bytes staged in the arena
+            std::size_t offset;
+            std::size_t length;
+        };
+
+        std::vector<T> arena_;
+        std::vector<entry> entries_;
+        std::size_t size_;
+        std::size_t reserved_pos_;
+    public:
+        gather_buffer()
+            : size_(0), reserved_pos_(0)
+        {
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        void clear()
+        {
+            arena_.clear();
+            entries_.clear();
+            size_ = 0;
+        }
+
+        // The segments in output order. Segments staged in the arena are valid 
+        // until the buffer is next modified.
+        std::vector<segment_type> segments() const
+        {
+            std::vector<segment_type> result;
+            result.reserve(entries_.size());
+            for (const auto& item : entries_)
+            {
+                if (item.data != nullptr)
+                {
+                    result.emplace_back(item.data, item.length);
+                }
+                else
+                {
+                    result.emplace_back(arena_.data() + item.offset, item.length);
+                }
+            }
+            return result;
+        }
+
+        void append(const T* s, std::size_t length)
+        {
+            arena_.insert(arena_.end(), s, s+length);
+            staged(length);
+        }
+
+        void push_back(T ch)
+        {
+            arena_.push_back(ch);
+            staged(1);
+        }
+
+        T* reserve(std::size_t length)
+        {
+            reserved_pos_ = arena_.size();
+            arena_.resize(reserved_pos_ + length);
+            return arena_.data() + reserved_pos_;
+        }
+
+        void commit(std::size_t count)
+        {
+            arena_.resize(reserved_pos_ + count);
+            staged(count);
+        }
+
+        // Records a reference to s, which must remain valid and unchanged 
+        // until the segments have been written
+        void append_external(const T* s, std::size_t length)
+        {
+            if (length > 0)
+            {
+                entries_.push_back(entry{s, 0, length});
+                size_ += length;
+            }
+        }
+    private:
+        void staged(std::size_t length)
+        {
+            if (length == 0)
+            {
+                return;
+            }
+            if (!entries_.empty() && entries_.back().data == nullptr)
+            {
+                entries_.back().length += length;
+            }
+            else
+            {
+                entries_.push_back(entry{nullptr, arena_.size() - length, length});
+            }
+            size_ += length;
+        }
     };
 
+    // gather_sink
+
+    // Writes to a gather_buffer. A gather_sink constructed from a buffer copies all output 
+    // into its arena, since the encoder it belongs to may be fed strings that don't outlive 
+    // the call that passes them (by a parser, or by ser_traits through a temporary basic_json). 
+    // The encode functions that dump a basic_json value into a gather_buffer use 
+    // detail::referencing_gather_sink, which references string and byte string values of at 
+    // least threshold characters or bytes instead of copying them.
+
+    template <class T>
+    class gather_sink
+    {
+    public:
+        using value_type = T;
+        using output_type = gather_buffer<T>;
+
+        static constexpr std::size_t default_threshold = 4096;
+    private:
+        output_type* buf_ptr_;
+        std::size_t threshold_;
+
+        // Noncopyable
+        gather_sink(const gather_sink&) = delete;
+        gather_sink& operator=(const gather_sink&) = delete;
+    public:
+    protected:
+        gather_sink(output_type& buf, std::size_t threshold)
+            : buf_ptr_(std::addressof(buf)), threshold_(threshold)
+        {
+        }
+    public:
+        gather_sink(gather_sink&&) = default;
+
+        gather_sink(output_type& buf)
+            : buf_ptr_(std::addressof(buf)), threshold_((std::numeric_limits<std::size_t>::max)())
+        {
+        }
+
+        gather_sink& operator=(gather_sink&&) = default;
+
+        // Values shorter than this are copied by append_external
+        std::size_t threshold() const
+        {
+            return threshold_;
+        }
+
+        void flush()
+        {
+        }
+
+        void append(const T* s, std::size_t length)
+        {
+            buf_ptr_->append(s, length);
+        }
+
+        void push_back(T ch)
+        {
+            buf_ptr_->push_back(ch);
+        }
+
+        T* reserve(std::size_t length)
+        {
+            return buf_ptr_->reserve(length);
+        }
+
+        void commit(std::size_t count)
+        {
+            buf_ptr_->commit(count);
+        }
+
+        void append_external(const T* s, std::size_t length)
+        {
+            if (length >= threshold_)
+            {
+                buf_ptr_->append_external(s, length);
+            }
+            else
+            {
+                buf_ptr_->append(s, length);
+            }
+        }
+    };
+
+namespace detail {
+
+    // A gather_sink that references values of at least threshold characters or bytes. Only for 
+    // encoding a basic_json value that the caller keeps unchanged until the segments 
+    // have been written, so that every string passed to append_external belongs to it.
+    template <class T>
+    class referencing_gather_sink : public gather_sink<T>
+    {
+    public:
+        referencing_gather_sink(gather_buffer<T>& buf, std::size_t threshold = gather_sink<T>::default_threshold)
+            : gather_sink<T>(buf, threshold)
+        {
+        }
+    };
+
+    // The sink for encoding a basic_json value with character type CharT into a gather_buffer 
+    // of bytes. The strings of a value with another character type than char reach the encoder 
+    // as converted temporaries, so they are copied.
+    template <class CharT>
+    using byte_gather_sink_t = typename std::conditional<std::is_same<CharT,char>::value,
+                                                         referencing_gather_sink<uint8_t>,
+                                                         gather_sink<uint8_t>>::type;
+
+    // Appends length chars or bytes to result, in one call if it has an append member
+    template <class Container, class T>
+    typename std::enable_if<has_append<Container,T>::value>::type
+    append_buffer(Container& result, const T* s, std::size_t length)
+    {
+        result.append(s, length);
+    }
+
+    template <class Container, class T>
+    typename std::enable_if<!has_append<Container,T>::value>::type
+    append_buffer(Container& result, const T* s, std::size_t length)
+    {
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            result.push_back(s[i]);
+        }
+    }
+
+    template<class Sink>
+    using
+    sink_append_external_t = decltype(std::declval<Sink>().append_external(std::declval<const typename Sink::value_type*>(), std::size_t()));
+
+    template<class Sink>
+    using
+    has_append_external = is_detected<sink_append_external_t, Sink>;
+
+    // Appends length values belonging to the value being encoded, which a sink with 
+    // an append_external member may reference rather than copy
+    template <class Sink>
+    typename std::enable_if<has_append_external<Sink>::value>::type
+    append_external(Sink& sink, const typename Sink::value_type* s, std::size_t length)
+    {
+        sink.append_external(s, length);
+    }
+
+    template <class Sink>
+    typename std::enable_if<!has_append_external<Sink>::value>::type
+    append_external(Sink& sink, const typename Sink::value_type* s, std::size_t length)
+    {
+        sink.append(s, length);
+    }
+
+    template<class Sink>
+    using
+    sink_threshold_t = decltype(std::declval<const Sink&>().threshold());
+
+    // The length below which a sink's append_external copies rather than references
+    template <class Sink>
+    typename std::enable_if<is_detected<sink_threshold_t, Sink>::value,std::size_t>::type
+    external_threshold(const Sink& sink)
+    {
+        return sink.threshold();
+    }
+
+    template <class Sink>
+    typename std::enable_if<!is_detected<sink_threshold_t, Sink>::value,std::size_t>::type
+    external_threshold(const Sink&)
+    {
+        return 0;
+    }
+
+    template<class Sink>
+    using
+    sink_commit_t = decltype(std::declval<Sink>().commit(std::size_t()));
+
+    template<class Sink>
+    using
+    has_reserve_commit = is_detected<sink_commit_t, Sink>;
+
+    // sink_reservation collects at most N characters without per character
+    // capacity checks, directly in the sink if it supports reserve and commit, 
+    // otherwise in a local buffer, and commit() adds them to the sink.
+
+    template <class Sink, std::size_t N, class Enable=void>
+    class sink_reservation
+    {
+    public:
+        using value_type = typename Sink::value_type;
+    private:
+        Sink& sink_;
+        value_type buffer_[N];
+        value_type* p_;
+    public:
+        explicit sink_reservation(Sink& sink)
+            : sink_(sink), p_(buffer_)
+        {
+        }
+
+        void push_back(value_type ch)
+        {
+            *p_++ = ch;
+        }
+
+        void append(const value_type* s, std::size_t length)
+        {
+            std::memcpy(p_, s, length*sizeof(value_type));
+            p_ += length;
+        }
+
+        std::size_t commit()
+        {
+            std::size_t count = p_ - buffer_;
+            append_buffer(sink_, buffer_, count);
+            return count;
+        }
+    };
+
+    template <class Sink, std::size_t N>
+    class sink_reservation<Sink,N,typename std::enable_if<has_reserve_commit<Sink>::value>::type>
+    {
+    public:
+        using value_type = typename Sink::value_type;
+    private:
+        Sink& sink_;
+        value_type* first_;
+        value_type* p_;
+    public:
+        explicit sink_reservation(Sink& sink)
+            : sink_(sink), first_(sink.reserve(N)), p_(first_)
+        {
+        }
+
+        void push_back(value_type ch)
+        {
+            *p_++ = ch;
+        }
+
+        void append(const value_type* s, std::size_t length)
+        {
+            std::memcpy(p_, s, length*sizeof(value_type));
+            p_ += length;
+        }
+
+        std::size_t commit()
+        {
+            std::size_t count = p_ - first_;
+            sink_.commit(count);
+            return count;
+        }
+    };
+
+} // namespace detail
+
 } // namespace jsoncons
 
 #endif
@@ -31,6 +31,13 @@ struct result_allocator_arg_t
 
 constexpr result_allocator_arg_t result_allocator_arg{};
 
+struct exact_size_arg_t
+{
+    explicit exact_size_arg_t() = default; 
+};
+
+constexpr exact_size_arg_t exact_size_arg{};
+
 struct half_arg_t
 {
     explicit half_arg_t() = default; 
@@ -59,6 +66,20 @@ struct byte_string_arg_t
 
 constexpr byte_string_arg_t byte_string_arg{};
 
+struct typed_array_arg_t
+{
+    explicit typed_array_arg_t() = default; 
+};
+
+constexpr typed_array_arg_t typed_array_arg{};
+
+struct lazy_number_arg_t
+{
+    explicit lazy_number_arg_t() = default; 
+};
+
+constexpr lazy_number_arg_t lazy_number_arg{};
+
 enum class semantic_tag : uint8_t 
 {
     none = 0,
@@ -48,6 +48,7 @@
 #include <iterator>
 #include <type_traits>
 #include <system_error>
+#include <jsoncons/detail/simd.hpp>
 
 namespace jsoncons { namespace unicons {
 
@@ -884,6 +885,22 @@ convert(InputIt first, InputIt last,
 
 // validate
 
+// Skips a valid prefix of a contiguous range by the vectorized validator, other iterators are not advanced
+template <class InputIt>
+typename std::enable_if<!std::is_pointer<InputIt>::value,InputIt>::type 
+skip_valid_utf8(InputIt first, InputIt) UNICONS_NOEXCEPT
+{
+    return first;
+}
+
+template <class InputIt>
+typename std::enable_if<std::is_pointer<InputIt>::value,InputIt>::type 
+skip_valid_utf8(InputIt first, InputIt last) UNICONS_NOEXCEPT
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(first);
+    return first + (jsoncons::detail::skip_valid_utf8(p, reinterpret_cast<const uint8_t*>(last)) - p);
+}
+
 template <class InputIt>
 typename std::enable_if<std::is_integral<typename std::iterator_traits<InputIt>::value_type>::value && sizeof(typename std::iterator_traits<InputIt>::value_type) == sizeof(uint8_t)
                                ,convert_result<InputIt>>::type 
@@ -892,6 +909,14 @@ validate(InputIt first, InputIt last) UNICONS_NOEXCEPT
     conv_errc  result = conv_errc();
     while (first != last) 
     {
+        if (jsoncons::detail::skips_multibyte_utf8 || static_cast<uint8_t>(*first) < 0x80)
+        {
+            first = skip_valid_utf8(first, last);
+            if (first == last)
+            {
+                break;
+            }
+        }
         std::size_t length = static_cast<std::size_t>(trailing_bytes_for_utf8[static_cast<uint8_t>(*first)]) + 1;
         if (length > (std::size_t)(last - first))
         {
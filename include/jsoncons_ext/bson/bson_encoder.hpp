@@ -38,11 +38,12 @@ private:
     {
         jsoncons::bson::detail::bson_container_type type_;
         std::size_t offset_;
+        std::size_t external_length_;
         std::size_t name_offset_;
         std::size_t index_;
 
-        stack_item(jsoncons::bson::detail::bson_container_type type, std::size_t offset)
-           : type_(type), offset_(offset), name_offset_(0), index_(0)
+        stack_item(jsoncons::bson::detail::bson_container_type type, std::size_t offset, std::size_t external_length)
+           : type_(type), offset_(offset), external_length_(external_length), name_offset_(0), index_(0)
         {
         }
 
@@ -51,6 +52,11 @@ private:
             return offset_;
         }
 
+        std::size_t external_length() const
+        {
+            return external_length_;
+        }
+
         std::size_t member_offset() const
         {
             return name_offset_;
@@ -78,8 +84,19 @@ private:
     const bson_encode_options options_;
     allocator_type alloc_;
 
+    // Strings and byte strings that a sink with append_external may reference
+    // rather than copy, to be written at offset in buffer_
+    struct external_bytes
+    {
+        std::size_t offset;
+        const uint8_t* data;
+        std::size_t length;
+    };
+
     std::vector<stack_item> stack_;
     std::vector<uint8_t> buffer_;
+    std::vector<external_bytes> external_;
+    std::size_t external_length_;
     int nesting_depth_;
 
     // Noncopyable and nonmoveable
@@ -100,6 +117,7 @@ public:
        : sink_(std::forward<Sink>(sink)),
          options_(options),
          alloc_(alloc), 
+         external_length_(0),
          nesting_depth_(0)
     {
     }
@@ -128,7 +146,7 @@ private:
         {
             before_value(jsoncons::bson::detail::bson_format::document_cd);
         }
-        stack_.emplace_back(jsoncons::bson::detail::bson_container_type::document, buffer_.size());
+        stack_.emplace_back(jsoncons::bson::detail::bson_container_type::document, buffer_.size(), external_length_);
         buffer_.insert(buffer_.end(), sizeof(int32_t), 0);
 
         return true;
@@ -141,16 +159,13 @@ private:
 
         buffer_.push_back(0x00);
 
-        std::size_t length = buffer_.size() - stack_.back().offset();
+        std::size_t length = buffer_.size() - stack_.back().offset() + (external_length_ - stack_.back().external_length());
         jsoncons::detail::native_to_little(static_cast<uint32_t>(length), buffer_.begin()+stack_.back().offset());
 
         stack_.pop_back();
         if (stack_.empty())
         {
-            for (auto c : buffer_)
-            {
-                sink_.push_back(c);
-            }
+            write_buffer();
         }
         return true;
     }
@@ -166,7 +181,7 @@ private:
         {
             before_value(jsoncons::bson::detail::bson_format::array_cd);
         }
-        stack_.emplace_back(jsoncons::bson::detail::bson_container_type::array, buffer_.size());
+        stack_.emplace_back(jsoncons::bson::detail::bson_container_type::array, buffer_.size(), external_length_);
         buffer_.insert(buffer_.end(), sizeof(int32_t), 0);
         return true;
     }
@@ -178,16 +193,13 @@ private:
 
         buffer_.push_back(0x00);
 
-        std::size_t length = buffer_.size() - stack_.back().offset();
+        std::size_t length = buffer_.size() - stack_.back().offset() + (external_length_ - stack_.back().external_length());
         jsoncons::detail::native_to_little(static_cast<uint32_t>(length), buffer_.begin()+stack_.back().offset());
 
         stack_.pop_back();
         if (stack_.empty())
         {
-            for (auto c : buffer_)
-            {
-                sink_.push_back(c);
-            }
+            write_buffer();
         }
         return true;
     }
@@ -231,20 +243,16 @@ private:
 
         std::size_t offset = buffer_.size();
         buffer_.insert(buffer_.end(), sizeof(int32_t), 0);
-        std::size_t string_offset = buffer_.size();
 
-        auto sink = unicons::validate(sv.begin(), sv.end());
+        auto sink = unicons::validate(sv.data(), sv.data() + sv.size());
         if (sink.ec != unicons::conv_errc())
         {
             ec = bson_errc::invalid_utf8_text_string;
             return false;
         }
-        for (auto c : sv)
-        {
-            buffer_.push_back(c);
-        }
+        append_value_bytes(reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
         buffer_.push_back(0x00);
-        std::size_t length = buffer_.size() - string_offset;
+        std::size_t length = sv.size() + 1;
         jsoncons::detail::native_to_little(static_cast<uint32_t>(length), buffer_.begin()+offset);
 
         return true;
@@ -259,13 +267,9 @@ private:
 
         std::size_t offset = buffer_.size();
         buffer_.insert(buffer_.end(), sizeof(int32_t), 0);
-        std::size_t string_offset = buffer_.size();
 
-        for (auto c : b)
-        {
-            buffer_.push_back(c);
-        }
-        std::size_t length = buffer_.size() - string_offset;
+        append_value_bytes(b.data(), b.size());
+        std::size_t length = b.size();
         jsoncons::detail::native_to_little(static_cast<uint32_t>(length), buffer_.begin()+offset);
 
         return true;
@@ -343,6 +347,43 @@ private:
         return true;
     }
 
+    void append_value_bytes(const uint8_t* data, std::size_t length)
+    {
+        append_value_bytes(data, length, std::integral_constant<bool,jsoncons::detail::has_append_external<Sink>::value>());
+    }
+
+    // The document is written when it ends, so values the sink would copy 
+    // are copied now, while they are still valid
+    void append_value_bytes(const uint8_t* data, std::size_t length, std::true_type)
+    {
+        if (length < jsoncons::detail::external_threshold(sink_))
+        {
+            buffer_.insert(buffer_.end(), data, data+length);
+        }
+        else
+        {
+            external_.push_back(external_bytes{buffer_.size(), data, length});
+            external_length_ += length;
+        }
+    }
+
+    void append_value_bytes(const uint8_t* data, std::size_t length, std::false_type)
+    {
+        buffer_.insert(buffer_.end(), data, data+length);
+    }
+
+    void write_buffer()
+    {
+        std::size_t pos = 0;
+        for (const auto& item : external_)
+        {
+            sink_.append(buffer_.data() + pos, item.offset - pos);
+            jsoncons::detail::append_external(sink_, item.data, item.length);
+            pos = item.offset;
+        }
+        sink_.append(buffer_.data() + pos, buffer_.size() - pos);
+    }
+
     void before_value(uint8_t code) 
     {
         if (stack_.back().is_object())
@@ -74,6 +74,38 @@ namespace bson {
         }
     }
   
+    // to gather buffer
+
+    template<class T>
+    typename std::enable_if<is_basic_json<T>::value,void>::type 
+    encode_bson(const T& j, 
+                gather_buffer<uint8_t>& buf, 
+                const bson_encode_options& options = bson_encode_options())
+    {
+        // The strings and byte strings of j outlive the segments, so long ones are referenced
+        using char_type = typename T::char_type;
+        using sink_type = jsoncons::detail::byte_gather_sink_t<char_type>;
+        basic_bson_encoder<sink_type> encoder(sink_type(buf), options);
+        auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
+        j.dump(adaptor);
+    }
+
+    template<class T>
+    typename std::enable_if<!is_basic_json<T>::value,void>::type 
+    encode_bson(const T& val, 
+                gather_buffer<uint8_t>& buf, 
+                const bson_encode_options& options = bson_encode_options())
+    {
+        // ser_traits may pass strings of temporaries, so all output is copied
+        basic_bson_encoder<gather_sink<uint8_t>> encoder(gather_sink<uint8_t>(buf), options);
+        std::error_code ec;
+        ser_traits<T,char>::serialize(val, encoder, json(), ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+    }
+
     // with temp_allocator_rag
 
     template<class T,class TempAllocator>
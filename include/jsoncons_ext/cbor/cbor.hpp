@@ -21,6 +21,7 @@
 #include <jsoncons_ext/cbor/cbor_encoder.hpp>
 #include <jsoncons_ext/cbor/encode_cbor.hpp>
 #include <jsoncons_ext/cbor/decode_cbor.hpp>
+#include <jsoncons_ext/cbor/cbor_view.hpp>
 
 #endif
 
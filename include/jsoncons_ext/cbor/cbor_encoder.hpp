@@ -335,7 +335,7 @@ private:
 
     void write_string(const string_view& sv)
     {
-        auto sink = unicons::validate(sv.begin(), sv.end());
+        auto sink = unicons::validate(sv.data(), sv.data() + sv.size());
         if (sink.ec != unicons::conv_errc())
         {
             JSONCONS_THROW(ser_error(cbor_errc::invalid_utf8_text_string));
@@ -401,10 +401,7 @@ private:
                                             std::back_inserter(sink_));
         }
 
-        for (auto c : sv)
-        {
-            sink_.push_back(c);
-        }
+        jsoncons::detail::append_external(sink_, reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
     }
 
     void write_bignum(const bignum& n)
@@ -458,10 +455,7 @@ private:
                                   std::back_inserter(sink_));
         }
 
-        for (auto c : data)
-        {
-            sink_.push_back(c);
-        }
+        sink_.append(data.data(), data.size());
     }
 
     bool write_decimal_value(const string_view_type& sv, const ser_context& context, std::error_code& ec)
@@ -890,8 +884,9 @@ private:
             auto it = bytestringref_map_.find(bs);
             if (it == bytestringref_map_.end())
             {
-                bytestringref_map_.emplace(std::make_pair(bs, next_stringref_++));
-                write_byte_string_value(bs);
+                bytestringref_map_.emplace(std::make_pair(std::move(bs), next_stringref_++));
+                write_byte_string_header(b.size());
+                jsoncons::detail::append_external(sink_, b.data(), b.size());
             }
             else
             {
@@ -901,54 +896,56 @@ private:
         }
         else
         {
-            write_byte_string_value(b);
+            write_byte_string_header(b.size());
+            jsoncons::detail::append_external(sink_, b.data(), b.size());
         }
 
         end_value();
         return true;
     }
 
-    void write_byte_string_value(const byte_string_view& b) 
+    void write_byte_string_header(std::size_t length) 
     {
-        if (b.size() <= 0x17)
+        if (length <= 0x17)
         {
             // fixstr stores a byte array whose length is upto 31 bytes
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x40 + b.size()), 
+            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x40 + length), 
                                             std::back_inserter(sink_));
         }
-        else if (b.size() <= 0xff)
+        else if (length <= 0xff)
         {
             jsoncons::detail::native_to_big(static_cast<uint8_t>(0x58), 
                                             std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(b.size()), 
+            jsoncons::detail::native_to_big(static_cast<uint8_t>(length), 
                                             std::back_inserter(sink_));
         }
-        else if (b.size() <= 0xffff)
+        else if (length <= 0xffff)
         {
             jsoncons::detail::native_to_big(static_cast<uint8_t>(0x59), 
                                             std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint16_t>(b.size()), 
+            jsoncons::detail::native_to_big(static_cast<uint16_t>(length), 
                                             std::back_inserter(sink_));
         }
-        else if (b.size() <= 0xffffffff)
+        else if (length <= 0xffffffff)
         {
             jsoncons::detail::native_to_big(static_cast<uint8_t>(0x5a), 
                                             std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint32_t>(b.size()), 
+            jsoncons::detail::native_to_big(static_cast<uint32_t>(length), 
                                             std::back_inserter(sink_));
         }
-        else // if (b.size() <= 0xffffffffffffffff)
+        else // if (length <= 0xffffffffffffffff)
         {
             jsoncons::detail::native_to_big(static_cast<uint8_t>(0x5b), 
                                             std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint64_t>(b.size()), 
+            jsoncons::detail::native_to_big(static_cast<uint64_t>(length), 
                                             std::back_inserter(sink_));
         }
+    }
 
-        for (auto c : b)
-        {
-            sink_.push_back(c);
-        }
+    void write_byte_string_value(const byte_string_view& b) 
+    {
+        write_byte_string_header(b.size());
+        sink_.append(b.data(), b.size());
     }
 
     bool visit_double(double val, 
@@ -27,7 +27,8 @@ enum class cbor_errc
     stringref_too_large,
     max_nesting_depth_exceeded,
     unknown_type,
-    illegal_chunked_string
+    illegal_chunked_string,
+    max_buffered_bytes_exceeded
 };
 
 class cbor_error_category_impl
@@ -66,6 +67,8 @@ public:
                 return "An unknown type was found in the stream";
             case cbor_errc::illegal_chunked_string:
                 return "An illegal type was found while parsing an indefinite length string";
+            case cbor_errc::max_buffered_bytes_exceeded:
+                return "Partial data item exceeds buffer limit in options";
             default:
                 return "Unknown CBOR parser error";
         }
@@ -44,9 +44,17 @@ public:
 class cbor_decode_options : public virtual cbor_options_common
 {
     friend class cbor_options;
+
+    std::size_t max_buffered_bytes_;
 public:
     cbor_decode_options()
+        : max_buffered_bytes_(1024*1024)
+    {
+    }
+
+    std::size_t max_buffered_bytes() const 
     {
+        return max_buffered_bytes_;
     }
 };
 
@@ -78,6 +86,7 @@ class cbor_options final : public cbor_decode_options, public cbor_encode_option
 {
 public:
     using cbor_options_common::max_nesting_depth;
+    using cbor_decode_options::max_buffered_bytes;
     using cbor_encode_options::pack_strings;
     using cbor_encode_options::use_typed_arrays;
 
@@ -87,6 +96,12 @@ public:
         return *this;
     }
 
+    cbor_options& max_buffered_bytes(std::size_t value)
+    {
+        this->max_buffered_bytes_ = value;
+        return *this;
+    }
+
     cbor_options& pack_strings(bool value)
     {
         this->use_stringref_ = value;
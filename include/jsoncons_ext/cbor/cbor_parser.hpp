@@ -184,11 +184,27 @@ public:
         done_ = false;
     }
 
+    template <class Source>
+    void reset(Source&& source)
+    {
+        source_ = Src(std::forward<Source>(source));
+        other_tags_.reset();
+        stringref_map_stack_.clear();
+        nesting_depth_ = 0;
+        reset();
+    }
+
     bool done() const
     {
         return done_;
     }
 
+    // The root item has been read but not yet flushed
+    bool before_done() const
+    {
+        return state_stack_.size() == 1 && state_stack_.back().mode == parse_mode::before_done;
+    }
+
     bool stopped() const
     {
         return !more_;
@@ -441,7 +457,7 @@ private:
                 {
                     return;
                 }
-                auto result = unicons::validate(text_buffer_.begin(),text_buffer_.end());
+                auto result = unicons::validate(text_buffer_.data(), text_buffer_.data() + text_buffer_.size());
                 if (result.ec != unicons::conv_errc())
                 {
                     ec = cbor_errc::invalid_utf8_text_string;
@@ -0,0 +1,406 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_CBOR_PUSH_READER_HPP
+#define JSONCONS_CBOR_CBOR_PUSH_READER_HPP
+
+#include <memory> // std::allocator
+#include <vector>
+#include <limits> // std::numeric_limits
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_visitor2.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons_ext/cbor/cbor_error.hpp>
+#include <jsoncons_ext/cbor/cbor_options.hpp>
+#include <jsoncons_ext/cbor/cbor_parser.hpp>
+
+namespace jsoncons { namespace cbor {
+
+namespace detail {
+
+    // Finds the end of a complete CBOR data item in input that arrives in chunks,
+    // keeping only the number of items left to read in each enclosing container
+
+    class cbor_item_scanner
+    {
+        enum class scan_state {head, argument, payload};
+
+        static constexpr uint64_t indefinite_length = (std::numeric_limits<uint64_t>::max)();
+
+        scan_state state_;
+        uint8_t major_type_;
+        uint64_t value_;
+        std::size_t argument_length_;
+        uint64_t payload_length_;
+        std::vector<uint64_t> stack_;
+        int max_nesting_depth_;
+        bool partial_;
+    public:
+        cbor_item_scanner(int max_nesting_depth)
+            : state_(scan_state::head), major_type_(0), value_(0), argument_length_(0),
+              payload_length_(0), max_nesting_depth_(max_nesting_depth), partial_(false)
+        {
+        }
+
+        // True if part of an item has been scanned
+        bool partial() const
+        {
+            return partial_;
+        }
+
+        void reset()
+        {
+            state_ = scan_state::head;
+            stack_.clear();
+            partial_ = false;
+        }
+
+        // Scans up to the end of the current item and returns the number of bytes scanned,
+        // setting complete if the item ended there
+        std::size_t scan(const uint8_t* data, std::size_t length, bool& complete, std::error_code& ec)
+        {
+            complete = false;
+            const uint8_t* p = data;
+            const uint8_t* last = data + length;
+            while (p != last && !complete && !ec)
+            {
+                switch (state_)
+                {
+                    case scan_state::head:
+                    {
+                        uint8_t b = *p++;
+                        major_type_ = b >> 5;
+                        uint8_t info = b & 0x1f;
+                        if (info < 24)
+                        {
+                            value_ = info;
+                            complete = end_head(ec);
+                        }
+                        else if (info <= 27)
+                        {
+                            value_ = 0;
+                            argument_length_ = std::size_t(1) << (info - 24);
+                            state_ = scan_state::argument;
+                        }
+                        else if (info == 31)
+                        {
+                            complete = indefinite_head(ec);
+                        }
+                        else
+                        {
+                            ec = cbor_errc::unknown_type;
+                        }
+                        break;
+                    }
+                    case scan_state::argument:
+                        value_ = (value_ << 8) | *p++;
+                        if (--argument_length_ == 0)
+                        {
+                            state_ = scan_state::head;
+                            complete = end_head(ec);
+                        }
+                        break;
+                    case scan_state::payload:
+                    {
+                        std::size_t n = static_cast<std::size_t>((std::min)(payload_length_, static_cast<uint64_t>(last - p)));
+                        p += n;
+                        payload_length_ -= n;
+                        if (payload_length_ == 0)
+                        {
+                            state_ = scan_state::head;
+                            complete = end_item();
+                        }
+                        break;
+                    }
+                }
+            }
+            if (complete)
+            {
+                partial_ = false;
+            }
+            else if (p != data)
+            {
+                partial_ = true;
+            }
+            return p - data;
+        }
+    private:
+        bool end_head(std::error_code& ec)
+        {
+            switch (major_type_)
+            {
+                case 2: // byte string
+                case 3: // text string
+                    if (value_ == 0)
+                    {
+                        return end_item();
+                    }
+                    payload_length_ = value_;
+                    state_ = scan_state::payload;
+                    return false;
+                case 4: // array
+                    return value_ == 0 ? end_item() : begin_container(value_, ec);
+                case 5: // map
+                    if (value_ > indefinite_length/2 - 1)
+                    {
+                        ec = cbor_errc::number_too_large;
+                        return false;
+                    }
+                    return value_ == 0 ? end_item() : begin_container(2*value_, ec);
+                case 6: // tag, followed by the tagged item
+                    return false;
+                default:
+                    return end_item();
+            }
+        }
+
+        bool indefinite_head(std::error_code& ec)
+        {
+            switch (major_type_)
+            {
+                case 2:
+                case 3:
+                case 4:
+                case 5:
+                    return begin_container(indefinite_length, ec);
+                case 7: // break
+                    if (stack_.empty() || stack_.back() != indefinite_length)
+                    {
+                        ec = cbor_errc::unknown_type;
+                        return false;
+                    }
+                    stack_.pop_back();
+                    return end_item();
+                default:
+                    ec = cbor_errc::unknown_type;
+                    return false;
+            }
+        }
+
+        bool begin_container(uint64_t count, std::error_code& ec)
+        {
+            if (JSONCONS_UNLIKELY(static_cast<int>(stack_.size()) >= max_nesting_depth_))
+            {
+                ec = cbor_errc::max_nesting_depth_exceeded;
+                return false;
+            }
+            stack_.push_back(count);
+            return false;
+        }
+
+        bool end_item()
+        {
+            while (!stack_.empty())
+            {
+                if (stack_.back() == indefinite_length || --stack_.back() > 0)
+                {
+                    return false;
+                }
+                stack_.pop_back();
+            }
+            return true;
+        }
+    };
+
+} // namespace detail
+
+// basic_cbor_push_reader
+
+// Parses a sequence of CBOR data items fed in chunks as they arrive. Each item is passed
+// to the parser once it is complete, directly from the fed chunk if it lies within it,
+// otherwise from a buffer holding the partial item, so the caller's buffer may be
+// reused as soon as feed returns.
+// That buffer, bounded by the max_buffered_bytes option, is the memory a reader holds for input.
+
+template <class Allocator=std::allocator<char>>
+class basic_cbor_push_reader : public ser_context
+{
+    using char_type = char;
+    using byte_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<uint8_t>;
+
+    static constexpr std::size_t max_retained_capacity = 16384;
+
+    basic_cbor_parser<jsoncons::bytes_source,Allocator> parser_;
+    basic_json_visitor2_to_visitor_adaptor<char_type,Allocator> adaptor_;
+    json_visitor2& visitor_;
+    detail::cbor_item_scanner scanner_;
+    std::vector<uint8_t,byte_allocator_type> buffer_;
+    std::size_t max_buffered_bytes_;
+    bool stopped_;
+
+    // Noncopyable and nonmoveable
+    basic_cbor_push_reader(const basic_cbor_push_reader&) = delete;
+    basic_cbor_push_reader& operator=(const basic_cbor_push_reader&) = delete;
+public:
+    basic_cbor_push_reader(json_visitor& visitor,
+                           const Allocator alloc)
+       : basic_cbor_push_reader(visitor, cbor_decode_options(), alloc)
+    {
+    }
+
+    basic_cbor_push_reader(json_visitor& visitor,
+                           const cbor_decode_options& options = cbor_decode_options(),
+                           const Allocator alloc=Allocator())
+       : parser_(jsoncons::bytes_source(), options, alloc),
+         adaptor_(visitor, alloc), visitor_(adaptor_),
+         scanner_(options.max_nesting_depth()),
+         buffer_(alloc),
+         max_buffered_bytes_(options.max_buffered_bytes()),
+         stopped_(false)
+    {
+    }
+
+    basic_cbor_push_reader(json_visitor2& visitor,
+                           const Allocator alloc)
+       : basic_cbor_push_reader(visitor, cbor_decode_options(), alloc)
+    {
+    }
+
+    basic_cbor_push_reader(json_visitor2& visitor,
+                           const cbor_decode_options& options = cbor_decode_options(),
+                           const Allocator alloc=Allocator())
+       : parser_(jsoncons::bytes_source(), options, alloc),
+         visitor_(visitor),
+         scanner_(options.max_nesting_depth()),
+         buffer_(alloc),
+         max_buffered_bytes_(options.max_buffered_bytes()),
+         stopped_(false)
+    {
+    }
+
+    void feed(const uint8_t* data, std::size_t length)
+    {
+        std::error_code ec;
+        feed(data, length, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line(),column()));
+        }
+    }
+
+    void feed(const uint8_t* data, std::size_t length, std::error_code& ec)
+    {
+        while (length > 0 && !stopped_)
+        {
+            bool complete;
+            std::size_t n = scanner_.scan(data, length, complete, ec);
+            if (ec)
+            {
+                stopped_ = true;
+                return;
+            }
+            if (!complete)
+            {
+                if (!check_buffer_limit(length, ec))
+                {
+                    return;
+                }
+                buffer_.insert(buffer_.end(), data, data + length);
+                return;
+            }
+            if (buffer_.empty())
+            {
+                parse_item(data, n, ec);
+            }
+            else
+            {
+                if (!check_buffer_limit(n, ec))
+                {
+                    return;
+                }
+                buffer_.insert(buffer_.end(), data, data + n);
+                parse_item(buffer_.data(), buffer_.size(), ec);
+                buffer_.clear();
+                if (buffer_.capacity() > max_retained_capacity)
+                {
+                    buffer_.shrink_to_fit();
+                }
+            }
+            data += n;
+            length -= n;
+        }
+    }
+
+    void finish()
+    {
+        std::error_code ec;
+        finish(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line(),column()));
+        }
+    }
+
+    // Signals the end of input, reporting unexpected_eof inside an item
+    void finish(std::error_code& ec)
+    {
+        if (!stopped_ && scanner_.partial())
+        {
+            ec = cbor_errc::unexpected_eof;
+            stopped_ = true;
+        }
+    }
+
+    // Parsing has stopped, because of an error or because the visitor returned false
+    bool stopped() const
+    {
+        return stopped_;
+    }
+
+    void reset()
+    {
+        scanner_.reset();
+        buffer_.clear();
+        stopped_ = false;
+    }
+
+    std::size_t line() const override
+    {
+        return parser_.line();
+    }
+
+    std::size_t column() const override
+    {
+        return parser_.column();
+    }
+private:
+    // A partial root item is buffered whole, up to max_buffered_bytes
+    bool check_buffer_limit(std::size_t length, std::error_code& ec)
+    {
+        if (length > max_buffered_bytes_ - buffer_.size())
+        {
+            ec = cbor_errc::max_buffered_bytes_exceeded;
+            stopped_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    void parse_item(const uint8_t* data, std::size_t length, std::error_code& ec)
+    {
+        parser_.reset(byte_string_view(data, length));
+        parser_.parse(visitor_, ec);
+        // A visitor returning false at the end of the root item (as json_decoder does)
+        // completes that item rather than stopping
+        if (!ec && parser_.before_done())
+        {
+            parser_.restart();
+            parser_.parse(visitor_, ec);
+        }
+        if (ec || !parser_.done())
+        {
+            stopped_ = true;
+        }
+    }
+};
+
+using cbor_push_reader = basic_cbor_push_reader<std::allocator<char>>;
+
+}}
+
+#endif
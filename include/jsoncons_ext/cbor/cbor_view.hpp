@@ -0,0 +1,1323 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_CBOR_VIEW_HPP
+#define JSONCONS_CBOR_CBOR_VIEW_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <iterator> // std::forward_iterator_tag
+#include <limits> // std::numeric_limits
+#include <cstring> // std::memcpy, std::memcmp
+#include <type_traits> // std::enable_if
+#include <jsoncons/json.hpp>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons_ext/cbor/cbor_detail.hpp>
+#include <jsoncons_ext/cbor/cbor_error.hpp>
+#include <jsoncons_ext/cbor/cbor_reader.hpp>
+
+namespace jsoncons { namespace cbor {
+
+class cbor_view;
+
+class cbor_view_member;
+
+// cbor_view is a read-only handle to a data item inside a buffer of CBOR encoded bytes.
+// Navigation skips over length-prefixed items without decoding them, so looking up one
+// field of a large item only touches the bytes in front of it. The view does not own
+// the buffer, it is valid as long as the bytes are.
+
+class cbor_view
+{
+    static constexpr std::size_t npos = (std::numeric_limits<std::size_t>::max)();
+    static constexpr int max_nesting_depth = 1024;
+
+    struct item_head
+    {
+        jsoncons::cbor::detail::cbor_major_type major_type;
+        uint8_t info;
+        uint64_t value;
+        std::size_t next;
+    };
+
+    // Offsets of the strings that a stringref namespace assigns indexes to, collected on first use
+    // and shared by all views into that namespace.
+    struct stringref_table
+    {
+        bool built;
+        std::vector<std::size_t> offsets;
+
+        stringref_table()
+            : built(false)
+        {
+        }
+    };
+
+    struct item_content
+    {
+        std::size_t pos;
+        item_head head;
+        bool has_tag;
+        uint64_t tag;
+        std::size_t ns;
+        std::shared_ptr<stringref_table> refs;
+    };
+
+    const uint8_t* data_;
+    std::size_t length_;
+    std::size_t pos_;
+    std::size_t ns_;
+    std::shared_ptr<stringref_table> refs_;
+    bool indexed_;
+    mutable std::shared_ptr<std::vector<std::size_t>> index_;
+    // The table of a namespace that this data item itself opens, kept so that repeated
+    // lookups on the view don't rescan the namespace
+    mutable std::size_t own_ns_;
+    mutable std::shared_ptr<stringref_table> own_refs_;
+
+    cbor_view(const uint8_t* data, std::size_t length, std::size_t pos, std::size_t ns,
+              const std::shared_ptr<stringref_table>& refs, bool indexed)
+        : data_(data), length_(length), pos_(pos), ns_(ns), refs_(refs), indexed_(indexed), own_ns_(npos)
+    {
+    }
+public:
+    class array_iterator;
+    class object_iterator;
+
+    using array_range_type = range<array_iterator>;
+    using object_range_type = range<object_iterator>;
+
+    cbor_view()
+        : data_(nullptr), length_(0), pos_(0), ns_(npos), indexed_(false), own_ns_(npos)
+    {
+    }
+
+    // If index_containers is true, each container view builds an index of its element
+    // offsets on the first positional or key lookup, so repeated lookups don't rescan.
+    // The index, like the string table of a stringref namespace, is built on demand from
+    // const member functions, so a view (and its copies) should not be shared between threads
+    // without synchronization.
+    cbor_view(const uint8_t* data, std::size_t length, bool index_containers = false)
+        : data_(data), length_(length), pos_(0), ns_(npos), indexed_(index_containers), own_ns_(npos)
+    {
+    }
+
+    cbor_view(const byte_string_view& bytes, bool index_containers = false)
+        : data_(bytes.data()), length_(bytes.size()), pos_(0), ns_(npos), indexed_(index_containers), own_ns_(npos)
+    {
+    }
+
+    template <class Container>
+    cbor_view(const Container& bytes, bool index_containers = false,
+              typename std::enable_if<jsoncons::detail::is_byte_sequence<Container>::value,int>::type = 0)
+        : data_(reinterpret_cast<const uint8_t*>(bytes.data())), length_(bytes.size()), pos_(0), ns_(npos), indexed_(index_containers), own_ns_(npos)
+    {
+    }
+
+    // Offset of this data item in the buffer
+    std::size_t offset() const
+    {
+        return pos_;
+    }
+
+    json_type type() const
+    {
+        item_content c = content();
+        switch (c.head.major_type)
+        {
+            case jsoncons::cbor::detail::cbor_major_type::unsigned_integer:
+                return json_type::uint64_value;
+            case jsoncons::cbor::detail::cbor_major_type::negative_integer:
+                return json_type::int64_value;
+            case jsoncons::cbor::detail::cbor_major_type::byte_string:
+                return c.has_tag && (c.tag == 2 || c.tag == 3) ? json_type::string_value : json_type::byte_string_value;
+            case jsoncons::cbor::detail::cbor_major_type::text_string:
+                return json_type::string_value;
+            case jsoncons::cbor::detail::cbor_major_type::array:
+                return c.has_tag && (c.tag == 4 || c.tag == 5) ? json_type::string_value : json_type::array_value;
+            case jsoncons::cbor::detail::cbor_major_type::map:
+                return json_type::object_value;
+            default:
+                switch (c.head.info)
+                {
+                    case 0x14:
+                    case 0x15:
+                        return json_type::bool_value;
+                    case 0x16:
+                    case 0x17:
+                        return json_type::null_value;
+                    case 0x19:
+                        return json_type::half_value;
+                    case 0x1a:
+                    case 0x1b:
+                        return json_type::double_value;
+                    default:
+                        JSONCONS_THROW(ser_error(cbor_errc::unknown_type));
+                }
+        }
+    }
+
+    semantic_tag tag() const
+    {
+        item_content c = content();
+        if (c.head.major_type == jsoncons::cbor::detail::cbor_major_type::simple && c.head.info == 0x17)
+        {
+            return semantic_tag::undefined;
+        }
+        if (!c.has_tag)
+        {
+            return semantic_tag::none;
+        }
+        switch (c.tag)
+        {
+            case 0:
+                return c.head.major_type == jsoncons::cbor::detail::cbor_major_type::text_string ? semantic_tag::datetime : semantic_tag::none;
+            case 1:
+                return semantic_tag::timestamp;
+            case 2:
+            case 3:
+                return c.head.major_type == jsoncons::cbor::detail::cbor_major_type::byte_string ? semantic_tag::bigint : semantic_tag::none;
+            case 4:
+                return semantic_tag::bigdec;
+            case 5:
+                return semantic_tag::bigfloat;
+            case 21:
+                return semantic_tag::base64url;
+            case 22:
+                return semantic_tag::base64;
+            case 23:
+                return semantic_tag::base16;
+            case 32:
+                return semantic_tag::uri;
+            case 33:
+                return semantic_tag::base64url;
+            case 34:
+                return semantic_tag::base64;
+            default:
+                return semantic_tag::none;
+        }
+    }
+
+    bool is_null() const
+    {
+        return type() == json_type::null_value;
+    }
+
+    bool is_bool() const
+    {
+        return type() == json_type::bool_value;
+    }
+
+    bool is_int64() const
+    {
+        return type() == json_type::int64_value;
+    }
+
+    bool is_uint64() const
+    {
+        return type() == json_type::uint64_value;
+    }
+
+    bool is_double() const
+    {
+        json_type t = type();
+        return t == json_type::double_value || t == json_type::half_value;
+    }
+
+    bool is_number() const
+    {
+        switch (type())
+        {
+            case json_type::int64_value:
+            case json_type::uint64_value:
+            case json_type::half_value:
+            case json_type::double_value:
+                return true;
+            case json_type::string_value:
+            {
+                semantic_tag t = tag();
+                return t == semantic_tag::bigint || t == semantic_tag::bigdec;
+            }
+            default:
+                return false;
+        }
+    }
+
+    bool is_string() const
+    {
+        return type() == json_type::string_value;
+    }
+
+    bool is_byte_string() const
+    {
+        return type() == json_type::byte_string_value;
+    }
+
+    bool is_array() const
+    {
+        return type() == json_type::array_value;
+    }
+
+    bool is_object() const
+    {
+        return type() == json_type::object_value;
+    }
+
+    // Number of elements of an array, number of members of a map, otherwise 0
+    std::size_t size() const
+    {
+        item_content c = content();
+        if (!is_container(c))
+        {
+            return 0;
+        }
+        if (c.head.info != jsoncons::cbor::detail::additional_info::indefinite_length)
+        {
+            return checked_size(c.head.value);
+        }
+        if (indexed_)
+        {
+            const std::vector<std::size_t>& index = get_index(c);
+            return c.head.major_type == jsoncons::cbor::detail::cbor_major_type::map ? index.size()/2 : index.size();
+        }
+        std::error_code ec;
+        std::size_t n = 0;
+        std::size_t p = c.head.next;
+        while (!is_break(p))
+        {
+            p = skip(p, nullptr, 0, ec);
+            if (!ec && c.head.major_type == jsoncons::cbor::detail::cbor_major_type::map)
+            {
+                p = skip(p, nullptr, 0, ec);
+            }
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+            ++n;
+        }
+        return n;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    cbor_view at(std::size_t i) const
+    {
+        item_content c = content();
+        if (!is_container(c) || c.head.major_type != jsoncons::cbor::detail::cbor_major_type::array)
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
+        }
+        if (indexed_)
+        {
+            const std::vector<std::size_t>& index = get_index(c);
+            if (i >= index.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return child(c, index[i]);
+        }
+        std::error_code ec;
+        std::size_t p = c.head.next;
+        std::size_t count = c.head.info == jsoncons::cbor::detail::additional_info::indefinite_length ? npos : checked_size(c.head.value);
+        if (count != npos && i >= count)
+        {
+            JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+        }
+        for (std::size_t j = 0; j < i; ++j)
+        {
+            if (count == npos && is_break(p))
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            p = skip(p, nullptr, 0, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+        if (count == npos && is_break(p))
+        {
+            JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+        }
+        return child(c, p);
+    }
+
+    cbor_view operator[](std::size_t i) const
+    {
+        return at(i);
+    }
+
+    cbor_view at(const string_view& name) const
+    {
+        item_content c = content();
+        std::size_t p = find_member(c, name);
+        if (p == npos)
+        {
+            JSONCONS_THROW(key_not_found(name.data(),name.length()));
+        }
+        return child(c, value_offset(c, p));
+    }
+
+    cbor_view operator[](const string_view& name) const
+    {
+        return at(name);
+    }
+
+    bool contains(const string_view& name) const
+    {
+        item_content c = content();
+        return c.head.major_type == jsoncons::cbor::detail::cbor_major_type::map && find_member(c, name) != npos;
+    }
+
+    object_iterator find(const string_view& name) const;
+
+    array_range_type array_range() const;
+
+    object_range_type object_range() const;
+
+    // Compares a text string with name, without copying chunks of indefinite length strings
+    bool equals(const string_view& name) const
+    {
+        item_content c = content();
+        if (c.head.major_type != jsoncons::cbor::detail::cbor_major_type::text_string)
+        {
+            return false;
+        }
+        return string_equals(c, name);
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_same<T,bool>::value,T>::type
+    as() const
+    {
+        item_content c = content();
+        if (c.head.major_type == jsoncons::cbor::detail::cbor_major_type::simple && (c.head.info == 0x14 || c.head.info == 0x15))
+        {
+            return c.head.info == 0x15;
+        }
+        return as<json>().template as<T>();
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T,bool>::value,T>::type
+    as() const
+    {
+        item_content c = content();
+        switch (c.head.major_type)
+        {
+            case jsoncons::cbor::detail::cbor_major_type::unsigned_integer:
+                return static_cast<T>(c.head.value);
+            case jsoncons::cbor::detail::cbor_major_type::negative_integer:
+                if (c.head.value > static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()))
+                {
+                    JSONCONS_THROW(ser_error(cbor_errc::number_too_large));
+                }
+                return static_cast<T>(static_cast<int64_t>(-1) - static_cast<int64_t>(c.head.value));
+            default:
+                return as<json>().template as<T>();
+        }
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_floating_point<T>::value,T>::type
+    as() const
+    {
+        item_content c = content();
+        switch (c.head.major_type)
+        {
+            case jsoncons::cbor::detail::cbor_major_type::unsigned_integer:
+                return static_cast<T>(c.head.value);
+            case jsoncons::cbor::detail::cbor_major_type::negative_integer:
+                return static_cast<T>(-1) - static_cast<T>(c.head.value);
+            case jsoncons::cbor::detail::cbor_major_type::simple:
+                switch (c.head.info)
+                {
+                    case 0x19:
+                        return static_cast<T>(jsoncons::detail::decode_half(static_cast<uint16_t>(c.head.value)));
+                    case 0x1a:
+                    {
+                        uint32_t bits = static_cast<uint32_t>(c.head.value);
+                        float val;
+                        std::memcpy(&val, &bits, sizeof(val));
+                        return static_cast<T>(val);
+                    }
+                    case 0x1b:
+                    {
+                        uint64_t bits = c.head.value;
+                        double val;
+                        std::memcpy(&val, &bits, sizeof(val));
+                        return static_cast<T>(val);
+                    }
+                    default:
+                        break;
+                }
+                break;
+            default:
+                break;
+        }
+        return as<json>().template as<T>();
+    }
+
+    // Only available for definite length text strings, which are contiguous in the buffer
+    template <class T>
+    typename std::enable_if<std::is_same<T,string_view>::value,T>::type
+    as() const
+    {
+        item_content c = content();
+        if (c.head.major_type != jsoncons::cbor::detail::cbor_major_type::text_string ||
+            c.head.info == jsoncons::cbor::detail::additional_info::indefinite_length)
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a definite length text string"));
+        }
+        return string_view(reinterpret_cast<const char*>(data_ + c.head.next), checked_size(c.head.value));
+    }
+
+    // Only available for definite length byte strings, which are contiguous in the buffer
+    template <class T>
+    typename std::enable_if<std::is_same<T,byte_string_view>::value,T>::type
+    as() const
+    {
+        item_content c = content();
+        if (c.head.major_type != jsoncons::cbor::detail::cbor_major_type::byte_string ||
+            c.head.info == jsoncons::cbor::detail::additional_info::indefinite_length)
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a definite length byte string"));
+        }
+        return byte_string_view(data_ + c.head.next, checked_size(c.head.value));
+    }
+
+    template <class T>
+    typename std::enable_if<jsoncons::detail::is_basic_string<T>::value && std::is_same<typename T::value_type,char>::value,T>::type
+    as() const
+    {
+        item_content c = content();
+        if (c.head.major_type != jsoncons::cbor::detail::cbor_major_type::text_string || c.has_tag)
+        {
+            return as<json>().template as<T>();
+        }
+        T s;
+        append_chunks(c, s);
+        return s;
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_same<T,std::vector<uint8_t>>::value,T>::type
+    as() const
+    {
+        item_content c = content();
+        if (c.head.major_type != jsoncons::cbor::detail::cbor_major_type::byte_string || c.has_tag)
+        {
+            return as<json>().template as<T>();
+        }
+        T v;
+        append_chunks(c, v);
+        return v;
+    }
+
+    // Decodes the data item into a basic_json
+    template <class T>
+    typename std::enable_if<is_basic_json<T>::value,T>::type
+    as() const
+    {
+        json_decoder<T> decoder;
+        dump(decoder);
+        if (!decoder.is_valid())
+        {
+            JSONCONS_THROW(ser_error(cbor_errc::unexpected_eof));
+        }
+        return decoder.get_result();
+    }
+
+    // Any other type goes through json_type_traits
+    template <class T>
+    typename std::enable_if<!is_basic_json<T>::value && !std::is_arithmetic<T>::value &&
+                            !std::is_same<T,string_view>::value && !std::is_same<T,byte_string_view>::value &&
+                            !jsoncons::detail::is_basic_string<T>::value && !std::is_same<T,std::vector<uint8_t>>::value,T>::type
+    as() const
+    {
+        return as<json>().template as<T>();
+    }
+
+    // Sends the data item to a visitor. Items inside a stringref namespace have their
+    // stringrefs replaced by the referenced strings before they are parsed.
+    void dump(json_visitor& visitor) const
+    {
+        std::error_code ec;
+        dump(visitor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+    }
+
+    void dump(json_visitor& visitor, std::error_code& ec) const
+    {
+        if (ns_ == npos)
+        {
+            std::size_t end = skip(pos_, nullptr, 0, ec);
+            if (ec)
+            {
+                return;
+            }
+            cbor_bytes_reader reader(byte_string_view(data_ + pos_, end - pos_), visitor);
+            reader.read(ec);
+        }
+        else
+        {
+            const std::vector<std::size_t>& table = get_stringrefs(ns_, refs_, ec);
+            if (ec)
+            {
+                return;
+            }
+            std::vector<uint8_t> buffer;
+            copy_item(pos_, table, buffer, 0, ec);
+            if (ec)
+            {
+                return;
+            }
+            cbor_bytes_reader reader(buffer, visitor);
+            reader.read(ec);
+        }
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const cbor_view& v)
+    {
+        json_compressed_stream_encoder encoder(os);
+        v.dump(encoder);
+        return os;
+    }
+private:
+    friend class array_iterator;
+    friend class object_iterator;
+
+    static bool is_container(const item_content& c)
+    {
+        return (c.head.major_type == jsoncons::cbor::detail::cbor_major_type::array && !(c.has_tag && (c.tag == 4 || c.tag == 5))) ||
+               c.head.major_type == jsoncons::cbor::detail::cbor_major_type::map;
+    }
+
+    static std::size_t checked_size(uint64_t value)
+    {
+        std::size_t n = static_cast<std::size_t>(value);
+        if (n != value)
+        {
+            JSONCONS_THROW(ser_error(cbor_errc::number_too_large));
+        }
+        return n;
+    }
+
+    cbor_view child(const item_content& c, std::size_t pos) const
+    {
+        return cbor_view(data_, length_, pos, c.ns, c.refs, indexed_);
+    }
+
+    bool is_break(std::size_t p) const
+    {
+        if (p >= length_)
+        {
+            JSONCONS_THROW(ser_error(cbor_errc::unexpected_eof));
+        }
+        return data_[p] == 0xff;
+    }
+
+    item_head read_head(std::size_t p, std::error_code& ec) const
+    {
+        item_head h{jsoncons::cbor::detail::cbor_major_type::simple,0,0,p};
+        if (p >= length_)
+        {
+            ec = cbor_errc::unexpected_eof;
+            return h;
+        }
+        h.major_type = static_cast<jsoncons::cbor::detail::cbor_major_type>(data_[p] >> 5);
+        h.info = data_[p] & 0x1f;
+        h.next = p + 1;
+        std::size_t n = 0;
+        switch (h.info)
+        {
+            case 0x18: n = 1; break;
+            case 0x19: n = 2; break;
+            case 0x1a: n = 4; break;
+            case 0x1b: n = 8; break;
+            case 0x1c:
+            case 0x1d:
+            case 0x1e:
+                ec = cbor_errc::unknown_type;
+                return h;
+            case jsoncons::cbor::detail::additional_info::indefinite_length:
+                if (h.major_type == jsoncons::cbor::detail::cbor_major_type::unsigned_integer ||
+                    h.major_type == jsoncons::cbor::detail::cbor_major_type::negative_integer ||
+                    h.major_type == jsoncons::cbor::detail::cbor_major_type::semantic_tag ||
+                    h.major_type == jsoncons::cbor::detail::cbor_major_type::simple)
+                {
+                    ec = cbor_errc::unknown_type;
+                }
+                return h;
+            default:
+                h.value = h.info;
+                break;
+        }
+        if (length_ - h.next < n)
+        {
+            ec = cbor_errc::unexpected_eof;
+            return h;
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            h.value = (h.value << 8) | data_[h.next + i];
+        }
+        h.next += n;
+        if (h.value > length_ - h.next && (h.major_type == jsoncons::cbor::detail::cbor_major_type::byte_string ||
+                                           h.major_type == jsoncons::cbor::detail::cbor_major_type::text_string))
+        {
+            ec = cbor_errc::unexpected_eof;
+        }
+        return h;
+    }
+
+    bool is_namespace(const item_head& h, std::error_code& ec) const
+    {
+        if (h.major_type != jsoncons::cbor::detail::cbor_major_type::semantic_tag || h.value != 256)
+        {
+            return false;
+        }
+        item_head inner = read_head(h.next, ec);
+        return !ec && (inner.major_type == jsoncons::cbor::detail::cbor_major_type::array ||
+                       inner.major_type == jsoncons::cbor::detail::cbor_major_type::map);
+    }
+
+    // Returns the offset one past the data item at p. If table is not null, definite length strings
+    // that are long enough to be assigned a stringref index in the current namespace are added to it,
+    // strings inside nested namespaces are not.
+    std::size_t skip(std::size_t p, std::vector<std::size_t>* table, int depth, std::error_code& ec) const
+    {
+        if (depth > max_nesting_depth)
+        {
+            ec = cbor_errc::max_nesting_depth_exceeded;
+            return p;
+        }
+        item_head h = read_head(p, ec);
+        if (ec)
+        {
+            return p;
+        }
+        switch (h.major_type)
+        {
+            case jsoncons::cbor::detail::cbor_major_type::unsigned_integer:
+            case jsoncons::cbor::detail::cbor_major_type::negative_integer:
+            case jsoncons::cbor::detail::cbor_major_type::simple:
+                return h.next;
+            case jsoncons::cbor::detail::cbor_major_type::byte_string:
+            case jsoncons::cbor::detail::cbor_major_type::text_string:
+            {
+                if (h.info == jsoncons::cbor::detail::additional_info::indefinite_length)
+                {
+                    std::size_t q = h.next;
+                    while (true)
+                    {
+                        if (q >= length_)
+                        {
+                            ec = cbor_errc::unexpected_eof;
+                            return q;
+                        }
+                        if (data_[q] == 0xff)
+                        {
+                            return q + 1;
+                        }
+                        item_head chunk = read_head(q, ec);
+                        if (ec)
+                        {
+                            return q;
+                        }
+                        if (chunk.major_type != h.major_type || chunk.info == jsoncons::cbor::detail::additional_info::indefinite_length)
+                        {
+                            ec = cbor_errc::illegal_chunked_string;
+                            return q;
+                        }
+                        q = chunk.next + static_cast<std::size_t>(chunk.value);
+                    }
+                }
+                if (table != nullptr && h.value >= jsoncons::cbor::detail::min_length_for_stringref(table->size()))
+                {
+                    table->push_back(p);
+                }
+                return h.next + static_cast<std::size_t>(h.value);
+            }
+            case jsoncons::cbor::detail::cbor_major_type::array:
+            case jsoncons::cbor::detail::cbor_major_type::map:
+            {
+                std::size_t q = h.next;
+                if (h.info == jsoncons::cbor::detail::additional_info::indefinite_length)
+                {
+                    while (true)
+                    {
+                        if (q >= length_)
+                        {
+                            ec = cbor_errc::unexpected_eof;
+                            return q;
+                        }
+                        if (data_[q] == 0xff)
+                        {
+                            return q + 1;
+                        }
+                        q = skip(q, table, depth+1, ec);
+                        if (ec)
+                        {
+                            return q;
+                        }
+                    }
+                }
+                uint64_t n = h.major_type == jsoncons::cbor::detail::cbor_major_type::map ? 2*h.value : h.value;
+                if (n > length_ - q || (h.major_type == jsoncons::cbor::detail::cbor_major_type::map && h.value > length_))
+                {
+                    ec = cbor_errc::unexpected_eof;
+                    return q;
+                }
+                for (uint64_t i = 0; i < n; ++i)
+                {
+                    q = skip(q, table, depth+1, ec);
+                    if (ec)
+                    {
+                        return q;
+                    }
+                }
+                return q;
+            }
+            case jsoncons::cbor::detail::cbor_major_type::semantic_tag:
+            {
+                bool nested = is_namespace(h, ec);
+                if (ec)
+                {
+                    return p;
+                }
+                return skip(h.next, nested ? nullptr : table, depth+1, ec);
+            }
+            default:
+                ec = cbor_errc::unknown_type;
+                return p;
+        }
+    }
+
+    const std::vector<std::size_t>& get_stringrefs(std::size_t ns, const std::shared_ptr<stringref_table>& refs, std::error_code& ec) const
+    {
+        if (!refs->built)
+        {
+            refs->offsets.clear();
+            skip(ns, &refs->offsets, 0, ec);
+            if (ec)
+            {
+                return refs->offsets;
+            }
+            refs->built = true;
+        }
+        return refs->offsets;
+    }
+
+    // Looks through tags and stringrefs to the data item proper, and notes the stringref
+    // namespace that applies to its elements.
+    item_content content(std::error_code& ec) const
+    {
+        item_content c;
+        c.pos = pos_;
+        c.has_tag = false;
+        c.tag = 0;
+        c.ns = ns_;
+        c.refs = refs_;
+        while (true)
+        {
+            c.head = read_head(c.pos, ec);
+            if (ec || c.head.major_type != jsoncons::cbor::detail::cbor_major_type::semantic_tag)
+            {
+                return c;
+            }
+            if (is_namespace(c.head, ec))
+            {
+                c.pos = c.head.next;
+                c.ns = c.pos;
+                if (own_ns_ != c.ns)
+                {
+                    own_refs_ = std::make_shared<stringref_table>();
+                    own_ns_ = c.ns;
+                }
+                c.refs = own_refs_;
+                continue;
+            }
+            if (ec)
+            {
+                return c;
+            }
+            if (c.head.value == 25 && c.ns != npos)
+            {
+                item_head ref = read_head(c.head.next, ec);
+                if (ec)
+                {
+                    return c;
+                }
+                if (ref.major_type == jsoncons::cbor::detail::cbor_major_type::unsigned_integer)
+                {
+                    const std::vector<std::size_t>& table = get_stringrefs(c.ns, c.refs, ec);
+                    if (ec)
+                    {
+                        return c;
+                    }
+                    if (ref.value >= table.size() || table[static_cast<std::size_t>(ref.value)] >= c.pos)
+                    {
+                        ec = cbor_errc::stringref_too_large;
+                        return c;
+                    }
+                    c.pos = table[static_cast<std::size_t>(ref.value)];
+                    c.head = read_head(c.pos, ec);
+                    return c;
+                }
+            }
+            c.has_tag = true;
+            c.tag = c.head.value;
+            c.pos = c.head.next;
+        }
+    }
+
+    item_content content() const
+    {
+        std::error_code ec;
+        item_content c = content(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+        return c;
+    }
+
+    const std::vector<std::size_t>& get_index(const item_content& c) const
+    {
+        if (!index_)
+        {
+            std::shared_ptr<std::vector<std::size_t>> index = std::make_shared<std::vector<std::size_t>>();
+            std::error_code ec;
+            std::size_t p = c.head.next;
+            std::size_t count = c.head.info == jsoncons::cbor::detail::additional_info::indefinite_length ? npos : checked_size(c.head.value);
+            if (count != npos)
+            {
+                index->reserve(c.head.major_type == jsoncons::cbor::detail::cbor_major_type::map ? 2*count : count);
+            }
+            for (std::size_t i = 0; count == npos ? !is_break(p) : i < count; ++i)
+            {
+                index->push_back(p);
+                p = skip(p, nullptr, 0, ec);
+                if (!ec && c.head.major_type == jsoncons::cbor::detail::cbor_major_type::map)
+                {
+                    index->push_back(p);
+                    p = skip(p, nullptr, 0, ec);
+                }
+                if (ec)
+                {
+                    JSONCONS_THROW(ser_error(ec));
+                }
+            }
+            index_ = index;
+        }
+        return *index_;
+    }
+
+    // Returns the offset of the key of the member called name, or npos
+    std::size_t find_member(const item_content& c, const string_view& name) const
+    {
+        if (c.head.major_type != jsoncons::cbor::detail::cbor_major_type::map)
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+        }
+        if (indexed_)
+        {
+            const std::vector<std::size_t>& index = get_index(c);
+            for (std::size_t i = 0; i < index.size(); i += 2)
+            {
+                if (child(c, index[i]).equals(name))
+                {
+                    return index[i];
+                }
+            }
+            return npos;
+        }
+        std::error_code ec;
+        std::size_t p = c.head.next;
+        std::size_t count = c.head.info == jsoncons::cbor::detail::additional_info::indefinite_length ? npos : checked_size(c.head.value);
+        for (std::size_t i = 0; count == npos ? !is_break(p) : i < count; ++i)
+        {
+            if (child(c, p).equals(name))
+            {
+                return p;
+            }
+            p = skip(p, nullptr, 0, ec);
+            if (!ec)
+            {
+                p = skip(p, nullptr, 0, ec);
+            }
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+        return npos;
+    }
+
+    std::size_t value_offset(const item_content&, std::size_t key_offset) const
+    {
+        std::error_code ec;
+        std::size_t p = skip(key_offset, nullptr, 0, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+        return p;
+    }
+
+    // Reads the head of a chunk of the indefinite length string c, which must be a definite
+    // length string of the same major type
+    item_head read_chunk(const item_content& c, std::size_t q) const
+    {
+        std::error_code ec;
+        item_head chunk = read_head(q, ec);
+        if (!ec && (chunk.major_type != c.head.major_type || chunk.info == jsoncons::cbor::detail::additional_info::indefinite_length))
+        {
+            ec = cbor_errc::illegal_chunked_string;
+        }
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+        return chunk;
+    }
+
+    bool string_equals(const item_content& c, const string_view& name) const
+    {
+        if (c.head.info != jsoncons::cbor::detail::additional_info::indefinite_length)
+        {
+            return c.head.value == name.size() &&
+                   std::memcmp(data_ + c.head.next, name.data(), name.size()) == 0;
+        }
+        std::size_t offset = 0;
+        std::size_t q = c.head.next;
+        while (!is_break(q))
+        {
+            item_head chunk = read_chunk(c, q);
+            std::size_t n = checked_size(chunk.value);
+            if (n > name.size() - offset || std::memcmp(data_ + chunk.next, name.data() + offset, n) != 0)
+            {
+                return false;
+            }
+            offset += n;
+            q = chunk.next + n;
+        }
+        return offset == name.size();
+    }
+
+    template <class Container>
+    void append_chunks(const item_content& c, Container& s) const
+    {
+        if (c.head.info != jsoncons::cbor::detail::additional_info::indefinite_length)
+        {
+            s.insert(s.end(), data_ + c.head.next, data_ + c.head.next + static_cast<std::size_t>(c.head.value));
+            return;
+        }
+        std::size_t q = c.head.next;
+        while (!is_break(q))
+        {
+            item_head chunk = read_chunk(c, q);
+            s.insert(s.end(), data_ + chunk.next, data_ + chunk.next + static_cast<std::size_t>(chunk.value));
+            q = chunk.next + static_cast<std::size_t>(chunk.value);
+        }
+    }
+
+    // Copies the data item at p to buffer, replacing stringrefs with the strings they refer to
+    std::size_t copy_item(std::size_t p, const std::vector<std::size_t>& table, std::vector<uint8_t>& buffer, int depth, std::error_code& ec) const
+    {
+        if (depth > max_nesting_depth)
+        {
+            ec = cbor_errc::max_nesting_depth_exceeded;
+            return p;
+        }
+        item_head h = read_head(p, ec);
+        if (ec)
+        {
+            return p;
+        }
+        switch (h.major_type)
+        {
+            case jsoncons::cbor::detail::cbor_major_type::semantic_tag:
+            {
+                if (h.value == 25)
+                {
+                    item_head ref = read_head(h.next, ec);
+                    if (ec)
+                    {
+                        return p;
+                    }
+                    if (ref.major_type == jsoncons::cbor::detail::cbor_major_type::unsigned_integer)
+                    {
+                        if (ref.value >= table.size() || table[static_cast<std::size_t>(ref.value)] >= p)
+                        {
+                            ec = cbor_errc::stringref_too_large;
+                            return p;
+                        }
+                        std::size_t s = table[static_cast<std::size_t>(ref.value)];
+                        std::size_t e = skip(s, nullptr, 0, ec);
+                        buffer.insert(buffer.end(), data_ + s, data_ + e);
+                        return ref.next;
+                    }
+                }
+                if (is_namespace(h, ec))
+                {
+                    // A nested namespace resolves its own stringrefs
+                    std::size_t q = skip(p, nullptr, depth, ec);
+                    buffer.insert(buffer.end(), data_ + p, data_ + q);
+                    return q;
+                }
+                if (ec)
+                {
+                    return p;
+                }
+                buffer.insert(buffer.end(), data_ + p, data_ + h.next);
+                return copy_item(h.next, table, buffer, depth+1, ec);
+            }
+            case jsoncons::cbor::detail::cbor_major_type::array:
+            case jsoncons::cbor::detail::cbor_major_type::map:
+            {
+                buffer.insert(buffer.end(), data_ + p, data_ + h.next);
+                std::size_t q = h.next;
+                if (h.info == jsoncons::cbor::detail::additional_info::indefinite_length)
+                {
+                    while (!ec)
+                    {
+                        if (q >= length_)
+                        {
+                            ec = cbor_errc::unexpected_eof;
+                            return q;
+                        }
+                        if (data_[q] == 0xff)
+                        {
+                            buffer.push_back(0xff);
+                            return q + 1;
+                        }
+                        q = copy_item(q, table, buffer, depth+1, ec);
+                    }
+                    return q;
+                }
+                uint64_t n = h.major_type == jsoncons::cbor::detail::cbor_major_type::map ? 2*h.value : h.value;
+                for (uint64_t i = 0; !ec && i < n; ++i)
+                {
+                    q = copy_item(q, table, buffer, depth+1, ec);
+                }
+                return q;
+            }
+            default:
+            {
+                std::size_t q = skip(p, nullptr, depth, ec);
+                if (!ec)
+                {
+                    buffer.insert(buffer.end(), data_ + p, data_ + q);
+                }
+                return q;
+            }
+        }
+    }
+};
+
+class cbor_view_member
+{
+    cbor_view key_;
+    cbor_view value_;
+public:
+    cbor_view_member(const cbor_view& key, const cbor_view& value)
+        : key_(key), value_(value)
+    {
+    }
+
+    const cbor_view& key() const
+    {
+        return key_;
+    }
+
+    const cbor_view& value() const
+    {
+        return value_;
+    }
+};
+
+class cbor_view::array_iterator
+{
+    cbor_view parent_;
+    item_content content_;
+    std::size_t pos_;
+    std::size_t remaining_;
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = cbor_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const cbor_view*;
+    using reference = cbor_view;
+
+    array_iterator(const cbor_view& parent, const item_content& content, std::size_t pos, std::size_t remaining)
+        : parent_(parent), content_(content), pos_(pos), remaining_(remaining)
+    {
+    }
+
+    cbor_view operator*() const
+    {
+        return parent_.child(content_, pos_);
+    }
+
+    array_iterator& operator++()
+    {
+        std::error_code ec;
+        pos_ = parent_.skip(pos_, nullptr, 0, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+        if (remaining_ != npos)
+        {
+            --remaining_;
+        }
+        return *this;
+    }
+
+    array_iterator operator++(int)
+    {
+        array_iterator temp(*this);
+        ++*this;
+        return temp;
+    }
+
+    friend bool operator==(const array_iterator& lhs, const array_iterator& rhs)
+    {
+        bool lhs_end = lhs.at_end();
+        bool rhs_end = rhs.at_end();
+        return lhs_end || rhs_end ? lhs_end == rhs_end : lhs.pos_ == rhs.pos_;
+    }
+
+    friend bool operator!=(const array_iterator& lhs, const array_iterator& rhs)
+    {
+        return !(lhs == rhs);
+    }
+private:
+    bool at_end() const
+    {
+        return remaining_ == 0 || (remaining_ == npos && parent_.is_break(pos_));
+    }
+};
+
+class cbor_view::object_iterator
+{
+    cbor_view parent_;
+    item_content content_;
+    std::size_t pos_;
+    std::size_t remaining_;
+    mutable std::shared_ptr<cbor_view_member> member_;
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = cbor_view_member;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const cbor_view_member*;
+    using reference = const cbor_view_member&;
+
+    object_iterator(const cbor_view& parent, const item_content& content, std::size_t pos, std::size_t remaining)
+        : parent_(parent), content_(content), pos_(pos), remaining_(remaining)
+    {
+    }
+
+    const cbor_view_member& operator*() const
+    {
+        if (!member_)
+        {
+            member_ = std::make_shared<cbor_view_member>(parent_.child(content_, pos_),
+                                                         parent_.child(content_, parent_.value_offset(content_, pos_)));
+        }
+        return *member_;
+    }
+
+    const cbor_view_member* operator->() const
+    {
+        return std::addressof(**this);
+    }
+
+    object_iterator& operator++()
+    {
+        pos_ = parent_.value_offset(content_, parent_.value_offset(content_, pos_));
+        member_.reset();
+        if (remaining_ != npos)
+        {
+            --remaining_;
+        }
+        return *this;
+    }
+
+    object_iterator operator++(int)
+    {
+        object_iterator temp(*this);
+        ++*this;
+        return temp;
+    }
+
+    friend bool operator==(const object_iterator& lhs, const object_iterator& rhs)
+    {
+        bool lhs_end = lhs.at_end();
+        bool rhs_end = rhs.at_end();
+        return lhs_end || rhs_end ? lhs_end == rhs_end : lhs.pos_ == rhs.pos_;
+    }
+
+    friend bool operator!=(const object_iterator& lhs, const object_iterator& rhs)
+    {
+        return !(lhs == rhs);
+    }
+private:
+    bool at_end() const
+    {
+        return remaining_ == 0 || (remaining_ == npos && parent_.is_break(pos_));
+    }
+};
+
+inline
+cbor_view::object_iterator cbor_view::find(const string_view& name) const
+{
+    object_range_type members = object_range();
+    object_iterator it = members.begin();
+    while (it != members.end() && !it->key().equals(name))
+    {
+        ++it;
+    }
+    return it;
+}
+
+inline
+cbor_view::array_range_type cbor_view::array_range() const
+{
+    item_content c = content();
+    if (!is_container(c) || c.head.major_type != jsoncons::cbor::detail::cbor_major_type::array)
+    {
+        JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+    }
+    std::size_t count = c.head.info == jsoncons::cbor::detail::additional_info::indefinite_length ? npos : checked_size(c.head.value);
+    return array_range_type(array_iterator(*this, c, c.head.next, count), array_iterator(*this, c, c.head.next, 0));
+}
+
+inline
+cbor_view::object_range_type cbor_view::object_range() const
+{
+    item_content c = content();
+    if (c.head.major_type != jsoncons::cbor::detail::cbor_major_type::map)
+    {
+        JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+    }
+    std::size_t count = c.head.info == jsoncons::cbor::detail::additional_info::indefinite_length ? npos : checked_size(c.head.value);
+    return object_range_type(object_iterator(*this, c, c.head.next, count), object_iterator(*this, c, c.head.next, 0));
+}
+
+}}
+
+#endif
@@ -0,0 +1,211 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSONMERGEPATCH_JSONMERGEPATCH_HPP
+#define JSONCONS_JSONMERGEPATCH_JSONMERGEPATCH_HPP
+
+#include <string>
+#include <utility> // std::move
+#include <system_error> // std::error_code
+#include <jsoncons/json.hpp>
+#include <jsoncons/staj_cursor.hpp>
+#include <jsoncons/json_decoder.hpp>
+
+namespace jsoncons { namespace jsonmergepatch {
+
+namespace detail {
+
+    template <class Json>
+    const Json& patch_value(const Json& val)
+    {
+        return val;
+    }
+
+    template <class Json>
+    Json&& patch_value(Json& val)
+    {
+        return std::move(val);
+    }
+
+    // Applies patch to target in place. If Patch is non-const, values
+    // are moved out of the patch rather than copied.
+    template <class Json,class Patch>
+    void apply_merge_patch(Json& target, Patch& patch)
+    {
+        if (!patch.is_object())
+        {
+            target = patch_value(patch);
+            return;
+        }
+        if (!target.is_object())
+        {
+            target = Json(json_object_arg);
+        }
+        for (auto& member : patch.object_range())
+        {
+            if (member.value().is_null())
+            {
+                target.erase(member.key());
+                continue;
+            }
+            auto it = target.find(member.key());
+            if (it != target.object_range().end())
+            {
+                apply_merge_patch(it->value(), member.value());
+            }
+            else if (member.value().is_object())
+            {
+                // A new member is merged into an empty object, so that nulls in the patch are dropped
+                auto result = target.try_emplace(member.key(), json_object_arg);
+                apply_merge_patch(result.first->value(), member.value());
+            }
+            else
+            {
+                target.try_emplace(member.key(), patch_value(member.value()));
+            }
+        }
+    }
+
+    template <class Json,class TempAllocator>
+    void apply_merge_patch(Json& target, 
+                           basic_staj_cursor<typename Json::char_type>& cursor,
+                           json_decoder<Json,TempAllocator>& decoder,
+                           std::error_code& ec)
+    {
+        using string_view_type = typename Json::string_view_type;
+
+        if (cursor.current().event_type() != staj_event_type::begin_object)
+        {
+            decoder.reset();
+            cursor.read_to(decoder, ec);
+            if (!ec)
+            {
+                target = decoder.get_result();
+            }
+            return;
+        }
+        if (!target.is_object())
+        {
+            target = Json(json_object_arg);
+        }
+        cursor.next(ec);
+        while (!ec && !cursor.done() && cursor.current().event_type() != staj_event_type::end_object)
+        {
+            auto key = cursor.current().template get<string_view_type>(ec);
+            if (ec)
+            {
+                return;
+            }
+            typename Json::key_type name(key.data(), key.size());
+            cursor.next(ec);
+            if (ec)
+            {
+                return;
+            }
+            switch (cursor.current().event_type())
+            {
+                case staj_event_type::null_value:
+                    target.erase(name);
+                    break;
+                case staj_event_type::begin_object:
+                {
+                    auto result = target.try_emplace(name, json_object_arg);
+                    apply_merge_patch(result.first->value(), cursor, decoder, ec);
+                    break;
+                }
+                default:
+                    decoder.reset();
+                    cursor.read_to(decoder, ec);
+                    if (!ec)
+                    {
+                        target.insert_or_assign(name, decoder.get_result());
+                    }
+                    break;
+            }
+            if (!ec)
+            {
+                cursor.next(ec);
+            }
+        }
+    }
+
+} // namespace detail
+
+    // apply_merge_patch
+
+    template <class Json>
+    void apply_merge_patch(Json& target, const Json& patch)
+    {
+        detail::apply_merge_patch(target, patch);
+    }
+
+    // Values are moved out of the patch rather than copied
+    template <class Json>
+    void apply_merge_patch(Json& target, Json&& patch)
+    {
+        detail::apply_merge_patch(target, patch);
+    }
+
+    // Reads the patch from a cursor, without building the patch document. 
+    // Only values that are added or replaced are materialized.
+    template <class Json>
+    void apply_merge_patch(Json& target, basic_staj_cursor<typename Json::char_type>& cursor, std::error_code& ec)
+    {
+        json_decoder<Json> decoder;
+        detail::apply_merge_patch(target, cursor, decoder, ec);
+    }
+
+    template <class Json>
+    void apply_merge_patch(Json& target, basic_staj_cursor<typename Json::char_type>& cursor)
+    {
+        std::error_code ec;
+        apply_merge_patch(target, cursor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec, cursor.context().line(), cursor.context().column()));
+        }
+    }
+
+    // from_diff
+
+    // Returns a merge patch that transforms source into target. Members of
+    // target with null values cannot be represented in a merge patch, and
+    // are reported as removals.
+    template <class Json>
+    Json from_diff(const Json& source, const Json& target)
+    {
+        if (!source.is_object() || !target.is_object())
+        {
+            return target;
+        }
+        Json result(json_object_arg);
+
+        for (const auto& member : source.object_range())
+        {
+            if (target.find(member.key()) == target.object_range().end())
+            {
+                result.try_emplace(member.key(), null_type());
+            }
+        }
+        for (const auto& member : target.object_range())
+        {
+            auto it = source.find(member.key());
+            if (it == source.object_range().end())
+            {
+                result.try_emplace(member.key(), member.value());
+            }
+            else if (it->value() != member.value())
+            {
+                result.try_emplace(member.key(), from_diff(it->value(), member.value()));
+            }
+        }
+        return result;
+    }
+
+} // namespace jsonmergepatch
+} // namespace jsoncons
+
+#endif
@@ -12,12 +12,16 @@
 #include <memory>
 #include <algorithm> // std::min
 #include <utility> // std::move
+#include <unordered_map>
 #include <jsoncons/json.hpp>
 #include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
 #include <jsoncons_ext/jsonpatch/jsonpatch_error.hpp>
 
 namespace jsoncons { namespace jsonpatch {
 
+// no_rollback skips journaling changes, a failed patch leaves the target partially patched
+enum class apply_patch_options {none = 0, no_rollback = 1};
+
 namespace detail {
 
     JSONCONS_STRING_LITERAL(test_literal,'t','e','s','t')
@@ -34,63 +38,83 @@ namespace detail {
     enum class op_type {add,remove,replace};
     enum class state_type {begin,abort,commit};
 
+    // Journal of the changes made by apply_patch, undone in reverse order if 
+    // the patch fails. Values displaced from the target are moved into the
+    // journal rather than copied. An entry marked carry hands its value to
+    // the entry undone after it instead of holding one, so that a move 
+    // operation can be undone without copying the moved value.
     template <class Json>
     struct operation_unwinder
     {
         using char_type = typename Json::char_type;
-        using string_type = std::basic_string<char_type>;
-        using string_view_type = typename Json::string_view_type;
+        using pointer_type = jsonpointer::basic_parsed_json_ptr<char_type>;
 
         struct entry
         {
             op_type op;
-            string_type path;
+            pointer_type path;
             Json value;
+            bool carry;
         };
 
         Json& target;
         state_type state;
+        bool enabled;
         std::vector<entry> stack;
 
-        operation_unwinder(Json& j)
-            : target(j), state(state_type::begin)
+        operation_unwinder(Json& j, bool enabled = true)
+            : target(j), state(state_type::begin), enabled(enabled)
+        {
+        }
+
+        void record(op_type op, const pointer_type& path, Json&& value, bool carry = false)
         {
+            if (enabled)
+            {
+                stack.push_back(entry{op, path, std::move(value), carry});
+            }
         }
 
         ~operation_unwinder() noexcept
         {
+            if (state == state_type::commit || !enabled)
+            {
+                return;
+            }
             std::error_code ec;
-            //std::cout << "state: " << std::boolalpha << (state == state_type::commit) << ", stack size: " << stack.size() << std::endl;
-            if (state != state_type::commit)
+            Json carried;
+            for (auto it = stack.rbegin(); it != stack.rend() && !ec; ++it)
             {
-                for (auto it = stack.rbegin(); it != stack.rend(); ++it)
+                switch (it->op)
                 {
-                    if (it->op == op_type::add)
-                    {
-                        jsonpointer::insert_or_assign(target,it->path,it->value,ec);
-                        if (ec)
-                        {
-                            //std::cout << "add: " << it->path << std::endl;
-                            break;
-                        }
-                    }
-                    else if (it->op == op_type::remove)
+                    case op_type::add:
+                        jsonpointer::detail::parsed_insert(target, it->path, it->carry ? std::move(carried) : std::move(it->value), true, ec);
+                        break;
+                    case op_type::remove:
                     {
-                        jsonpointer::remove(target,it->path,ec);
-                        if (ec)
+                        Json* p = jsonpointer::detail::select_path(target, it->path, it->path.size(), ec);
+                        if (p != nullptr)
                         {
-                            //std::cout << "remove: " << it->path << std::endl;
-                            break;
+                            if (it->carry)
+                            {
+                                carried = std::move(*p);
+                            }
+                            jsonpointer::detail::parsed_remove(target, it->path, ec);
                         }
+                        break;
                     }
-                    else if (it->op == op_type::replace)
+                    case op_type::replace:
                     {
-                        jsonpointer::replace(target,it->path,it->value,ec);
-                        if (ec)
+                        Json* p = jsonpointer::detail::select_path(target, it->path, it->path.size(), ec);
+                        if (p != nullptr)
                         {
-                            //std::cout << "replace: " << it->path << std::endl;
-                            break;
+                            if (it->carry)
+                            {
+                                carried = std::move(*p);
+                            }
+                            *p = std::move(it->value);
                         }
+                        break;
                     }
                 }
             }
@@ -98,378 +122,564 @@ namespace detail {
     };
 
     template <class Json>
-    Json from_diff(const Json& source, const Json& target, const typename Json::string_view_type& path)
+    const Json& patch_value(const Json& val)
+    {
+        return val;
+    }
+
+    template <class Json>
+    Json&& patch_value(Json& val)
+    {
+        return std::move(val);
+    }
+
+    // Makes a trailing "-" in the destination of an add refer to an explicit index
+    template <class Json>
+    void normalize_destination(const Json& target, jsonpointer::basic_parsed_json_ptr<typename Json::char_type>& path)
+    {
+        if (!path.empty() && path[path.size()-1].is_past_end())
+        {
+            std::error_code ec;
+            const Json* parent = jsonpointer::detail::select_path(target, path, path.size()-1, ec);
+            if (parent != nullptr && parent->is_array())
+            {
+                std::basic_string<typename Json::char_type> index;
+                jsoncons::detail::write_integer(parent->size(), index);
+                path.pop_back();
+                path /= index;
+            }
+        }
+    }
+
+    // Adds value at path, or if the location is occupied, replaces it and
+    // moves the previous value into displaced. Returns false on failure,
+    // in which case value is left untouched.
+    template <class Json,class T>
+    bool add_value(Json& target, const jsonpointer::basic_parsed_json_ptr<typename Json::char_type>& path, 
+                   T&& value, bool& replaced, Json& displaced)
+    {
+        std::error_code ec;
+        jsonpointer::detail::parsed_insert(target, path, std::forward<T>(value), false, ec); // try insert without replace
+        if (!ec)
+        {
+            replaced = false;
+            return true;
+        }
+        ec = std::error_code();
+        Json* current = jsonpointer::detail::select_path(target, path, path.size(), ec);
+        if (current == nullptr)
+        {
+            return false;
+        }
+        displaced = std::move(*current);
+        *current = std::forward<T>(value);
+        replaced = true;
+        return true;
+    }
+
+    // std::hash<Json> with the hashes of arrays and objects memoized by address,
+    // so that each subtree of a diff is hashed once
+    template <class Json>
+    class subtree_hasher
+    {
+        std::unordered_map<const Json*,std::size_t> cache_;
+    public:
+        std::size_t operator()(const Json& val)
+        {
+            if (!(val.is_array() || val.is_object()))
+            {
+                return jsoncons::detail::hash_json(val, *this);
+            }
+            auto it = cache_.find(std::addressof(val));
+            if (it != cache_.end())
+            {
+                return it->second;
+            }
+            std::size_t h = jsoncons::detail::hash_json(val, *this);
+            cache_.emplace(std::addressof(val), h);
+            return h;
+        }
+    };
+
+    // Generates a JSON Patch by appending operations to a single result array,
+    // using one path buffer for the whole walk. Arrays are aligned with a
+    // longest common subsequence, so insertions and deletions produce add and 
+    // remove operations instead of a replace per shifted element.
+    template <class Json>
+    class patch_generator
     {
         using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = typename Json::string_view_type;
 
-        Json result = typename Json::array();
+        enum class edit_kind {keep,remove,add};
 
-        if (source == target)
+        Json& result_;
+        string_type path_;
+        subtree_hasher<Json> hasher_;
+        std::size_t max_lcs_cells_;
+    public:
+        patch_generator(Json& result, const string_view_type& path, std::size_t max_lcs_cells = 1 << 20)
+            : result_(result), path_(path), max_lcs_cells_(max_lcs_cells)
         {
-            return result;
         }
 
-        if (source.is_array() && target.is_array())
+        void diff(const Json& source, const Json& target)
         {
-            std::size_t common = (std::min)(source.size(),target.size());
-            for (std::size_t i = 0; i < common; ++i)
+            if (equal(source, target))
             {
-                std::basic_string<char_type> ss(path); 
-                ss.push_back('/');
-                jsoncons::detail::write_integer(i,ss);
-                auto temp_diff = from_diff(source[i],target[i],ss);
-                result.insert(result.array_range().end(),temp_diff.array_range().begin(),temp_diff.array_range().end());
+                return;
             }
-            // Element in source, not in target - remove
-            for (std::size_t i = target.size(); i < source.size(); ++i)
+            if (source.is_array() && target.is_array())
             {
-                std::basic_string<char_type> ss(path); 
-                ss.push_back('/');
-                jsoncons::detail::write_integer(i,ss);
-                Json val = typename Json::object();
-                val.insert_or_assign(op_literal<char_type>(), remove_literal<char_type>());
-                val.insert_or_assign(path_literal<char_type>(), ss);
-                result.push_back(std::move(val));
+                diff_arrays(source, target);
             }
-            // Element in target, not in source - add, 
-            // Fix contributed by Alexander rog13
-            for (std::size_t i = source.size(); i < target.size(); ++i)
+            else if (source.is_object() && target.is_object())
             {
-                const auto& a = target[i];
-                std::basic_string<char_type> ss(path); 
-                ss.push_back('/');
-                jsoncons::detail::write_integer(i,ss);
-                Json val = typename Json::object();
-                val.insert_or_assign(op_literal<char_type>(), add_literal<char_type>());
-                val.insert_or_assign(path_literal<char_type>(), ss);
-                val.insert_or_assign(value_literal<char_type>(), a);
-                result.push_back(std::move(val));
+                diff_objects(source, target);
+            }
+            else
+            {
+                emit(replace_literal<char_type>(), std::addressof(target));
             }
         }
-        else if (source.is_object() && target.is_object())
+    private:
+        bool equal(const Json& a, const Json& b)
         {
+            return hasher_(a) == hasher_(b) && a == b;
+        }
+
+        void emit(const string_view_type& op, const Json* value)
+        {
+            Json val(json_object_arg);
+            val.insert_or_assign(op_literal<char_type>(), op);
+            val.insert_or_assign(path_literal<char_type>(), path_);
+            if (value != nullptr)
+            {
+                val.insert_or_assign(value_literal<char_type>(), *value);
+            }
+            result_.push_back(std::move(val));
+        }
+
+        void diff_objects(const Json& source, const Json& target)
+        {
+            const std::size_t length = path_.size();
             for (const auto& a : source.object_range())
             {
-                std::basic_string<char_type> ss(path);
-                ss.push_back('/'); 
-                jsonpointer::escape(a.key(),ss);
+                path_.push_back('/'); 
+                jsonpointer::escape(a.key(), path_);
                 auto it = target.find(a.key());
                 if (it != target.object_range().end())
                 {
-                    auto temp_diff = from_diff(a.value(),it->value(),ss);
-                    result.insert(result.array_range().end(),temp_diff.array_range().begin(),temp_diff.array_range().end());
+                    diff(a.value(), it->value());
                 }
                 else
                 {
-                    Json val = typename Json::object();
-                    val.insert_or_assign(op_literal<char_type>(), remove_literal<char_type>());
-                    val.insert_or_assign(path_literal<char_type>(), ss);
-                    result.push_back(std::move(val));
+                    emit(remove_literal<char_type>(), nullptr);
                 }
+                path_.resize(length);
             }
             for (const auto& a : target.object_range())
             {
                 auto it = source.find(a.key());
                 if (it == source.object_range().end())
                 {
-                    std::basic_string<char_type> ss(path); 
-                    ss.push_back('/');
-                    jsonpointer::escape(a.key(),ss);
-                    Json val = typename Json::object();
-                    val.insert_or_assign(op_literal<char_type>(), add_literal<char_type>());
-                    val.insert_or_assign(path_literal<char_type>(), ss);
-                    val.insert_or_assign(value_literal<char_type>(), a.value());
-                    result.push_back(std::move(val));
+                    path_.push_back('/'); 
+                    jsonpointer::escape(a.key(), path_);
+                    emit(add_literal<char_type>(), std::addressof(a.value()));
+                    path_.resize(length);
                 }
             }
         }
-        else
-        {
-            Json val = typename Json::object();
-            val.insert_or_assign(op_literal<char_type>(), replace_literal<char_type>());
-            val.insert_or_assign(path_literal<char_type>(), path);
-            val.insert_or_assign(value_literal<char_type>(), target);
-            result.push_back(std::move(val));
-        }
 
-        return result;
-    }
-}
-
-template <class Json>
-void apply_patch(Json& target, const Json& patch, std::error_code& patch_ec)
-{
-    using char_type = typename Json::char_type;
-    using string_type = std::basic_string<char_type>;
-    using string_view_type = typename Json::string_view_type;
+        void diff_arrays(const Json& source, const Json& target)
+        {
+            const std::size_t n = source.size();
+            const std::size_t m = target.size();
 
-   jsoncons::jsonpatch::detail::operation_unwinder<Json> unwinder(target);
+            // Trim common prefix and suffix
+            std::size_t first = 0;
+            while (first < n && first < m && equal(source[first], target[first]))
+            {
+                ++first;
+            }
+            std::size_t n_last = n;
+            std::size_t m_last = m;
+            while (n_last > first && m_last > first && equal(source[n_last-1], target[m_last-1]))
+            {
+                --n_last;
+                --m_last;
+            }
 
-    // Validate
-    
-    string_type bad_path;
-    for (const auto& operation : patch.array_range())
-    {
-        unwinder.state =jsoncons::jsonpatch::detail::state_type::begin;
+            std::vector<edit_kind> edits;
+            align(source, first, n_last, target, first, m_last, edits);
 
-        if (operation.count(detail::op_literal<char_type>()) != 1 || operation.count(detail::path_literal<char_type>()) != 1)
-        {
-            patch_ec = jsonpatch_errc::invalid_patch;
-            unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+            // Replay the edit script against the array as it is being patched.
+            // A run of removes and adds between kept elements is paired up 
+            // position by position and diffed recursively, the excess is
+            // emitted as remove or add operations.
+            std::size_t index = first;
+            std::size_t i = first;
+            std::size_t j = first;
+            std::size_t k = 0;
+            while (k < edits.size())
+            {
+                if (edits[k] == edit_kind::keep)
+                {
+                    ++index; ++i; ++j; ++k;
+                    continue;
+                }
+                std::size_t removes = 0;
+                std::size_t adds = 0;
+                for (; k < edits.size() && edits[k] != edit_kind::keep; ++k)
+                {
+                    if (edits[k] == edit_kind::remove)
+                        ++removes;
+                    else
+                        ++adds;
+                }
+                std::size_t common = (std::min)(removes, adds);
+                for (std::size_t c = 0; c < common; ++c)
+                {
+                    diff_element(index++, source[i++], target[j++]);
+                }
+                for (std::size_t c = common; c < removes; ++c, ++i)
+                {
+                    push_index(index);
+                    emit(remove_literal<char_type>(), nullptr);
+                    pop_index();
+                }
+                for (std::size_t c = common; c < adds; ++c)
+                {
+                    push_index(index++);
+                    emit(add_literal<char_type>(), std::addressof(target[j++]));
+                    pop_index();
+                }
+            }
         }
-        else
+
+        // Computes the edit script turning source[s_first,s_last) into target[t_first,t_last)
+        void align(const Json& source, std::size_t s_first, std::size_t s_last,
+                   const Json& target, std::size_t t_first, std::size_t t_last,
+                   std::vector<edit_kind>& edits)
         {
-            string_view_type op = operation.at(detail::op_literal<char_type>()).as_string_view();
-            string_view_type path = operation.at(detail::path_literal<char_type>()).as_string_view();
+            const std::size_t a = s_last - s_first;
+            const std::size_t b = t_last - t_first;
+            if (a == 0 || b == 0 || (a+1)*(b+1) > max_lcs_cells_)
+            {
+                // Positional alignment
+                edits.insert(edits.end(), a, edit_kind::remove);
+                edits.insert(edits.end(), b, edit_kind::add);
+                return;
+            }
 
-            if (op ==jsoncons::jsonpatch::detail::test_literal<char_type>())
+            // lcs[x*(b+1)+y] is the length of the LCS of source[s_first+x,s_last) and target[t_first+y,t_last)
+            std::vector<uint32_t> lcs((a+1)*(b+1), 0);
+            for (std::size_t x = a; x-- > 0; )
             {
-                std::error_code ec;
-                Json val = jsonpointer::get(target,path,ec);
-                if (ec)
+                for (std::size_t y = b; y-- > 0; )
+                {
+                    if (equal(source[s_first+x], target[t_first+y]))
+                    {
+                        lcs[x*(b+1)+y] = lcs[(x+1)*(b+1)+y+1] + 1;
+                    }
+                    else
+                    {
+                        lcs[x*(b+1)+y] = (std::max)(lcs[(x+1)*(b+1)+y], lcs[x*(b+1)+y+1]);
+                    }
+                }
+            }
+
+            std::size_t x = 0;
+            std::size_t y = 0;
+            while (x < a && y < b)
+            {
+                if (lcs[x*(b+1)+y] == lcs[(x+1)*(b+1)+y+1] + 1 && equal(source[s_first+x], target[t_first+y]))
                 {
-                    patch_ec = jsonpatch_errc::test_failed;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                    edits.push_back(edit_kind::keep);
+                    ++x; ++y;
                 }
-                else if (operation.count(detail::value_literal<char_type>()) != 1)
+                else if (lcs[(x+1)*(b+1)+y] >= lcs[x*(b+1)+y+1])
                 {
-                    patch_ec = jsonpatch_errc::invalid_patch;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                    edits.push_back(edit_kind::remove);
+                    ++x;
                 }
-                else if (val != operation.at(detail::value_literal<char_type>()))
+                else
                 {
-                    patch_ec = jsonpatch_errc::test_failed;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                    edits.push_back(edit_kind::add);
+                    ++y;
                 }
             }
-            else if (op ==jsoncons::jsonpatch::detail::add_literal<char_type>())
+            edits.insert(edits.end(), a-x, edit_kind::remove);
+            edits.insert(edits.end(), b-y, edit_kind::add);
+        }
+
+        void diff_element(std::size_t index, const Json& source, const Json& target)
+        {
+            push_index(index);
+            diff(source, target);
+            pop_index();
+        }
+
+        void push_index(std::size_t index)
+        {
+            path_.push_back('/');
+            jsoncons::detail::write_integer(index, path_);
+        }
+
+        void pop_index()
+        {
+            path_.resize(path_.find_last_of('/'));
+        }
+    };
+
+    template <class Json>
+    Json from_diff(const Json& source, const Json& target, const typename Json::string_view_type& path)
+    {
+        Json result(json_array_arg);
+        patch_generator<Json> generator(result, path);
+        generator.diff(source, target);
+        return result;
+    }
+}
+
+namespace detail {
+
+    template <class Json,class Patch>
+    void apply_patch(Json& target, Patch& patch, apply_patch_options options, std::error_code& patch_ec)
+    {
+        using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = typename Json::string_view_type;
+        using pointer_type = jsonpointer::basic_parsed_json_ptr<char_type>;
+
+        operation_unwinder<Json> unwinder(target, options != apply_patch_options::no_rollback);
+
+        string_type bad_path;
+        for (auto& operation : patch.array_range())
+        {
+            unwinder.state = state_type::begin;
+
+            if (operation.count(op_literal<char_type>()) != 1 || operation.count(path_literal<char_type>()) != 1)
+            {
+                patch_ec = jsonpatch_errc::invalid_patch;
+                unwinder.state = state_type::abort;
+            }
+            else
             {
-                if (operation.count(detail::value_literal<char_type>()) != 1)
+                string_view_type op = operation.at(op_literal<char_type>()).as_string_view();
+                string_view_type path_string = operation.at(path_literal<char_type>()).as_string_view();
+                std::error_code ec;
+                pointer_type path(path_string, ec);
+
+                if (op == test_literal<char_type>())
                 {
-                    patch_ec = jsonpatch_errc::invalid_patch;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                    const Json* val = ec ? nullptr : jsonpointer::detail::select_path(static_cast<const Json&>(target), path, path.size(), ec);
+                    if (val == nullptr)
+                    {
+                        patch_ec = jsonpatch_errc::test_failed;
+                        unwinder.state = state_type::abort;
+                    }
+                    else if (operation.count(value_literal<char_type>()) != 1)
+                    {
+                        patch_ec = jsonpatch_errc::invalid_patch;
+                        unwinder.state = state_type::abort;
+                    }
+                    else if (*val != operation.at(value_literal<char_type>()))
+                    {
+                        patch_ec = jsonpatch_errc::test_failed;
+                        unwinder.state = state_type::abort;
+                    }
                 }
-                else
+                else if (op == add_literal<char_type>())
                 {
-                    std::error_code insert_ec;
-                    Json val = operation.at(detail::value_literal<char_type>());
-                    auto npath = jsonpointer::normalized_path(target,path);
-                    jsonpointer::insert(target,npath,val,insert_ec); // try insert without replace
-                    if (insert_ec) // try a replace
+                    bool replaced = false;
+                    Json displaced;
+                    if (operation.count(value_literal<char_type>()) != 1)
                     {
-                        std::error_code select_ec;
-                        Json orig_val = jsonpointer::get(target,npath,select_ec);
-                        if (select_ec) // shouldn't happen
+                        patch_ec = jsonpatch_errc::invalid_patch;
+                        unwinder.state = state_type::abort;
+                    }
+                    else if (ec)
+                    {
+                        patch_ec = jsonpatch_errc::add_failed;
+                        unwinder.state = state_type::abort;
+                    }
+                    else
+                    {
+                        normalize_destination(target, path);
+                        if (!add_value(target, path, patch_value(operation.at(value_literal<char_type>())), replaced, displaced))
                         {
                             patch_ec = jsonpatch_errc::add_failed;
-                            unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                            unwinder.state = state_type::abort;
                         }
                         else
                         {
-                            std::error_code replace_ec;
-                            jsonpointer::replace(target,npath,val,replace_ec);
-                            if (replace_ec)
-                            {
-                                patch_ec = jsonpatch_errc::add_failed;
-                                unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                            }
-                            else
-                            {
-                                unwinder.stack.push_back({detail::op_type::replace,npath,orig_val});
-                            }
+                            unwinder.record(replaced ? op_type::replace : op_type::remove, path, std::move(displaced));
                         }
                     }
-                    else // insert without replace succeeded
-                    {
-                        unwinder.stack.push_back({detail::op_type::remove,npath,Json::null()});
-                    }
                 }
-            }
-            else if (op ==jsoncons::jsonpatch::detail::remove_literal<char_type>())
-            {
-                std::error_code ec;
-                Json val = jsonpointer::get(target,path,ec);
-                if (ec)
-                {
-                    patch_ec = jsonpatch_errc::remove_failed;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                }
-                else
+                else if (op == remove_literal<char_type>())
                 {
-                    jsonpointer::remove(target,path,ec);
-                    if (ec)
+                    Json* val = ec ? nullptr : jsonpointer::detail::select_path(target, path, path.size(), ec);
+                    if (val == nullptr)
                     {
                         patch_ec = jsonpatch_errc::remove_failed;
-                        unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                        unwinder.state = state_type::abort;
                     }
                     else
                     {
-                        unwinder.stack.push_back({detail::op_type::add,string_type(path),val});
+                        unwinder.record(op_type::add, path, std::move(*val));
+                        jsonpointer::detail::parsed_remove(target, path, ec);
+                        if (ec)
+                        {
+                            patch_ec = jsonpatch_errc::remove_failed;
+                            unwinder.state = state_type::abort;
+                        }
                     }
                 }
-            }
-            else if (op ==jsoncons::jsonpatch::detail::replace_literal<char_type>())
-            {
-                std::error_code ec;
-                Json val = jsonpointer::get(target,path,ec);
-                if (ec)
-                {
-                    patch_ec = jsonpatch_errc::replace_failed;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                }
-                else if (operation.count(detail::value_literal<char_type>()) != 1)
+                else if (op == replace_literal<char_type>())
                 {
-                    patch_ec = jsonpatch_errc::invalid_patch;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                }
-                else
-                {
-                    jsonpointer::replace(target,path,operation.at(detail::value_literal<char_type>()),ec);
-                    if (ec)
+                    Json* val = ec ? nullptr : jsonpointer::detail::select_path(target, path, path.size(), ec);
+                    if (val == nullptr)
                     {
                         patch_ec = jsonpatch_errc::replace_failed;
-                        unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                        unwinder.state = state_type::abort;
+                    }
+                    else if (operation.count(value_literal<char_type>()) != 1)
+                    {
+                        patch_ec = jsonpatch_errc::invalid_patch;
+                        unwinder.state = state_type::abort;
                     }
                     else
                     {
-                        unwinder.stack.push_back({detail::op_type::replace,string_type(path),val});
+                        unwinder.record(op_type::replace, path, std::move(*val));
+                        *val = patch_value(operation.at(value_literal<char_type>()));
                     }
                 }
-            }
-            else if (op ==jsoncons::jsonpatch::detail::move_literal<char_type>())
-            {
-                if (operation.count(detail::from_literal<char_type>()) != 1)
-                {
-                    patch_ec = jsonpatch_errc::invalid_patch;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                }
-                else
+                else if (op == move_literal<char_type>())
                 {
-                    string_view_type from = operation.at(detail::from_literal<char_type>()).as_string_view();
-                    std::error_code ec;
-                    Json val = jsonpointer::get(target,from,ec);
-                    if (ec)
+                    if (operation.count(from_literal<char_type>()) != 1)
                     {
-                        patch_ec = jsonpatch_errc::move_failed;
-                        unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                        patch_ec = jsonpatch_errc::invalid_patch;
+                        unwinder.state = state_type::abort;
                     }
-                    else 
+                    else
                     {
-                        jsonpointer::remove(target,from,ec);
-                        if (ec)
+                        pointer_type from(operation.at(from_literal<char_type>()).as_string_view(), ec);
+                        Json* val = ec ? nullptr : jsonpointer::detail::select_path(target, from, from.size(), ec);
+                        if (val == nullptr)
                         {
                             patch_ec = jsonpatch_errc::move_failed;
-                            unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                            unwinder.state = state_type::abort;
                         }
-                        else
+                        else 
                         {
-                            unwinder.stack.push_back({detail::op_type::add,string_type(from),val});
-                            // add
-                            std::error_code insert_ec;
-                            auto npath = jsonpointer::normalized_path(target,path);
-                            jsonpointer::insert(target,npath,val,insert_ec); // try insert without replace
-                            if (insert_ec) // try a replace
+                            Json moved = std::move(*val);
+                            jsonpointer::detail::parsed_remove(target, from, ec);
+                            if (ec)
+                            {
+                                *val = std::move(moved);
+                                patch_ec = jsonpatch_errc::move_failed;
+                                unwinder.state = state_type::abort;
+                            }
+                            else
                             {
-                                std::error_code select_ec;
-                                Json orig_val = jsonpointer::get(target,npath,select_ec);
-                                if (select_ec) // shouldn't happen
+                                bool replaced = false;
+                                Json displaced;
+                                normalize_destination(target, path);
+                                if (!add_value(target, path, std::move(moved), replaced, displaced))
                                 {
+                                    std::error_code restore_ec;
+                                    jsonpointer::detail::parsed_insert(target, from, std::move(moved), true, restore_ec);
                                     patch_ec = jsonpatch_errc::copy_failed;
-                                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                                    unwinder.state = state_type::abort;
                                 }
                                 else
                                 {
-                                    std::error_code replace_ec;
-                                    jsonpointer::replace(target, npath, val, replace_ec);
-                                    if (replace_ec)
-                                    {
-                                        patch_ec = jsonpatch_errc::copy_failed;
-                                        unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-
-                                    }
-                                    else
-                                    {
-                                        unwinder.stack.push_back({jsoncons::jsonpatch::detail::op_type::replace,npath,orig_val });
-                                    }
-                                    
+                                    // On undo, the value at path is carried back to from
+                                    unwinder.record(op_type::add, from, Json(null_type()), true);
+                                    unwinder.record(replaced ? op_type::replace : op_type::remove, path, std::move(displaced), true);
                                 }
-                            }
-                            else
-                            {
-                                unwinder.stack.push_back({detail::op_type::remove,npath,Json::null()});
-                            }
-                        }           
+                            }           
+                        }
                     }
                 }
-            }
-            else if (op ==jsoncons::jsonpatch::detail::copy_literal<char_type>())
-            {
-                if (operation.count(detail::from_literal<char_type>()) != 1)
+                else if (op == copy_literal<char_type>())
                 {
-                    patch_ec = jsonpatch_errc::invalid_patch;
-                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                }
-                else
-                {
-                    std::error_code ec;
-                    string_view_type from = operation.at(detail::from_literal<char_type>()).as_string_view();
-                    Json val = jsonpointer::get(target,from,ec);
-                    if (ec)
+                    if (operation.count(from_literal<char_type>()) != 1)
                     {
-                        patch_ec = jsonpatch_errc::copy_failed;
-                        unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                        patch_ec = jsonpatch_errc::invalid_patch;
+                        unwinder.state = state_type::abort;
                     }
                     else
                     {
-                        // add
-                        auto npath = jsonpointer::normalized_path(target,path);
-                        std::error_code insert_ec;
-                        jsonpointer::insert(target,npath,val,insert_ec); // try insert without replace
-                        if (insert_ec) // Failed, try a replace
+                        pointer_type from(operation.at(from_literal<char_type>()).as_string_view(), ec);
+                        const Json* val = ec ? nullptr : jsonpointer::detail::select_path(static_cast<const Json&>(target), from, from.size(), ec);
+                        if (val == nullptr)
+                        {
+                            patch_ec = jsonpatch_errc::copy_failed;
+                            unwinder.state = state_type::abort;
+                        }
+                        else
                         {
-                            std::error_code select_ec;
-                            Json orig_val = jsonpointer::get(target,npath, select_ec);
-                            if (select_ec) // shouldn't happen
+                            bool replaced = false;
+                            Json displaced;
+                            Json copied(*val);
+                            normalize_destination(target, path);
+                            if (!add_value(target, path, std::move(copied), replaced, displaced))
                             {
                                 patch_ec = jsonpatch_errc::copy_failed;
-                                unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
+                                unwinder.state = state_type::abort;
                             }
-                            else 
+                            else
                             {
-                                std::error_code replace_ec;
-                                jsonpointer::replace(target, npath, val,replace_ec);
-                                if (replace_ec)
-                                {
-                                    patch_ec = jsonpatch_errc::copy_failed;
-                                    unwinder.state =jsoncons::jsonpatch::detail::state_type::abort;
-                                }
-                                else
-                                {
-                                    unwinder.stack.push_back({jsoncons::jsonpatch::detail::op_type::replace,npath,orig_val });
-                                }
+                                unwinder.record(replaced ? op_type::replace : op_type::remove, path, std::move(displaced));
                             }
                         }
-                        else
-                        {
-                            unwinder.stack.push_back({detail::op_type::remove,npath,Json::null()});
-                        }
                     }
                 }
+                if (unwinder.state != state_type::begin)
+                {
+                    bad_path = string_type(path_string);
+                }
             }
-            if (unwinder.state !=jsoncons::jsonpatch::detail::state_type::begin)
+            if (unwinder.state != state_type::begin)
             {
-                bad_path = string_type(path);
+                break;
             }
         }
-        if (unwinder.state !=jsoncons::jsonpatch::detail::state_type::begin)
+        if (unwinder.state == state_type::begin)
         {
-            break;
+            unwinder.state = state_type::commit;
         }
     }
-    if (unwinder.state ==jsoncons::jsonpatch::detail::state_type::begin)
-    {
-        unwinder.state =jsoncons::jsonpatch::detail::state_type::commit;
-    }
+
+} // namespace detail
+
+template <class Json>
+void apply_patch(Json& target, const Json& patch, std::error_code& ec)
+{
+    jsoncons::jsonpatch::detail::apply_patch(target, patch, apply_patch_options::none, ec);
+}
+
+template <class Json>
+void apply_patch(Json& target, const Json& patch, apply_patch_options options, std::error_code& ec)
+{
+    jsoncons::jsonpatch::detail::apply_patch(target, patch, options, ec);
+}
+
+// Values are moved out of the patch rather than copied
+template <class Json>
+void apply_patch(Json& target, Json&& patch, std::error_code& ec)
+{
+    jsoncons::jsonpatch::detail::apply_patch(target, patch, apply_patch_options::none, ec);
+}
+
+template <class Json>
+void apply_patch(Json& target, Json&& patch, apply_patch_options options, std::error_code& ec)
+{
+    jsoncons::jsonpatch::detail::apply_patch(target, patch, options, ec);
 }
 
 template <class Json>
@@ -480,10 +690,21 @@ Json from_diff(const Json& source, const Json& target)
 }
 
 template <class Json>
-void apply_patch(Json& target, const Json& patch)
+void apply_patch(Json& target, const Json& patch, apply_patch_options options = apply_patch_options::none)
+{
+    std::error_code ec;
+    apply_patch(target, patch, options, ec);
+    if (ec)
+    {
+        JSONCONS_THROW(jsonpatch_error(ec));
+    }
+}
+
+template <class Json>
+void apply_patch(Json& target, Json&& patch, apply_patch_options options = apply_patch_options::none)
 {
     std::error_code ec;
-    apply_patch(target, patch, ec);
+    apply_patch(target, std::move(patch), options, ec);
     if (ec)
     {
         JSONCONS_THROW(jsonpatch_error(ec));
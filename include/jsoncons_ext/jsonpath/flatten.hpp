@@ -19,31 +19,35 @@
 
 namespace jsoncons { namespace jsonpath {
 
-    template<class Json>
-    void flatten_(const std::basic_string<typename Json::char_type>& parent_key,
-                  const Json& parent_value,
-                  Json& result)
+    namespace detail {
+
+    // Walks value depth first, extending a single key buffer in place
+    template<class Json,class Callback>
+    void flatten_to(const Json& parent_value,
+                    std::basic_string<typename Json::char_type>& key,
+                    Callback& callback)
     {
         using char_type = typename Json::char_type;
         using string_type = std::basic_string<char_type>;
 
+        const std::size_t length = key.size();
         switch (parent_value.type())
         {
             case json_type::array_value:
             {
                 if (parent_value.empty())
                 {
-                    result.try_emplace(parent_key, parent_value);
+                    callback(key, parent_value);
                 }
                 else
                 {
                     for (std::size_t i = 0; i < parent_value.size(); ++i)
                     {
-                        string_type key(parent_key);
                         key.push_back('[');
                         jsoncons::detail::write_integer(i,key);
                         key.push_back(']');
-                        flatten_(key, parent_value.at(i), result);
+                        flatten_to(parent_value.at(i), key, callback);
+                        key.resize(length);
                     }
                 }
                 break;
@@ -53,20 +57,20 @@ namespace jsoncons { namespace jsonpath {
             {
                 if (parent_value.empty())
                 {
-                    result.try_emplace(parent_key, Json());
+                    callback(key, Json());
                 }
                 else
                 {
                     for (const auto& item : parent_value.object_range())
                     {
-                        string_type key(parent_key);
                         bool no_single_quote = item.key().find('\'') == string_type::npos;
                         key.push_back('[');
                         key.push_back(no_single_quote ? '\'' : '\"');
-                        std::copy(item.key().begin(),item.key().end(), std::back_inserter(key));
+                        key.append(item.key().data(), item.key().size());
                         key.push_back(no_single_quote ? '\'' : '\"');
                         key.push_back(']');
-                        flatten_(key, item.value(), result);
+                        flatten_to(item.value(), key, callback);
+                        key.resize(length);
                     }
                 }
                 break;
@@ -74,19 +78,31 @@ namespace jsoncons { namespace jsonpath {
 
             default:
             {
-                result[parent_key] = parent_value;
+                callback(key, parent_value);
                 break;
             }
         }
     }
 
+    } // namespace detail
+
     template<class Json>
     Json flatten(const Json& value)
     {
-        Json result;
-        std::basic_string<typename Json::char_type> parent_key = {'$'};
-        flatten_(parent_key, value, result);
-        return result;
+        using string_type = std::basic_string<typename Json::char_type>;
+
+        // Collect the pairs and build the result object once, rather than
+        // inserting into a sorted object leaf by leaf
+        std::vector<std::pair<string_type,Json>> members;
+        auto callback = [&members](const string_type& key, const Json& val)
+        {
+            members.emplace_back(key, val);
+        };
+        string_type parent_key = {'$'};
+        detail::flatten_to(value, parent_key, callback);
+        return Json(json_object_arg, 
+                    std::make_move_iterator(members.begin()), 
+                    std::make_move_iterator(members.end()));
     }
 
     enum class unflatten_state 
@@ -15,7 +15,7 @@
 #include <limits> // std::numeric_limits
 #include <utility> // std::move
 #include <regex>
-#include <set> // std::set
+#include <unordered_set> // std::unordered_set
 #include <iterator> // std::make_move_iterator
 #include <jsoncons/json.hpp>
 #include <jsoncons_ext/jsonpath/jsonpath_filter.hpp>
@@ -231,11 +231,19 @@ class jsonpath_evaluator : public ser_context
     };
     using node_set = std::vector<node_type>;
 
-    struct node_less
+    struct value_ptr_hash
     {
-        bool operator()(const node_type& a, const node_type& b) const
+        std::size_t operator()(const Json* p) const
         {
-            return *(a.val_ptr) < *(b.val_ptr);
+            return std::hash<Json>()(*p);
+        }
+    };
+
+    struct value_ptr_equal
+    {
+        bool operator()(const Json* a, const Json* b) const
+        {
+            return *a == *b;
         }
     };
 
@@ -1756,14 +1764,13 @@ public:
     {
         if (state_stack_.back().is_union)
         {
-            std::set<node_type, node_less> index;
+            std::unordered_set<const Json*, value_ptr_hash, value_ptr_equal> index;
             std::vector<node_type> temp;
-            for (const auto& node : nodes_)
+            for (auto& node : nodes_)
             {
-                if (index.count(node) == 0)
+                if (index.insert(node.val_ptr).second)
                 {
-                    temp.emplace_back(node);
-                    index.emplace(node);
+                    temp.emplace_back(std::move(node));
                 }
             }
             stack_.emplace_back(std::move(temp));
@@ -9,6 +9,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 #include <memory>
 #include <iostream>
 #include <iterator>
@@ -328,6 +329,216 @@ enum class pointer_state
     JSONCONS_DEPRECATED_MSG("Instead, use json_ptr") typedef json_ptr address;
     #endif
 
+    // basic_json_ptr_token
+
+    template <class CharT>
+    class basic_json_ptr_token
+    {
+    public:
+        using char_type = CharT;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+    private:
+        string_type name_;
+        std::size_t index_;
+        bool is_index_;
+    public:
+        explicit basic_json_ptr_token(string_type&& name)
+            : name_(std::move(name)), index_(0), is_index_(false)
+        {
+            if (jsoncons::detail::is_base10(name_.data(), name_.length()))
+            {
+                auto result = jsoncons::detail::to_integer<std::size_t>(name_.data(), name_.length());
+                if (result)
+                {
+                    index_ = result.value();
+                    is_index_ = true;
+                }
+            }
+        }
+
+        // The unescaped reference token
+        const string_type& name() const
+        {
+            return name_;
+        }
+
+        // true if the token is a valid array index
+        bool is_index() const
+        {
+            return is_index_;
+        }
+
+        // true if the token is "-", one past the last array element
+        bool is_past_end() const
+        {
+            return name_.size() == 1 && name_[0] == '-';
+        }
+
+        std::size_t index() const
+        {
+            return index_;
+        }
+
+        friend bool operator==(const basic_json_ptr_token& lhs, const basic_json_ptr_token& rhs)
+        {
+            return lhs.name_ == rhs.name_;
+        }
+
+        friend bool operator!=(const basic_json_ptr_token& lhs, const basic_json_ptr_token& rhs)
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    // basic_parsed_json_ptr
+
+    template <class CharT>
+    class basic_parsed_json_ptr
+    {
+    public:
+        using char_type = CharT;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+        using token_type = basic_json_ptr_token<char_type>;
+        using const_iterator = typename std::vector<token_type>::const_iterator;
+        using iterator = const_iterator;
+    private:
+        std::vector<token_type> tokens_;
+    public:
+        // Constructors
+        basic_parsed_json_ptr()
+        {
+        }
+
+        explicit basic_parsed_json_ptr(const string_view_type& s)
+        {
+            std::error_code ec;
+            parse(s, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(jsonpointer_error(ec));
+            }
+        }
+
+        basic_parsed_json_ptr(const string_view_type& s, std::error_code& ec)
+        {
+            parse(s, ec);
+        }
+
+        explicit basic_parsed_json_ptr(const basic_json_ptr<char_type>& ptr)
+            : basic_parsed_json_ptr(string_view_type(ptr))
+        {
+        }
+
+        basic_parsed_json_ptr(const basic_parsed_json_ptr&) = default;
+
+        basic_parsed_json_ptr(basic_parsed_json_ptr&&) = default;
+
+        basic_parsed_json_ptr& operator=(const basic_parsed_json_ptr&) = default;
+
+        basic_parsed_json_ptr& operator=(basic_parsed_json_ptr&&) = default;
+
+        // Modifiers
+
+        basic_parsed_json_ptr& operator/=(const string_type& token)
+        {
+            tokens_.emplace_back(string_type(token));
+            return *this;
+        }
+
+        void pop_back()
+        {
+            tokens_.pop_back();
+        }
+
+        // Accessors
+        bool empty() const
+        {
+            return tokens_.empty();
+        }
+
+        std::size_t size() const
+        {
+            return tokens_.size();
+        }
+
+        const token_type& operator[](std::size_t i) const
+        {
+            return tokens_[i];
+        }
+
+        // Iterators
+        iterator begin() const
+        {
+            return tokens_.begin();
+        }
+        iterator end() const
+        {
+            return tokens_.end();
+        }
+
+        string_type string() const
+        {
+            string_type s;
+            for (const auto& token : tokens_)
+            {
+                s.push_back('/');
+                s.append(escape_string(token.name()));
+            }
+            return s;
+        }
+
+        friend bool operator==(const basic_parsed_json_ptr& lhs, const basic_parsed_json_ptr& rhs)
+        {
+            return lhs.tokens_ == rhs.tokens_;
+        }
+
+        friend bool operator!=(const basic_parsed_json_ptr& lhs, const basic_parsed_json_ptr& rhs)
+        {
+            return !(lhs == rhs);
+        }
+    private:
+        void parse(const string_view_type& s, std::error_code& ec)
+        {
+            if (!s.empty() && s[0] != '/')
+            {
+                ec = jsonpointer_errc::expected_slash;
+                return;
+            }
+
+            string_type buffer;
+            for (std::size_t i = 1; i <= s.size(); ++i)
+            {
+                if (i == s.size() || s[i] == '/')
+                {
+                    tokens_.emplace_back(std::move(buffer));
+                    buffer = string_type();
+                }
+                else if (s[i] == '~')
+                {
+                    if (++i < s.size() && (s[i] == '0' || s[i] == '1'))
+                    {
+                        buffer.push_back(s[i] == '0' ? '~' : '/');
+                    }
+                    else
+                    {
+                        ec = jsonpointer_errc::expected_0_or_1;
+                        tokens_.clear();
+                        return;
+                    }
+                }
+                else
+                {
+                    buffer.push_back(s[i]);
+                }
+            }
+        }
+    };
+
+    using parsed_json_ptr = basic_parsed_json_ptr<char>;
+    using parsed_wjson_ptr = basic_parsed_json_ptr<wchar_t>;
+
     namespace detail {
 
     template <class J,class JReference>
@@ -866,6 +1077,437 @@ enum class pointer_state
         evaluator.replace(root, path, value, ec);
     }
 
+    namespace detail {
+
+    // Selects the child of current referenced by token, or returns nullptr and sets ec
+    template <class J,class CharT>
+    J* select_child(J& current, const basic_json_ptr_token<CharT>& token, std::error_code& ec)
+    {
+        if (current.is_array())
+        {
+            if (token.is_past_end())
+            {
+                ec = jsonpointer_errc::index_exceeds_array_size;
+                return nullptr;
+            }
+            if (!token.is_index())
+            {
+                ec = jsonpointer_errc::invalid_index;
+                return nullptr;
+            }
+            if (token.index() >= current.size())
+            {
+                ec = jsonpointer_errc::index_exceeds_array_size;
+                return nullptr;
+            }
+            return std::addressof(current.at(token.index()));
+        }
+        else if (current.is_object())
+        {
+            auto it = current.find(token.name());
+            if (it == current.object_range().end())
+            {
+                ec = jsonpointer_errc::name_not_found;
+                return nullptr;
+            }
+            return std::addressof(it->value());
+        }
+        else
+        {
+            ec = jsonpointer_errc::expected_object_or_array;
+            return nullptr;
+        }
+    }
+
+    // Resolves the first count tokens of ptr starting from root
+    template <class J,class CharT>
+    J* select_path(J& root, const basic_parsed_json_ptr<CharT>& ptr, std::size_t count, std::error_code& ec)
+    {
+        J* current = std::addressof(root);
+        for (std::size_t i = 0; i < count && current != nullptr; ++i)
+        {
+            current = select_child(*current, ptr[i], ec);
+        }
+        return current;
+    }
+
+    template <class J,class CharT,class T>
+    void parsed_insert(J& root, const basic_parsed_json_ptr<CharT>& ptr, T&& value, bool assign, std::error_code& ec)
+    {
+        if (ptr.empty())
+        {
+            if (assign)
+            {
+                root = std::forward<T>(value);
+            }
+            else
+            {
+                ec = jsonpointer_errc::key_already_exists;
+            }
+            return;
+        }
+        J* parent = select_path(root, ptr, ptr.size()-1, ec);
+        if (parent == nullptr)
+        {
+            return;
+        }
+        const auto& token = ptr[ptr.size()-1];
+        if (parent->is_array())
+        {
+            if (token.is_past_end())
+            {
+                parent->push_back(std::forward<T>(value));
+            }
+            else if (!token.is_index())
+            {
+                ec = jsonpointer_errc::invalid_index;
+            }
+            else if (token.index() > parent->size())
+            {
+                ec = jsonpointer_errc::index_exceeds_array_size;
+            }
+            else if (token.index() == parent->size())
+            {
+                parent->push_back(std::forward<T>(value));
+            }
+            else
+            {
+                parent->insert(parent->array_range().begin()+token.index(), std::forward<T>(value));
+            }
+        }
+        else if (parent->is_object())
+        {
+            if (!assign && parent->contains(token.name()))
+            {
+                ec = jsonpointer_errc::key_already_exists;
+            }
+            else
+            {
+                parent->insert_or_assign(token.name(), std::forward<T>(value));
+            }
+        }
+        else
+        {
+            ec = jsonpointer_errc::expected_object_or_array;
+        }
+    }
+
+    template <class J,class CharT,class T>
+    void parsed_replace(J& root, const basic_parsed_json_ptr<CharT>& ptr, T&& value, std::error_code& ec)
+    {
+        J* target = select_path(root, ptr, ptr.size(), ec);
+        if (target != nullptr)
+        {
+            *target = std::forward<T>(value);
+        }
+    }
+
+    template <class J,class CharT>
+    void parsed_remove(J& root, const basic_parsed_json_ptr<CharT>& ptr, std::error_code& ec)
+    {
+        if (ptr.empty())
+        {
+            ec = jsonpointer_errc::expected_object_or_array;
+            return;
+        }
+        J* parent = select_path(root, ptr, ptr.size()-1, ec);
+        if (parent == nullptr)
+        {
+            return;
+        }
+        const auto& token = ptr[ptr.size()-1];
+        if (parent->is_array())
+        {
+            if (token.is_past_end())
+            {
+                ec = jsonpointer_errc::index_exceeds_array_size;
+            }
+            else if (!token.is_index())
+            {
+                ec = jsonpointer_errc::invalid_index;
+            }
+            else if (token.index() >= parent->size())
+            {
+                ec = jsonpointer_errc::index_exceeds_array_size;
+            }
+            else
+            {
+                parent->erase(parent->array_range().begin()+token.index());
+            }
+        }
+        else if (parent->is_object())
+        {
+            auto it = parent->find(token.name());
+            if (it == parent->object_range().end())
+            {
+                ec = jsonpointer_errc::name_not_found;
+            }
+            else
+            {
+                parent->erase(it);
+            }
+        }
+        else
+        {
+            ec = jsonpointer_errc::expected_object_or_array;
+        }
+    }
+
+    } // namespace detail
+
+    // Overloads taking a pre-parsed pointer, which may be resolved repeatedly
+    // without re-tokenizing the pointer string
+
+    template<class J>
+    J& get(J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr, std::error_code& ec)
+    {
+        J* result = detail::select_path(root, ptr, ptr.size(), ec);
+        return result != nullptr ? *result : root;
+    }
+
+    template<class J>
+    const J& get(const J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr, std::error_code& ec)
+    {
+        const J* result = detail::select_path(root, ptr, ptr.size(), ec);
+        return result != nullptr ? *result : root;
+    }
+
+    template<class J>
+    J& get(J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr)
+    {
+        std::error_code ec;
+        J& result = get(root, ptr, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+        return result;
+    }
+
+    template<class J>
+    const J& get(const J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr)
+    {
+        std::error_code ec;
+        const J& result = get(root, ptr, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+        return result;
+    }
+
+    template<class J>
+    bool contains(const J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr)
+    {
+        std::error_code ec;
+        return detail::select_path(root, ptr, ptr.size(), ec) != nullptr;
+    }
+
+    template<class J>
+    void insert_or_assign(J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr, const J& value, std::error_code& ec)
+    {
+        detail::parsed_insert(root, ptr, value, true, ec);
+    }
+
+    template<class J>
+    void insert_or_assign(J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr, const J& value)
+    {
+        std::error_code ec;
+        detail::parsed_insert(root, ptr, value, true, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+    }
+
+    template<class J>
+    void insert(J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr, const J& value, std::error_code& ec)
+    {
+        detail::parsed_insert(root, ptr, value, false, ec);
+    }
+
+    template<class J>
+    void insert(J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr, const J& value)
+    {
+        std::error_code ec;
+        detail::parsed_insert(root, ptr, value, false, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+    }
+
+    template<class J>
+    void replace(J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr, const J& value, std::error_code& ec)
+    {
+        detail::parsed_replace(root, ptr, value, ec);
+    }
+
+    template<class J>
+    void replace(J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr, const J& value)
+    {
+        std::error_code ec;
+        detail::parsed_replace(root, ptr, value, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+    }
+
+    template<class J>
+    void remove(J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr, std::error_code& ec)
+    {
+        detail::parsed_remove(root, ptr, ec);
+    }
+
+    template<class J>
+    void remove(J& root, const basic_parsed_json_ptr<typename J::char_type>& ptr)
+    {
+        std::error_code ec;
+        detail::parsed_remove(root, ptr, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+    }
+
+    // basic_json_ptr_batch
+
+    // Resolves many pointers against a document in a single walk. Pointers are
+    // merged into a trie so that shared prefixes are resolved only once.
+    template <class CharT>
+    class basic_json_ptr_batch
+    {
+    public:
+        using char_type = CharT;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+        using pointer_type = basic_parsed_json_ptr<char_type>;
+        using token_type = basic_json_ptr_token<char_type>;
+    private:
+        struct node
+        {
+            // Position of this node's token, as pointer id and token index
+            std::size_t pointer_id;
+            std::size_t token_pos;
+            std::vector<std::size_t> children;
+            std::vector<std::size_t> ids;
+
+            node(std::size_t pointer_id, std::size_t token_pos)
+                : pointer_id(pointer_id), token_pos(token_pos)
+            {
+            }
+        };
+
+        std::vector<pointer_type> pointers_;
+        std::vector<node> nodes_;
+        bool built_;
+    public:
+        basic_json_ptr_batch()
+            : built_(false)
+        {
+        }
+
+        // Adds a pointer and returns its position in the result of resolve
+        std::size_t add(const pointer_type& ptr)
+        {
+            pointers_.push_back(ptr);
+            built_ = false;
+            return pointers_.size() - 1;
+        }
+
+        std::size_t add(pointer_type&& ptr)
+        {
+            pointers_.push_back(std::move(ptr));
+            built_ = false;
+            return pointers_.size() - 1;
+        }
+
+        std::size_t add(const string_view_type& s)
+        {
+            return add(pointer_type(s));
+        }
+
+        std::size_t size() const
+        {
+            return pointers_.size();
+        }
+
+        const pointer_type& operator[](std::size_t i) const
+        {
+            return pointers_[i];
+        }
+
+        // Returns one entry per added pointer, nullptr for pointers that do not resolve
+        template <class J>
+        std::vector<J*> resolve(J& root)
+        {
+            std::vector<J*> results(pointers_.size(), nullptr);
+            if (pointers_.empty())
+            {
+                return results;
+            }
+            if (!built_)
+            {
+                build();
+            }
+            resolve_node(root, 0, results);
+            return results;
+        }
+    private:
+        void build()
+        {
+            // Child of each node by token, so that a node with many children is searched in log time
+            std::map<std::pair<std::size_t,string_view_type>,std::size_t> child_index;
+
+            nodes_.clear();
+            nodes_.emplace_back(0, 0);
+            for (std::size_t id = 0; id < pointers_.size(); ++id)
+            {
+                std::size_t current = 0;
+                for (std::size_t pos = 0; pos < pointers_[id].size(); ++pos)
+                {
+                    const token_type& token = pointers_[id][pos];
+                    auto result = child_index.emplace(std::make_pair(current, string_view_type(token.name())), nodes_.size());
+                    if (result.second)
+                    {
+                        nodes_.emplace_back(id, pos);
+                        nodes_[current].children.push_back(result.first->second);
+                    }
+                    current = result.first->second;
+                }
+                nodes_[current].ids.push_back(id);
+            }
+            built_ = true;
+        }
+
+        const token_type& token_of(const node& n) const
+        {
+            return pointers_[n.pointer_id][n.token_pos];
+        }
+
+        template <class J>
+        void resolve_node(J& value, std::size_t index, std::vector<J*>& results) const
+        {
+            const node& n = nodes_[index];
+            for (auto id : n.ids)
+            {
+                results[id] = std::addressof(value);
+            }
+            for (auto child : n.children)
+            {
+                std::error_code ec;
+                J* p = detail::select_child(value, token_of(nodes_[child]), ec);
+                if (p != nullptr)
+                {
+                    resolve_node(*p, child, results);
+                }
+            }
+        }
+    };
+
+    using json_ptr_batch = basic_json_ptr_batch<char>;
+    using wjson_ptr_batch = basic_json_ptr_batch<wchar_t>;
+
     template <class String,class Result>
     typename std::enable_if<std::is_convertible<typename String::value_type,typename Result::value_type>::value>::type
     escape(const String& s, Result& result)
@@ -916,14 +1558,19 @@ enum class pointer_state
 
     // flatten
 
-    template<class Json>
-    void flatten_(const std::basic_string<typename Json::char_type>& parent_key,
-                  const Json& parent_value,
-                  Json& result)
+    namespace detail {
+
+    // Walks value depth first, extending a single key buffer in place, and
+    // passes each JSON Pointer-value pair to callback
+    template<class Json,class Callback>
+    void flatten_to(const Json& parent_value,
+                    std::basic_string<typename Json::char_type>& key,
+                    Callback& callback)
     {
         using char_type = typename Json::char_type;
-        using string_type = std::basic_string<char_type>;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
 
+        const std::size_t length = key.size();
         switch (parent_value.type())
         {
             case json_type::array_value:
@@ -931,16 +1578,16 @@ enum class pointer_state
                 if (parent_value.empty())
                 {
                     // Flatten empty array to null
-                    result.try_emplace(parent_key, null_type{});
+                    callback(string_view_type(key.data(), key.size()), Json::null());
                 }
                 else
                 {
                     for (std::size_t i = 0; i < parent_value.size(); ++i)
                     {
-                        string_type key(parent_key);
                         key.push_back('/');
                         jsoncons::detail::write_integer(i,key);
-                        flatten_(key, parent_value.at(i), result);
+                        flatten_to(parent_value.at(i), key, callback);
+                        key.resize(length);
                     }
                 }
                 break;
@@ -951,16 +1598,16 @@ enum class pointer_state
                 if (parent_value.empty())
                 {
                     // Flatten empty object to null
-                    result.try_emplace(parent_key, null_type{});
+                    callback(string_view_type(key.data(), key.size()), Json::null());
                 }
                 else
                 {
                     for (const auto& item : parent_value.object_range())
                     {
-                        string_type key(parent_key);
                         key.push_back('/');
-                        escape(jsoncons::basic_string_view<char_type>(item.key().data(),item.key().size()), key);
-                        flatten_(key, item.value(), result);
+                        escape(string_view_type(item.key().data(),item.key().size()), key);
+                        flatten_to(item.value(), key, callback);
+                        key.resize(length);
                     }
                 }
                 break;
@@ -969,22 +1616,43 @@ enum class pointer_state
             default:
             {
                 // add primitive parent_value with its reference string
-                result[parent_key] = parent_value;
+                callback(string_view_type(key.data(), key.size()), parent_value);
                 break;
             }
         }
     }
 
+    } // namespace detail
+
+    // Calls callback(const string_view_type& pointer, const Json& value) for each 
+    // leaf of value, in document order, without building a flattened object.
+    // The pointer view is only valid for the duration of the call.
+    template<class Json,class Callback>
+    void flatten_to(const Json& value, Callback callback)
+    {
+        std::basic_string<typename Json::char_type> key;
+        detail::flatten_to(value, key, callback);
+    }
+
     template<class Json>
     Json flatten(const Json& value)
     {
-        Json result;
-        std::basic_string<typename Json::char_type> parent_key;
-        flatten_(parent_key, value, result);
-        return result;
+        using string_type = std::basic_string<typename Json::char_type>;
+        using string_view_type = typename Json::string_view_type;
+
+        // Collect the pairs and build the result object once, rather than
+        // inserting into a sorted object leaf by leaf
+        std::vector<std::pair<string_type,Json>> members;
+        flatten_to(value, 
+                   [&members](const string_view_type& key, const Json& val)
+                   {
+                       members.emplace_back(string_type(key.data(), key.size()), val);
+                   });
+        return Json(json_object_arg, 
+                    std::make_move_iterator(members.begin()), 
+                    std::make_move_iterator(members.end()));
     }
 
-
     // unflatten
 
     enum class unflatten_options {none,assume_object = 1
@@ -1139,6 +1807,227 @@ enum class pointer_state
         return options == unflatten_options::none ? safe_unflatten (result) : result;
     }
 
+    namespace detail {
+
+    // Splits a JSON Pointer into tokens, reusing the strings already in tokens.
+    // Returns the number of tokens.
+    template <class CharT>
+    std::size_t split_pointer(const jsoncons::basic_string_view<CharT>& s, 
+                              std::vector<std::basic_string<CharT>>& tokens)
+    {
+        if (!s.empty() && s[0] != '/')
+        {
+            JSONCONS_THROW(jsonpointer_error(jsonpointer_errc::expected_slash));
+        }
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < s.size(); ++i)
+        {
+            if (s[i] == '/')
+            {
+                if (count == tokens.size())
+                {
+                    tokens.emplace_back();
+                }
+                tokens[count++].clear();
+            }
+            else if (s[i] == '~')
+            {
+                if (++i < s.size() && (s[i] == '0' || s[i] == '1'))
+                {
+                    tokens[count-1].push_back(s[i] == '0' ? '~' : '/');
+                }
+                else
+                {
+                    JSONCONS_THROW(jsonpointer_error(jsonpointer_errc::expected_0_or_1));
+                }
+            }
+            else
+            {
+                tokens[count-1].push_back(s[i]);
+            }
+        }
+        return count;
+    }
+
+    // Returns true if token is an array index without leading zeros
+    template <class CharT>
+    bool is_index_token(const jsoncons::basic_string_view<CharT>& token, std::size_t& index)
+    {
+        if (token.empty() || (token.size() > 1 && token[0] == '0'))
+        {
+            return false;
+        }
+        auto r = jsoncons::detail::to_integer<std::size_t>(token.data(), token.size());
+        if (!r)
+        {
+            return false;
+        }
+        index = r.value();
+        return true;
+    }
+
+    // Returns the child of parent at token, creating it if necessary. A null parent
+    // becomes an array if the token is "0", otherwise an object. An array receiving
+    // a token that is not its next index is converted to an object.
+    template <class Json>
+    Json& unflatten_child(Json& parent, const std::basic_string<typename Json::char_type>& token, 
+                          unflatten_options options)
+    {
+        using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+
+        if (parent.is_null())
+        {
+            if (options == unflatten_options::none && token.size() == 1 && token[0] == '0')
+            {
+                parent = Json(json_array_arg);
+            }
+            else
+            {
+                parent = Json(json_object_arg);
+            }
+        }
+        if (parent.is_array())
+        {
+            std::size_t index = 0;
+            bool is_index = is_index_token(jsoncons::basic_string_view<char_type>(token.data(), token.size()), index);
+            if (is_index && index < parent.size())
+            {
+                return parent.at(index);
+            }
+            if (is_index && index == parent.size())
+            {
+                return parent.emplace_back(null_type());
+            }
+            Json obj(json_object_arg);
+            for (std::size_t i = 0; i < parent.size(); ++i)
+            {
+                string_type key;
+                jsoncons::detail::write_integer(i, key);
+                obj.try_emplace(key, std::move(parent.at(i)));
+            }
+            parent = std::move(obj);
+        }
+        if (!parent.is_object())
+        {
+            JSONCONS_THROW(jsonpointer_error(jsonpointer_errc::invalid_flattened_key));
+        }
+        return parent.try_emplace(token, null_type()).first->value();
+    }
+
+    // Converts the objects in value whose keys are exactly the indexes 0 to n-1 back
+    // into arrays, so that the result does not depend on the order the pairs arrived in
+    template <class Json>
+    void restore_arrays(Json& value)
+    {
+        using char_type = typename Json::char_type;
+
+        if (value.is_array())
+        {
+            for (auto& item : value.array_range())
+            {
+                restore_arrays(item);
+            }
+        }
+        else if (value.is_object())
+        {
+            for (auto& item : value.object_range())
+            {
+                restore_arrays(item.value());
+            }
+            if (value.empty())
+            {
+                return;
+            }
+            std::vector<bool> seen(value.size(), false);
+            for (const auto& item : value.object_range())
+            {
+                std::size_t index = 0;
+                if (!is_index_token(jsoncons::basic_string_view<char_type>(item.key().data(), item.key().size()), index) 
+                    || index >= seen.size() || seen[index])
+                {
+                    return;
+                }
+                seen[index] = true;
+            }
+            Json a(json_array_arg);
+            a.resize(value.size());
+            for (auto& item : value.object_range())
+            {
+                std::size_t index = 0;
+                is_index_token(jsoncons::basic_string_view<char_type>(item.key().data(), item.key().size()), index);
+                a[index] = std::move(item.value());
+            }
+            value = std::move(a);
+        }
+    }
+
+    } // namespace detail
+
+    // Builds a json value from a range of JSON Pointer-value pairs in a single pass.
+    // Pairs in the order produced by flatten_to, that is, with pairs sharing a prefix
+    // adjacent and array elements in index order, take constant time apart from the
+    // key search in a sorted object. Arrays that could not be built in place are
+    // recovered afterwards from objects whose keys are the indexes 0 to n-1.
+    template<class Json,class InputIt>
+    Json unflatten(InputIt first, InputIt last, unflatten_options options = unflatten_options::none)
+    {
+        using char_type = typename Json::char_type;
+        using string_type = std::basic_string<char_type>;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+
+        Json result = Json(null_type());
+
+        // The path of the most recently added value, and the containers along it 
+        std::vector<string_type> path;
+        std::size_t path_length = 0;
+        std::vector<Json*> containers;
+
+        std::vector<string_type> tokens;
+        for (; first != last; ++first)
+        {
+            const auto& key = first->first;
+            std::size_t count = detail::split_pointer(string_view_type(key.data(), key.size()), tokens);
+            if (count == 0)
+            {
+                result = first->second;
+                path_length = 0;
+                continue;
+            }
+
+            // Keep the containers along the common prefix with the previous path
+            std::size_t common = 0;
+            while (common < count-1 && common < path_length && tokens[common] == path[common])
+            {
+                ++common;
+            }
+            containers.resize(common);
+            Json* current = common == 0 ? std::addressof(result) : containers.back();
+            for (std::size_t i = common; i < count-1; ++i)
+            {
+                current = std::addressof(detail::unflatten_child(*current, tokens[i], options));
+                containers.push_back(current);
+            }
+            detail::unflatten_child(*current, tokens[count-1], options) = first->second;
+
+            if (path.size() < count)
+            {
+                path.resize(count);
+            }
+            for (std::size_t i = common; i < count; ++i)
+            {
+                path[i] = tokens[i];
+            }
+            path_length = count - 1;
+        }
+
+        if (options == unflatten_options::none)
+        {
+            detail::restore_arrays(result);
+        }
+        return result.is_null() ? Json() : result;
+    }
+
     template<class Json>
     Json unflatten(const Json& value, unflatten_options options = unflatten_options::none)
     {
@@ -74,6 +74,108 @@ namespace msgpack {
         }
     }
 
+    // to exactly sized bytes
+
+    template<class T>
+    typename std::enable_if<is_basic_json<T>::value,void>::type 
+    encode_msgpack(exact_size_arg_t,
+                   const T& j, 
+                   std::vector<uint8_t>& v, 
+                   const msgpack_encode_options& options = msgpack_encode_options())
+    {
+        // Measure the output, then write it into v grown once by exactly that length
+        using char_type = typename T::char_type;
+        std::size_t length = 0;
+        {
+            basic_msgpack_encoder<jsoncons::counting_sink<uint8_t>> encoder(length, options);
+            auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
+            j.dump(adaptor);
+        }
+        // On failure v is restored to its original size
+        std::size_t offset = v.size();
+        v.resize(offset + length);
+        JSONCONS_TRY
+        {
+            basic_msgpack_encoder<jsoncons::unchecked_sink<uint8_t>> encoder(v.data() + offset, options);
+            auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
+            j.dump(adaptor);
+        }
+        JSONCONS_CATCH(...)
+        {
+            v.resize(offset);
+            JSONCONS_RETHROW;
+        }
+    }
+
+    template<class T>
+    typename std::enable_if<!is_basic_json<T>::value,void>::type 
+    encode_msgpack(exact_size_arg_t,
+                   const T& val, 
+                   std::vector<uint8_t>& v, 
+                   const msgpack_encode_options& options = msgpack_encode_options())
+    {
+        std::size_t length = 0;
+        std::error_code ec;
+        {
+            basic_msgpack_encoder<jsoncons::counting_sink<uint8_t>> encoder(length, options);
+            ser_traits<T,char>::serialize(val, encoder, json(), ec);
+        }
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+        // On failure v is restored to its original size
+        std::size_t offset = v.size();
+        v.resize(offset + length);
+        JSONCONS_TRY
+        {
+            basic_msgpack_encoder<jsoncons::unchecked_sink<uint8_t>> encoder(v.data() + offset, options);
+            ser_traits<T,char>::serialize(val, encoder, json(), ec);
+        }
+        JSONCONS_CATCH(...)
+        {
+            v.resize(offset);
+            JSONCONS_RETHROW;
+        }
+        if (ec)
+        {
+            v.resize(offset);
+            JSONCONS_THROW(ser_error(ec));
+        }
+    }
+
+    // to gather buffer
+
+    template<class T>
+    typename std::enable_if<is_basic_json<T>::value,void>::type 
+    encode_msgpack(const T& j, 
+                   gather_buffer<uint8_t>& buf, 
+                   const msgpack_encode_options& options = msgpack_encode_options())
+    {
+        // The strings and byte strings of j outlive the segments, so long ones are referenced
+        using char_type = typename T::char_type;
+        using sink_type = jsoncons::detail::byte_gather_sink_t<char_type>;
+        basic_msgpack_encoder<sink_type> encoder(sink_type(buf), options);
+        auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
+        j.dump(adaptor);
+    }
+
+    template<class T>
+    typename std::enable_if<!is_basic_json<T>::value,void>::type 
+    encode_msgpack(const T& val, 
+                   gather_buffer<uint8_t>& buf, 
+                   const msgpack_encode_options& options = msgpack_encode_options())
+    {
+        // ser_traits may pass strings of temporaries, so all output is copied
+        basic_msgpack_encoder<gather_sink<uint8_t>> encoder(gather_sink<uint8_t>(buf), options);
+        std::error_code ec;
+        ser_traits<T,char>::serialize(val, encoder, json(), ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+    }
+
     // with temp_allocator_arg_t
 
     template<class T,class TempAllocator>
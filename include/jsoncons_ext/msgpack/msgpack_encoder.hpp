@@ -278,7 +278,7 @@ namespace msgpack {
 
         void write_string_value(const string_view_type& sv) 
         {
-            auto sink = unicons::validate(sv.begin(), sv.end());
+            auto sink = unicons::validate(sv.data(), sv.data() + sv.size());
             if (sink.ec != unicons::conv_errc())
             {
                 JSONCONS_THROW(ser_error(msgpack_errc::invalid_utf8_text_string));
@@ -309,10 +309,7 @@ namespace msgpack {
                 jsoncons::detail::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
             }
 
-            for (auto c : sv)
-            {
-                sink_.push_back(c);
-            }
+            jsoncons::detail::append_external(sink_, reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
         }
 
         bool visit_byte_string(const byte_string_view& b, 
@@ -341,10 +338,7 @@ namespace msgpack {
                 jsoncons::detail::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
             }
 
-            for (auto c : b)
-            {
-                sink_.push_back(c);
-            }
+            jsoncons::detail::append_external(sink_, b.data(), b.size());
 
             end_value();
             return true;
@@ -24,7 +24,8 @@ enum class msgpack_errc
     too_few_items,
     max_nesting_depth_exceeded,
     length_is_negative,
-    unknown_type
+    unknown_type,
+    max_buffered_bytes_exceeded
 };
 
 class msgpack_error_category_impl
@@ -59,6 +60,8 @@ public:
                 return "Request for the length of an array, map or string returned a negative result";
             case msgpack_errc::unknown_type:
                 return "An unknown type was found in the stream";
+            case msgpack_errc::max_buffered_bytes_exceeded:
+                return "Partial data item exceeds buffer limit in options";
             default:
                 return "Unknown MessagePack parser error";
         }
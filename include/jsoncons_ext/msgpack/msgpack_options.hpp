@@ -43,9 +43,17 @@ public:
 class msgpack_decode_options : public virtual msgpack_options_common
 {
     friend class msgpack_options;
+
+    std::size_t max_buffered_bytes_;
 public:
     msgpack_decode_options()
+        : max_buffered_bytes_(1024*1024)
+    {
+    }
+
+    std::size_t max_buffered_bytes() const 
     {
+        return max_buffered_bytes_;
     }
 };
 
@@ -62,12 +70,19 @@ class msgpack_options final : public msgpack_decode_options, public msgpack_enco
 {
 public:
     using msgpack_options_common::max_nesting_depth;
+    using msgpack_decode_options::max_buffered_bytes;
 
     msgpack_options& max_nesting_depth(int value)
     {
         this->max_nesting_depth_ = value;
         return *this;
     }
+
+    msgpack_options& max_buffered_bytes(std::size_t value)
+    {
+        this->max_buffered_bytes_ = value;
+        return *this;
+    }
 };
 
 }}
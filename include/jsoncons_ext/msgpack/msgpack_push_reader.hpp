@@ -0,0 +1,415 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MSGPACK_MSGPACK_PUSH_READER_HPP
+#define JSONCONS_MSGPACK_MSGPACK_PUSH_READER_HPP
+
+#include <memory> // std::allocator
+#include <vector>
+#include <limits> // std::numeric_limits
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_visitor2.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons_ext/msgpack/msgpack_error.hpp>
+#include <jsoncons_ext/msgpack/msgpack_options.hpp>
+#include <jsoncons_ext/msgpack/msgpack_parser.hpp>
+
+namespace jsoncons { namespace msgpack {
+
+namespace detail {
+
+    // Finds the end of a complete MessagePack value in input that arrives in chunks,
+    // keeping only the number of values left to read in each enclosing container
+
+    class msgpack_item_scanner
+    {
+        enum class scan_state {head, argument, payload};
+        enum class item_kind {payload, array, map};
+
+        scan_state state_;
+        item_kind kind_;
+        uint64_t value_;
+        std::size_t argument_length_;
+        std::size_t payload_extra_;
+        uint64_t payload_length_;
+        std::vector<uint64_t> stack_;
+        int max_nesting_depth_;
+        bool partial_;
+    public:
+        msgpack_item_scanner(int max_nesting_depth)
+            : state_(scan_state::head), kind_(item_kind::payload), value_(0), argument_length_(0),
+              payload_extra_(0), payload_length_(0), max_nesting_depth_(max_nesting_depth), partial_(false)
+        {
+        }
+
+        // True if part of a value has been scanned
+        bool partial() const
+        {
+            return partial_;
+        }
+
+        void reset()
+        {
+            state_ = scan_state::head;
+            stack_.clear();
+            partial_ = false;
+        }
+
+        // Scans up to the end of the current value and returns the number of bytes scanned,
+        // setting complete if the value ended there
+        std::size_t scan(const uint8_t* data, std::size_t length, bool& complete, std::error_code& ec)
+        {
+            complete = false;
+            const uint8_t* p = data;
+            const uint8_t* last = data + length;
+            while (p != last && !complete && !ec)
+            {
+                switch (state_)
+                {
+                    case scan_state::head:
+                        complete = head(*p++, ec);
+                        break;
+                    case scan_state::argument:
+                        value_ = (value_ << 8) | *p++;
+                        if (--argument_length_ == 0)
+                        {
+                            state_ = scan_state::head;
+                            complete = end_argument(ec);
+                        }
+                        break;
+                    case scan_state::payload:
+                    {
+                        std::size_t n = static_cast<std::size_t>((std::min)(payload_length_, static_cast<uint64_t>(last - p)));
+                        p += n;
+                        payload_length_ -= n;
+                        if (payload_length_ == 0)
+                        {
+                            state_ = scan_state::head;
+                            complete = end_item();
+                        }
+                        break;
+                    }
+                }
+            }
+            if (complete)
+            {
+                partial_ = false;
+            }
+            else if (p != data)
+            {
+                partial_ = true;
+            }
+            return p - data;
+        }
+    private:
+        bool head(uint8_t b, std::error_code& ec)
+        {
+            if (b <= 0x7f || b >= 0xe0 || b == 0xc0 || b == 0xc2 || b == 0xc3)
+            {
+                return end_item();
+            }
+            if (b <= 0x8f) // fixmap
+            {
+                return begin_container(2*uint64_t(b & 0x0f), ec);
+            }
+            if (b <= 0x9f) // fixarray
+            {
+                return begin_container(b & 0x0f, ec);
+            }
+            if (b <= 0xbf) // fixstr
+            {
+                return begin_payload(b & 0x1f);
+            }
+            switch (b)
+            {
+                case 0xc4: case 0xc5: case 0xc6: // bin 8, 16, 32
+                    return begin_argument(std::size_t(1) << (b - 0xc4), item_kind::payload, 0);
+                case 0xc7: case 0xc8: case 0xc9: // ext 8, 16, 32
+                    return begin_argument(std::size_t(1) << (b - 0xc7), item_kind::payload, 1);
+                case 0xca: // float 32
+                    return begin_payload(4);
+                case 0xcb: // float 64
+                    return begin_payload(8);
+                case 0xcc: case 0xcd: case 0xce: case 0xcf: // uint 8, 16, 32, 64
+                    return begin_payload(std::size_t(1) << (b - 0xcc));
+                case 0xd0: case 0xd1: case 0xd2: case 0xd3: // int 8, 16, 32, 64
+                    return begin_payload(std::size_t(1) << (b - 0xd0));
+                case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8: // fixext 1, 2, 4, 8, 16
+                    return begin_payload((std::size_t(1) << (b - 0xd4)) + 1);
+                case 0xd9: case 0xda: case 0xdb: // str 8, 16, 32
+                    return begin_argument(std::size_t(1) << (b - 0xd9), item_kind::payload, 0);
+                case 0xdc: case 0xdd: // array 16, 32
+                    return begin_argument(std::size_t(2) << (b - 0xdc), item_kind::array, 0);
+                case 0xde: case 0xdf: // map 16, 32
+                    return begin_argument(std::size_t(2) << (b - 0xde), item_kind::map, 0);
+                default:
+                    ec = msgpack_errc::unknown_type;
+                    return false;
+            }
+        }
+
+        bool begin_argument(std::size_t length, item_kind kind, std::size_t extra)
+        {
+            value_ = 0;
+            argument_length_ = length;
+            kind_ = kind;
+            payload_extra_ = extra;
+            state_ = scan_state::argument;
+            return false;
+        }
+
+        bool end_argument(std::error_code& ec)
+        {
+            switch (kind_)
+            {
+                case item_kind::array:
+                    return begin_container(value_, ec);
+                case item_kind::map:
+                    return begin_container(2*value_, ec);
+                default:
+                    return begin_payload(value_ + payload_extra_);
+            }
+        }
+
+        bool begin_payload(uint64_t length)
+        {
+            if (length == 0)
+            {
+                return end_item();
+            }
+            payload_length_ = length;
+            state_ = scan_state::payload;
+            return false;
+        }
+
+        bool begin_container(uint64_t count, std::error_code& ec)
+        {
+            if (count == 0)
+            {
+                return end_item();
+            }
+            if (JSONCONS_UNLIKELY(static_cast<int>(stack_.size()) >= max_nesting_depth_))
+            {
+                ec = msgpack_errc::max_nesting_depth_exceeded;
+                return false;
+            }
+            stack_.push_back(count);
+            return false;
+        }
+
+        bool end_item()
+        {
+            while (!stack_.empty())
+            {
+                if (--stack_.back() > 0)
+                {
+                    return false;
+                }
+                stack_.pop_back();
+            }
+            return true;
+        }
+    };
+
+} // namespace detail
+
+// basic_msgpack_push_reader
+
+// Parses a sequence of MessagePack values fed in chunks as they arrive. Each value is passed
+// to the parser once it is complete, directly from the fed chunk if it lies within it,
+// otherwise from a buffer holding the partial value, so the caller's buffer may be
+// reused as soon as feed returns.
+// That buffer, bounded by the max_buffered_bytes option, is the memory a reader holds for input.
+
+template <class Allocator=std::allocator<char>>
+class basic_msgpack_push_reader : public ser_context
+{
+    using char_type = char;
+    using byte_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<uint8_t>;
+
+    static constexpr std::size_t max_retained_capacity = 16384;
+
+    basic_msgpack_parser<jsoncons::bytes_source,Allocator> parser_;
+    basic_json_visitor2_to_visitor_adaptor<char_type,Allocator> adaptor_;
+    json_visitor2& visitor_;
+    detail::msgpack_item_scanner scanner_;
+    std::vector<uint8_t,byte_allocator_type> buffer_;
+    std::size_t max_buffered_bytes_;
+    bool stopped_;
+
+    // Noncopyable and nonmoveable
+    basic_msgpack_push_reader(const basic_msgpack_push_reader&) = delete;
+    basic_msgpack_push_reader& operator=(const basic_msgpack_push_reader&) = delete;
+public:
+    basic_msgpack_push_reader(json_visitor& visitor,
+                           const Allocator alloc)
+       : basic_msgpack_push_reader(visitor, msgpack_decode_options(), alloc)
+    {
+    }
+
+    basic_msgpack_push_reader(json_visitor& visitor,
+                           const msgpack_decode_options& options = msgpack_decode_options(),
+                           const Allocator alloc=Allocator())
+       : parser_(jsoncons::bytes_source(), options, alloc),
+         adaptor_(visitor, alloc), visitor_(adaptor_),
+         scanner_(options.max_nesting_depth()),
+         buffer_(alloc),
+         max_buffered_bytes_(options.max_buffered_bytes()),
+         stopped_(false)
+    {
+    }
+
+    basic_msgpack_push_reader(json_visitor2& visitor,
+                           const Allocator alloc)
+       : basic_msgpack_push_reader(visitor, msgpack_decode_options(), alloc)
+    {
+    }
+
+    basic_msgpack_push_reader(json_visitor2& visitor,
+                           const msgpack_decode_options& options = msgpack_decode_options(),
+                           const Allocator alloc=Allocator())
+       : parser_(jsoncons::bytes_source(), options, alloc),
+         visitor_(visitor),
+         scanner_(options.max_nesting_depth()),
+         buffer_(alloc),
+         max_buffered_bytes_(options.max_buffered_bytes()),
+         stopped_(false)
+    {
+    }
+
+    void feed(const uint8_t* data, std::size_t length)
+    {
+        std::error_code ec;
+        feed(data, length, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line(),column()));
+        }
+    }
+
+    void feed(const uint8_t* data, std::size_t length, std::error_code& ec)
+    {
+        while (length > 0 && !stopped_)
+        {
+            bool complete;
+            std::size_t n = scanner_.scan(data, length, complete, ec);
+            if (ec)
+            {
+                stopped_ = true;
+                return;
+            }
+            if (!complete)
+            {
+                if (!check_buffer_limit(length, ec))
+                {
+                    return;
+                }
+                buffer_.insert(buffer_.end(), data, data + length);
+                return;
+            }
+            if (buffer_.empty())
+            {
+                parse_item(data, n, ec);
+            }
+            else
+            {
+                if (!check_buffer_limit(n, ec))
+                {
+                    return;
+                }
+                buffer_.insert(buffer_.end(), data, data + n);
+                parse_item(buffer_.data(), buffer_.size(), ec);
+                buffer_.clear();
+                if (buffer_.capacity() > max_retained_capacity)
+                {
+                    buffer_.shrink_to_fit();
+                }
+            }
+            data += n;
+            length -= n;
+        }
+    }
+
+    void finish()
+    {
+        std::error_code ec;
+        finish(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line(),column()));
+        }
+    }
+
+    // Signals the end of input, reporting unexpected_eof inside a value
+    void finish(std::error_code& ec)
+    {
+        if (!stopped_ && scanner_.partial())
+        {
+            ec = msgpack_errc::unexpected_eof;
+            stopped_ = true;
+        }
+    }
+
+    // Parsing has stopped, because of an error or because the visitor returned false
+    bool stopped() const
+    {
+        return stopped_;
+    }
+
+    void reset()
+    {
+        scanner_.reset();
+        buffer_.clear();
+        stopped_ = false;
+    }
+
+    std::size_t line() const override
+    {
+        return parser_.line();
+    }
+
+    std::size_t column() const override
+    {
+        return parser_.column();
+    }
+private:
+    // A partial root item is buffered whole, up to max_buffered_bytes
+    bool check_buffer_limit(std::size_t length, std::error_code& ec)
+    {
+        if (length > max_buffered_bytes_ - buffer_.size())
+        {
+            ec = msgpack_errc::max_buffered_bytes_exceeded;
+            stopped_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    void parse_item(const uint8_t* data, std::size_t length, std::error_code& ec)
+    {
+        parser_.reset(byte_string_view(data, length));
+        parser_.parse(visitor_, ec);
+        // A visitor returning false at the end of the root item (as json_decoder does)
+        // completes that item rather than stopping
+        if (!ec && parser_.before_done())
+        {
+            parser_.restart();
+            parser_.parse(visitor_, ec);
+        }
+        if (ec || !parser_.done())
+        {
+            stopped_ = true;
+        }
+    }
+};
+
+using msgpack_push_reader = basic_msgpack_push_reader<std::allocator<char>>;
+
+}}
+
+#endif
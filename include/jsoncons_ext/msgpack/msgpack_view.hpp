@@ -0,0 +1,864 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MSGPACK_MSGPACK_VIEW_HPP
+#define JSONCONS_MSGPACK_MSGPACK_VIEW_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <iterator> // std::forward_iterator_tag
+#include <limits> // std::numeric_limits
+#include <cstring> // std::memcpy, std::memcmp
+#include <type_traits> // std::enable_if
+#include <jsoncons/json.hpp>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons_ext/msgpack/msgpack_detail.hpp>
+#include <jsoncons_ext/msgpack/msgpack_error.hpp>
+#include <jsoncons_ext/msgpack/msgpack_reader.hpp>
+
+namespace jsoncons { namespace msgpack {
+
+class msgpack_view_member;
+
+// msgpack_view is a read-only handle to a value inside a buffer of MessagePack encoded bytes.
+// Navigation skips over length-prefixed values without decoding them. The view does not own
+// the buffer, it is valid as long as the bytes are.
+
+class msgpack_view
+{
+    static constexpr std::size_t npos = (std::numeric_limits<std::size_t>::max)();
+    static constexpr int max_nesting_depth = 1024;
+
+    enum class item_kind : uint8_t {null_value,bool_value,uint64_value,int64_value,float_value,double_value,
+                                    string_value,binary_value,ext_value,array_value,map_value};
+
+    struct item_head
+    {
+        item_kind kind;
+        uint64_t value; // integer value, bits of float, or length
+        int8_t ext_type;
+        std::size_t next; // offset of the payload or first element
+    };
+
+    const uint8_t* data_;
+    std::size_t length_;
+    std::size_t pos_;
+    bool indexed_;
+    mutable std::shared_ptr<std::vector<std::size_t>> index_;
+
+    msgpack_view(const uint8_t* data, std::size_t length, std::size_t pos, bool indexed)
+        : data_(data), length_(length), pos_(pos), indexed_(indexed)
+    {
+    }
+public:
+    class array_iterator;
+    class object_iterator;
+
+    using array_range_type = range<array_iterator>;
+    using object_range_type = range<object_iterator>;
+
+    msgpack_view()
+        : data_(nullptr), length_(0), pos_(0), indexed_(false)
+    {
+    }
+
+    // If index_containers is true, each container view builds an index of its element
+    // offsets on the first positional or key lookup, so repeated lookups don't rescan.
+    // The index is built on demand from const member functions, so a view (and its copies)
+    // should not be shared between threads without synchronization when it is set.
+    msgpack_view(const uint8_t* data, std::size_t length, bool index_containers = false)
+        : data_(data), length_(length), pos_(0), indexed_(index_containers)
+    {
+    }
+
+    msgpack_view(const byte_string_view& bytes, bool index_containers = false)
+        : data_(bytes.data()), length_(bytes.size()), pos_(0), indexed_(index_containers)
+    {
+    }
+
+    template <class Container>
+    msgpack_view(const Container& bytes, bool index_containers = false,
+                 typename std::enable_if<jsoncons::detail::is_byte_sequence<Container>::value,int>::type = 0)
+        : data_(reinterpret_cast<const uint8_t*>(bytes.data())), length_(bytes.size()), pos_(0), indexed_(index_containers)
+    {
+    }
+
+    // Offset of this value in the buffer
+    std::size_t offset() const
+    {
+        return pos_;
+    }
+
+    json_type type() const
+    {
+        switch (head().kind)
+        {
+            case item_kind::null_value:
+                return json_type::null_value;
+            case item_kind::bool_value:
+                return json_type::bool_value;
+            case item_kind::uint64_value:
+                return json_type::uint64_value;
+            case item_kind::int64_value:
+                return json_type::int64_value;
+            case item_kind::float_value:
+            case item_kind::double_value:
+                return json_type::double_value;
+            case item_kind::string_value:
+                return json_type::string_value;
+            case item_kind::array_value:
+                return json_type::array_value;
+            case item_kind::map_value:
+                return json_type::object_value;
+            default:
+                return json_type::byte_string_value;
+        }
+    }
+
+    // Extension types are reported as byte strings, with semantic_tag::timestamp for type -1
+    semantic_tag tag() const
+    {
+        item_head h = head();
+        return h.kind == item_kind::ext_value && h.ext_type == -1 ? semantic_tag::timestamp : semantic_tag::none;
+    }
+
+    bool is_null() const
+    {
+        return type() == json_type::null_value;
+    }
+
+    bool is_bool() const
+    {
+        return type() == json_type::bool_value;
+    }
+
+    bool is_int64() const
+    {
+        return type() == json_type::int64_value;
+    }
+
+    bool is_uint64() const
+    {
+        return type() == json_type::uint64_value;
+    }
+
+    bool is_double() const
+    {
+        return type() == json_type::double_value;
+    }
+
+    bool is_number() const
+    {
+        json_type t = type();
+        return t == json_type::int64_value || t == json_type::uint64_value || t == json_type::double_value;
+    }
+
+    bool is_string() const
+    {
+        return type() == json_type::string_value;
+    }
+
+    bool is_byte_string() const
+    {
+        return type() == json_type::byte_string_value;
+    }
+
+    bool is_array() const
+    {
+        return type() == json_type::array_value;
+    }
+
+    bool is_object() const
+    {
+        return type() == json_type::object_value;
+    }
+
+    // Number of elements of an array, number of members of a map, otherwise 0
+    std::size_t size() const
+    {
+        item_head h = head();
+        return h.kind == item_kind::array_value || h.kind == item_kind::map_value ? static_cast<std::size_t>(h.value) : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    msgpack_view at(std::size_t i) const
+    {
+        item_head h = head();
+        if (h.kind != item_kind::array_value)
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
+        }
+        if (i >= h.value)
+        {
+            JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+        }
+        if (indexed_)
+        {
+            return child(get_index(h)[i]);
+        }
+        std::size_t p = h.next;
+        for (std::size_t j = 0; j < i; ++j)
+        {
+            p = checked_skip(p);
+        }
+        return child(p);
+    }
+
+    msgpack_view operator[](std::size_t i) const
+    {
+        return at(i);
+    }
+
+    msgpack_view at(const string_view& name) const
+    {
+        std::size_t p = find_member(head(), name);
+        if (p == npos)
+        {
+            JSONCONS_THROW(key_not_found(name.data(),name.length()));
+        }
+        return child(checked_skip(p));
+    }
+
+    msgpack_view operator[](const string_view& name) const
+    {
+        return at(name);
+    }
+
+    bool contains(const string_view& name) const
+    {
+        item_head h = head();
+        return h.kind == item_kind::map_value && find_member(h, name) != npos;
+    }
+
+    object_iterator find(const string_view& name) const;
+
+    array_range_type array_range() const;
+
+    object_range_type object_range() const;
+
+    bool equals(const string_view& name) const
+    {
+        item_head h = head();
+        return h.kind == item_kind::string_value && h.value == name.size() &&
+               std::memcmp(data_ + h.next, name.data(), name.size()) == 0;
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_same<T,bool>::value,T>::type
+    as() const
+    {
+        item_head h = head();
+        if (h.kind == item_kind::bool_value)
+        {
+            return h.value != 0;
+        }
+        return as<json>().template as<T>();
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T,bool>::value,T>::type
+    as() const
+    {
+        item_head h = head();
+        switch (h.kind)
+        {
+            case item_kind::uint64_value:
+                return static_cast<T>(h.value);
+            case item_kind::int64_value:
+                return static_cast<T>(static_cast<int64_t>(h.value));
+            case item_kind::float_value:
+            case item_kind::double_value:
+                return static_cast<T>(as_double(h));
+            default:
+                return as<json>().template as<T>();
+        }
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_floating_point<T>::value,T>::type
+    as() const
+    {
+        item_head h = head();
+        switch (h.kind)
+        {
+            case item_kind::uint64_value:
+                return static_cast<T>(h.value);
+            case item_kind::int64_value:
+                return static_cast<T>(static_cast<int64_t>(h.value));
+            case item_kind::float_value:
+            case item_kind::double_value:
+                return static_cast<T>(as_double(h));
+            default:
+                return as<json>().template as<T>();
+        }
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_same<T,string_view>::value,T>::type
+    as() const
+    {
+        item_head h = head();
+        if (h.kind != item_kind::string_value)
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
+        }
+        return string_view(reinterpret_cast<const char*>(data_ + h.next), static_cast<std::size_t>(h.value));
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_same<T,byte_string_view>::value,T>::type
+    as() const
+    {
+        item_head h = head();
+        if (h.kind != item_kind::binary_value && h.kind != item_kind::ext_value)
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
+        }
+        return byte_string_view(data_ + h.next, static_cast<std::size_t>(h.value));
+    }
+
+    template <class T>
+    typename std::enable_if<jsoncons::detail::is_basic_string<T>::value && std::is_same<typename T::value_type,char>::value,T>::type
+    as() const
+    {
+        item_head h = head();
+        if (h.kind != item_kind::string_value)
+        {
+            return as<json>().template as<T>();
+        }
+        return T(reinterpret_cast<const char*>(data_ + h.next), static_cast<std::size_t>(h.value));
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_same<T,std::vector<uint8_t>>::value,T>::type
+    as() const
+    {
+        item_head h = head();
+        if (h.kind != item_kind::binary_value && h.kind != item_kind::ext_value)
+        {
+            return as<json>().template as<T>();
+        }
+        return T(data_ + h.next, data_ + h.next + static_cast<std::size_t>(h.value));
+    }
+
+    // Decodes the value into a basic_json
+    template <class T>
+    typename std::enable_if<is_basic_json<T>::value,T>::type
+    as() const
+    {
+        json_decoder<T> decoder;
+        dump(decoder);
+        if (!decoder.is_valid())
+        {
+            JSONCONS_THROW(ser_error(msgpack_errc::unexpected_eof));
+        }
+        return decoder.get_result();
+    }
+
+    // Any other type goes through json_type_traits
+    template <class T>
+    typename std::enable_if<!is_basic_json<T>::value && !std::is_arithmetic<T>::value &&
+                            !std::is_same<T,string_view>::value && !std::is_same<T,byte_string_view>::value &&
+                            !jsoncons::detail::is_basic_string<T>::value && !std::is_same<T,std::vector<uint8_t>>::value,T>::type
+    as() const
+    {
+        return as<json>().template as<T>();
+    }
+
+    void dump(json_visitor& visitor) const
+    {
+        std::error_code ec;
+        dump(visitor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+    }
+
+    void dump(json_visitor& visitor, std::error_code& ec) const
+    {
+        std::size_t end = skip(pos_, 0, ec);
+        if (ec)
+        {
+            return;
+        }
+        msgpack_bytes_reader reader(byte_string_view(data_ + pos_, end - pos_), visitor);
+        reader.read(ec);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const msgpack_view& v)
+    {
+        json_compressed_stream_encoder encoder(os);
+        v.dump(encoder);
+        return os;
+    }
+private:
+    friend class array_iterator;
+    friend class object_iterator;
+
+    msgpack_view child(std::size_t pos) const
+    {
+        return msgpack_view(data_, length_, pos, indexed_);
+    }
+
+    uint64_t read_uint(std::size_t p, std::size_t n, std::error_code& ec) const
+    {
+        if (p > length_ || length_ - p < n)
+        {
+            ec = msgpack_errc::unexpected_eof;
+            return 0;
+        }
+        uint64_t val = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            val = (val << 8) | data_[p + i];
+        }
+        return val;
+    }
+
+    item_head read_head(std::size_t p, std::error_code& ec) const
+    {
+        item_head h{item_kind::null_value,0,0,p};
+        if (p >= length_)
+        {
+            ec = msgpack_errc::unexpected_eof;
+            return h;
+        }
+        uint8_t type = data_[p];
+        h.next = p + 1;
+
+        // sizes of the length or value field, and of the payload for fixext
+        std::size_t n = 0;
+        std::size_t fixed = 0;
+        if (type <= 0x7f)
+        {
+            h.kind = item_kind::uint64_value;
+            h.value = type;
+            return h;
+        }
+        if (type >= jsoncons::msgpack::detail::msgpack_format::negative_fixint_base_cd)
+        {
+            h.kind = item_kind::int64_value;
+            h.value = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int8_t>(type)));
+            return h;
+        }
+        if (type >= jsoncons::msgpack::detail::msgpack_format::fixstr_base_cd && type <= 0xbf)
+        {
+            h.kind = item_kind::string_value;
+            h.value = type & 0x1f;
+        }
+        else if (type >= jsoncons::msgpack::detail::msgpack_format::fixarray_base_cd && type <= 0x9f)
+        {
+            h.kind = item_kind::array_value;
+            h.value = type & 0x0f;
+            return h;
+        }
+        else if (type <= 0x8f)
+        {
+            h.kind = item_kind::map_value;
+            h.value = type & 0x0f;
+            return h;
+        }
+        else
+        {
+            switch (type)
+            {
+                case jsoncons::msgpack::detail::msgpack_format::nil_cd:
+                    return h;
+                case jsoncons::msgpack::detail::msgpack_format::false_cd:
+                case jsoncons::msgpack::detail::msgpack_format::true_cd:
+                    h.kind = item_kind::bool_value;
+                    h.value = type == jsoncons::msgpack::detail::msgpack_format::true_cd ? 1 : 0;
+                    return h;
+                case jsoncons::msgpack::detail::msgpack_format::float32_cd:
+                    h.kind = item_kind::float_value; n = 4; break;
+                case jsoncons::msgpack::detail::msgpack_format::float64_cd:
+                    h.kind = item_kind::double_value; n = 8; break;
+                case jsoncons::msgpack::detail::msgpack_format::uint8_cd:
+                    h.kind = item_kind::uint64_value; n = 1; break;
+                case jsoncons::msgpack::detail::msgpack_format::uint16_cd:
+                    h.kind = item_kind::uint64_value; n = 2; break;
+                case jsoncons::msgpack::detail::msgpack_format::uint32_cd:
+                    h.kind = item_kind::uint64_value; n = 4; break;
+                case jsoncons::msgpack::detail::msgpack_format::uint64_cd:
+                    h.kind = item_kind::uint64_value; n = 8; break;
+                case jsoncons::msgpack::detail::msgpack_format::int8_cd:
+                    h.kind = item_kind::int64_value; n = 1; break;
+                case jsoncons::msgpack::detail::msgpack_format::int16_cd:
+                    h.kind = item_kind::int64_value; n = 2; break;
+                case jsoncons::msgpack::detail::msgpack_format::int32_cd:
+                    h.kind = item_kind::int64_value; n = 4; break;
+                case jsoncons::msgpack::detail::msgpack_format::int64_cd:
+                    h.kind = item_kind::int64_value; n = 8; break;
+                case jsoncons::msgpack::detail::msgpack_format::str8_cd:
+                    h.kind = item_kind::string_value; n = 1; break;
+                case jsoncons::msgpack::detail::msgpack_format::str16_cd:
+                    h.kind = item_kind::string_value; n = 2; break;
+                case jsoncons::msgpack::detail::msgpack_format::str32_cd:
+                    h.kind = item_kind::string_value; n = 4; break;
+                case jsoncons::msgpack::detail::msgpack_format::bin8_cd:
+                    h.kind = item_kind::binary_value; n = 1; break;
+                case jsoncons::msgpack::detail::msgpack_format::bin16_cd:
+                    h.kind = item_kind::binary_value; n = 2; break;
+                case jsoncons::msgpack::detail::msgpack_format::bin32_cd:
+                    h.kind = item_kind::binary_value; n = 4; break;
+                case jsoncons::msgpack::detail::msgpack_format::fixext1_cd:
+                    h.kind = item_kind::ext_value; fixed = 1; break;
+                case jsoncons::msgpack::detail::msgpack_format::fixext2_cd:
+                    h.kind = item_kind::ext_value; fixed = 2; break;
+                case jsoncons::msgpack::detail::msgpack_format::fixext4_cd:
+                    h.kind = item_kind::ext_value; fixed = 4; break;
+                case jsoncons::msgpack::detail::msgpack_format::fixext8_cd:
+                    h.kind = item_kind::ext_value; fixed = 8; break;
+                case jsoncons::msgpack::detail::msgpack_format::fixext16_cd:
+                    h.kind = item_kind::ext_value; fixed = 16; break;
+                case jsoncons::msgpack::detail::msgpack_format::ext8_cd:
+                    h.kind = item_kind::ext_value; n = 1; break;
+                case jsoncons::msgpack::detail::msgpack_format::ext16_cd:
+                    h.kind = item_kind::ext_value; n = 2; break;
+                case jsoncons::msgpack::detail::msgpack_format::ext32_cd:
+                    h.kind = item_kind::ext_value; n = 4; break;
+                case jsoncons::msgpack::detail::msgpack_format::array16_cd:
+                    h.kind = item_kind::array_value; n = 2; break;
+                case jsoncons::msgpack::detail::msgpack_format::array32_cd:
+                    h.kind = item_kind::array_value; n = 4; break;
+                case jsoncons::msgpack::detail::msgpack_format::map16_cd:
+                    h.kind = item_kind::map_value; n = 2; break;
+                case jsoncons::msgpack::detail::msgpack_format::map32_cd:
+                    h.kind = item_kind::map_value; n = 4; break;
+                default:
+                    ec = msgpack_errc::unknown_type;
+                    return h;
+            }
+            h.value = fixed != 0 ? fixed : read_uint(h.next, n, ec);
+            if (ec)
+            {
+                return h;
+            }
+            h.next += n;
+            if (h.kind == item_kind::int64_value)
+            {
+                // sign extend
+                switch (n)
+                {
+                    case 1: h.value = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int8_t>(h.value))); break;
+                    case 2: h.value = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int16_t>(h.value))); break;
+                    case 4: h.value = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(h.value))); break;
+                    default: break;
+                }
+            }
+            if (h.kind == item_kind::ext_value)
+            {
+                if (h.next >= length_)
+                {
+                    ec = msgpack_errc::unexpected_eof;
+                    return h;
+                }
+                h.ext_type = static_cast<int8_t>(data_[h.next]);
+                ++h.next;
+            }
+        }
+        if (h.value > length_ - h.next && (h.kind == item_kind::string_value || h.kind == item_kind::binary_value || h.kind == item_kind::ext_value))
+        {
+            ec = msgpack_errc::unexpected_eof;
+        }
+        return h;
+    }
+
+    item_head head() const
+    {
+        std::error_code ec;
+        item_head h = read_head(pos_, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+        return h;
+    }
+
+    double as_double(const item_head& h) const
+    {
+        if (h.kind == item_kind::float_value)
+        {
+            uint32_t bits = static_cast<uint32_t>(h.value);
+            float val;
+            std::memcpy(&val, &bits, sizeof(val));
+            return val;
+        }
+        double val;
+        std::memcpy(&val, &h.value, sizeof(val));
+        return val;
+    }
+
+    // Returns the offset one past the value at p
+    std::size_t skip(std::size_t p, int depth, std::error_code& ec) const
+    {
+        if (depth > max_nesting_depth)
+        {
+            ec = msgpack_errc::max_nesting_depth_exceeded;
+            return p;
+        }
+        item_head h = read_head(p, ec);
+        if (ec)
+        {
+            return p;
+        }
+        switch (h.kind)
+        {
+            case item_kind::string_value:
+            case item_kind::binary_value:
+            case item_kind::ext_value:
+                return h.next + static_cast<std::size_t>(h.value);
+            case item_kind::array_value:
+            case item_kind::map_value:
+            {
+                uint64_t n = h.kind == item_kind::map_value ? 2*h.value : h.value;
+                if (n > length_ - h.next)
+                {
+                    ec = msgpack_errc::unexpected_eof;
+                    return p;
+                }
+                std::size_t q = h.next;
+                for (uint64_t i = 0; i < n && !ec; ++i)
+                {
+                    q = skip(q, depth+1, ec);
+                }
+                return q;
+            }
+            default:
+                return h.next;
+        }
+    }
+
+    std::size_t checked_skip(std::size_t p) const
+    {
+        std::error_code ec;
+        std::size_t q = skip(p, 0, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+        return q;
+    }
+
+    const std::vector<std::size_t>& get_index(const item_head& h) const
+    {
+        if (!index_)
+        {
+            std::size_t n = static_cast<std::size_t>(h.kind == item_kind::map_value ? 2*h.value : h.value);
+            std::shared_ptr<std::vector<std::size_t>> index = std::make_shared<std::vector<std::size_t>>();
+            index->reserve(n);
+            std::size_t p = h.next;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                index->push_back(p);
+                p = checked_skip(p);
+            }
+            index_ = index;
+        }
+        return *index_;
+    }
+
+    // Returns the offset of the key of the member called name, or npos
+    std::size_t find_member(const item_head& h, const string_view& name) const
+    {
+        if (h.kind != item_kind::map_value)
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+        }
+        if (indexed_)
+        {
+            const std::vector<std::size_t>& index = get_index(h);
+            for (std::size_t i = 0; i < index.size(); i += 2)
+            {
+                if (child(index[i]).equals(name))
+                {
+                    return index[i];
+                }
+            }
+            return npos;
+        }
+        std::size_t p = h.next;
+        for (uint64_t i = 0; i < h.value; ++i)
+        {
+            if (child(p).equals(name))
+            {
+                return p;
+            }
+            p = checked_skip(checked_skip(p));
+        }
+        return npos;
+    }
+};
+
+class msgpack_view_member
+{
+    msgpack_view key_;
+    msgpack_view value_;
+public:
+    msgpack_view_member(const msgpack_view& key, const msgpack_view& value)
+        : key_(key), value_(value)
+    {
+    }
+
+    const msgpack_view& key() const
+    {
+        return key_;
+    }
+
+    const msgpack_view& value() const
+    {
+        return value_;
+    }
+};
+
+class msgpack_view::array_iterator
+{
+    msgpack_view parent_;
+    std::size_t pos_;
+    std::size_t remaining_;
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = msgpack_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const msgpack_view*;
+    using reference = msgpack_view;
+
+    array_iterator(const msgpack_view& parent, std::size_t pos, std::size_t remaining)
+        : parent_(parent), pos_(pos), remaining_(remaining)
+    {
+    }
+
+    msgpack_view operator*() const
+    {
+        return parent_.child(pos_);
+    }
+
+    array_iterator& operator++()
+    {
+        pos_ = parent_.checked_skip(pos_);
+        --remaining_;
+        return *this;
+    }
+
+    array_iterator operator++(int)
+    {
+        array_iterator temp(*this);
+        ++*this;
+        return temp;
+    }
+
+    friend bool operator==(const array_iterator& lhs, const array_iterator& rhs)
+    {
+        return lhs.remaining_ == rhs.remaining_;
+    }
+
+    friend bool operator!=(const array_iterator& lhs, const array_iterator& rhs)
+    {
+        return !(lhs == rhs);
+    }
+};
+
+class msgpack_view::object_iterator
+{
+    msgpack_view parent_;
+    std::size_t pos_;
+    std::size_t remaining_;
+    mutable std::shared_ptr<msgpack_view_member> member_;
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = msgpack_view_member;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const msgpack_view_member*;
+    using reference = const msgpack_view_member&;
+
+    object_iterator(const msgpack_view& parent, std::size_t pos, std::size_t remaining)
+        : parent_(parent), pos_(pos), remaining_(remaining)
+    {
+    }
+
+    const msgpack_view_member& operator*() const
+    {
+        if (!member_)
+        {
+            member_ = std::make_shared<msgpack_view_member>(parent_.child(pos_), parent_.child(parent_.checked_skip(pos_)));
+        }
+        return *member_;
+    }
+
+    const msgpack_view_member* operator->() const
+    {
+        return std::addressof(**this);
+    }
+
+    object_iterator& operator++()
+    {
+        pos_ = parent_.checked_skip(parent_.checked_skip(pos_));
+        member_.reset();
+        --remaining_;
+        return *this;
+    }
+
+    object_iterator operator++(int)
+    {
+        object_iterator temp(*this);
+        ++*this;
+        return temp;
+    }
+
+    friend bool operator==(const object_iterator& lhs, const object_iterator& rhs)
+    {
+        return lhs.remaining_ == rhs.remaining_;
+    }
+
+    friend bool operator!=(const object_iterator& lhs, const object_iterator& rhs)
+    {
+        return !(lhs == rhs);
+    }
+};
+
+inline
+msgpack_view::array_range_type msgpack_view::array_range() const
+{
+    item_head h = head();
+    if (h.kind != item_kind::array_value)
+    {
+        JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+    }
+    return array_range_type(array_iterator(*this, h.next, static_cast<std::size_t>(h.value)), array_iterator(*this, h.next, 0));
+}
+
+inline
+msgpack_view::object_range_type msgpack_view::object_range() const
+{
+    item_head h = head();
+    if (h.kind != item_kind::map_value)
+    {
+        JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+    }
+    return object_range_type(object_iterator(*this, h.next, static_cast<std::size_t>(h.value)), object_iterator(*this, h.next, 0));
+}
+
+inline
+msgpack_view::object_iterator msgpack_view::find(const string_view& name) const
+{
+    object_range_type members = object_range();
+    object_iterator it = members.begin();
+    while (it != members.end() && !it->key().equals(name))
+    {
+        ++it;
+    }
+    return it;
+}
+
+}}
+
+#endif
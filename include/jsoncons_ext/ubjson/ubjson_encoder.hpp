@@ -227,7 +227,7 @@ private:
 
     bool visit_key(const string_view_type& name, const ser_context&, std::error_code& ec) override
     {
-        auto sink = unicons::validate(name.begin(), name.end());
+        auto sink = unicons::validate(name.data(), name.data() + name.size());
         if (sink.ec != unicons::conv_errc())
         {
             ec = ubjson_errc::invalid_utf8_text_string;
@@ -268,7 +268,7 @@ private:
             }
         }
 
-        auto sink = unicons::validate(sv.begin(), sv.end());
+        auto sink = unicons::validate(sv.data(), sv.data() + sv.size());
         if (sink.ec != unicons::conv_errc())
         {
             ec = ubjson_errc::invalid_utf8_text_string;
@@ -480,7 +480,7 @@ private:
                     more_ = false;
                     return;
                 }
-                auto result = unicons::validate(text_buffer_.begin(),text_buffer_.end());
+                auto result = unicons::validate(text_buffer_.data(), text_buffer_.data() + text_buffer_.size());
                 if (result.ec != unicons::conv_errc())
                 {
                     ec = ubjson_errc::invalid_utf8_text_string;
@@ -842,7 +842,7 @@ private:
             return;
         }
 
-        auto result = unicons::validate(text_buffer_.begin(),text_buffer_.end());
+        auto result = unicons::validate(text_buffer_.data(), text_buffer_.data() + text_buffer_.size());
         if (result.ec != unicons::conv_errc())
         {
             ec = ubjson_errc::invalid_utf8_text_string;
@@ -10,6 +10,7 @@
 #include <vector>
 #include <utility>
 #include <ctime>
+#include <random>
 #include <catch/catch.hpp>
 
 using namespace jsoncons;
@@ -327,3 +328,138 @@ TEST_CASE("bignum div")
     }
 #endif
 }
+
+TEST_CASE("bignum large decimal round trip")
+{
+    std::mt19937 gen(20201012);
+    std::uniform_int_distribution<int> dist(0,9);
+
+    for (std::size_t n : {1, 18, 19, 20, 38, 39, 600, 608, 609, 700, 1300, 2600, 5000, 12000})
+    {
+        std::string s;
+        s.push_back(char('1' + dist(gen) % 9));
+        for (std::size_t i = 1; i < n; ++i)
+        {
+            s.push_back(char('0' + dist(gen)));
+        }
+        // Runs of zeros straddle the split points
+        if (n > 1300)
+        {
+            s.replace(n/2 - 30, 60, 60, '0');
+        }
+
+        bignum x(s);
+        std::string t;
+        x.dump(t);
+        CHECK(t == s);
+
+        bignum y(std::string("-") + s);
+        y.dump(t);
+        CHECK(t == std::string("-") + s);
+    }
+}
+
+TEST_CASE("bignum large multiplication")
+{
+    SECTION("(10^n - 1)^2")
+    {
+        for (std::size_t n : {10, 100, 1000, 4000})
+        {
+            bignum x(std::string(n, '9'));
+            std::string s;
+            (x * x).dump(s);
+            CHECK(s == std::string(n - 1, '9') + "8" + std::string(n - 1, '0') + "1");
+        }
+    }
+
+    SECTION("powers")
+    {
+        std::string s;
+        power(bignum(2), 20000).dump(s);
+        CHECK(s.size() == 6021);
+        CHECK(s.substr(0,30) == "398027684033796659235430720619");
+        CHECK(s.substr(s.size()-30) == "869570675234892321663406309376");
+
+        (power(bignum(3), 7000) * power(bignum(7), 3000)).dump(s);
+        CHECK(s.size() == 5876);
+        CHECK(s.substr(0,30) == "138964247619747704829098647781");
+        CHECK(s.substr(s.size()-30) == "883472220916059010182228340001");
+    }
+
+    SECTION("unbalanced operands")
+    {
+        bignum a = power(bignum(3), 9000) - 1;
+        bignum b = power(bignum(5), 2000) + 12345;
+        bignum c = power(bignum(7), 500);
+        CHECK(a * (b + c) == a * b + a * c);
+        CHECK((a * b) / b == a);
+        CHECK((a * b) % b == 0);
+        CHECK(-a * b == -(a * b));
+    }
+}
+
+TEST_CASE("bignum large hex and byte round trip")
+{
+    bignum x = power(bignum(3), 5000) + 1;
+
+    std::string hex;
+    x.dump_hex_string(hex);
+    CHECK(bignum(hex, 16) == x);
+
+    int signum;
+    std::vector<uint8_t> bytes;
+    x.dump(signum, bytes);
+    CHECK(signum == 1);
+    CHECK(bytes.front() != 0);
+    CHECK(bignum(1, bytes.data(), bytes.size()) == x);
+
+    bytes.clear();
+    (-x).dump(signum, bytes);
+    CHECK(signum == -1);
+    CHECK(bignum(-1, bytes.data(), bytes.size()) == -x);
+}
+
+TEST_CASE("bignum division with multiword divisors")
+{
+    bignum x(std::string(600,'9'));
+    bignum y = x * x;
+    for (unsigned e : {100, 390, 608, 1000})
+    {
+        bignum p = power(bignum(10), e);
+        bignum q = y / p;
+        bignum r = y % p;
+        CHECK(q * p + r == y);
+        CHECK(r < p);
+    }
+
+    bignum a = power(bignum(2), 4096) - 1; // all words max
+    bignum b = power(bignum(2), 1024) - 1;
+    CHECK(a % b == 0);
+    CHECK(a / b * b == a);
+}
+
+TEST_CASE("bignum exact division")
+{
+    SECTION("x % x")
+    {
+        for (std::size_t n : {20, 40, 100, 663, 1610})
+        {
+            bignum x(std::string(n,'7').c_str());
+            CHECK(x % x == 0);
+            CHECK(x / x == 1);
+        }
+    }
+
+    SECTION("10^a % 10^b")
+    {
+        const std::pair<std::size_t,std::size_t> exponents[] = {{1609,662},{662,662},{1000,39},{300,20},{40,21}};
+        for (const auto& e : exponents)
+        {
+            bignum a = power(bignum(10), static_cast<unsigned>(e.first));
+            bignum b = power(bignum(10), static_cast<unsigned>(e.second));
+            CHECK(a % b == 0);
+            CHECK(a / b == power(bignum(10), static_cast<unsigned>(e.first - e.second)));
+        }
+        CHECK(bignum(("1" + std::string(1609,'0')).c_str()) % bignum(("1" + std::string(662,'0')).c_str()) == 0);
+    }
+}
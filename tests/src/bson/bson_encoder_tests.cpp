@@ -245,3 +245,83 @@ TEST_CASE("serialize to bson")
     }
 }
 
+
+TEST_CASE("bson_encoder with gather_sink")
+{
+    std::vector<uint8_t> bytes(5000, 7);
+    json j(json_object_arg);
+    j.try_emplace("bytes", byte_string_arg, bytes);
+    j.try_emplace("text", std::string(5000, 't'));
+    j.try_emplace("small", "s");
+
+    std::vector<uint8_t> expected;
+    bson::encode_bson(j, expected);
+
+    auto count_external = [&j](const gather_buffer<uint8_t>& buf, std::vector<uint8_t>& v)
+    {
+        std::size_t external_count = 0;
+        for (auto segment : buf.segments())
+        {
+            v.insert(v.end(), segment.begin(), segment.end());
+            if (segment.data() == j.at("bytes").as_byte_string_view().data() ||
+                segment.data() == reinterpret_cast<const uint8_t*>(j.at("text").as_string_view().data()))
+            {
+                ++external_count;
+            }
+        }
+        return external_count;
+    };
+
+    SECTION("bson::encode_bson references long values")
+    {
+        gather_buffer<uint8_t> buf;
+        bson::encode_bson(j, buf);
+
+        std::vector<uint8_t> v;
+        CHECK(count_external(buf, v) == 2);
+        CHECK(v == expected);
+    }
+
+    SECTION("an encoder with a gather_sink copies")
+    {
+        gather_buffer<uint8_t> buf;
+        {
+            bson::basic_bson_encoder<gather_sink<uint8_t>> encoder(buf);
+            j.dump(encoder);
+        }
+
+        std::vector<uint8_t> v;
+        CHECK(count_external(buf, v) == 0);
+        CHECK(v == expected);
+    }
+}
+
+TEST_CASE("bson_encoder with gather_sink and short temporaries")
+{
+    gather_buffer<uint8_t> buf;
+    {
+        bson::basic_bson_encoder<gather_sink<uint8_t>> encoder(buf);
+        encoder.begin_object();
+        for (int i = 0; i < 3; ++i)
+        {
+            std::string key = "k" + std::to_string(i);
+            std::string value = "value" + std::to_string(i);
+            encoder.key(key);
+            encoder.string_value(value);
+            std::vector<uint8_t> bytes(6, static_cast<uint8_t>(i));
+            encoder.key("b" + std::to_string(i));
+            encoder.byte_string_value(bytes);
+        }
+        encoder.end_object();
+    }
+
+    std::vector<uint8_t> v;
+    for (auto segment : buf.segments())
+    {
+        v.insert(v.end(), segment.begin(), segment.end());
+    }
+    json j = bson::decode_bson<json>(v);
+    CHECK(j.at("k0").as<std::string>() == "value0");
+    CHECK(j.at("k2").as<std::string>() == "value2");
+    CHECK(j.at("b1").as<std::vector<uint8_t>>() == std::vector<uint8_t>(6, 1));
+}
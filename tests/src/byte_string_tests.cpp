@@ -6,6 +6,7 @@
 #include <sstream>
 #include <vector>
 #include <map>
+#include <deque>
 #include <utility>
 #include <ctime>
 #include <new>
@@ -104,3 +105,64 @@ TEST_CASE("test_base16_conversion")
     check_encode_base16({'f','o','o','b','a','r'}, "666F6F626172");
 }
 
+
+TEST_CASE("contiguous and iterator codecs agree")
+{
+    // Lengths around the block sizes and the internal buffer size
+    std::vector<uint8_t> data;
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        data.push_back(static_cast<uint8_t>((i * 167 + 13) ^ (i >> 3)));
+    }
+
+    for (std::size_t length : {0, 1, 2, 3, 11, 12, 13, 15, 16, 17, 47, 48, 49, 191, 192, 193, 250, 1000})
+    {
+        const uint8_t* first = data.data();
+        const uint8_t* last = data.data() + length;
+        std::deque<uint8_t> l(first, last);
+
+        std::string s1, s2;
+        CHECK(encode_base64(first, last, s1) == encode_base64(l.begin(), l.end(), s2));
+        CHECK(s1 == s2);
+        std::vector<uint8_t> b1, b2;
+        decode_base64(s1.data(), s1.data() + s1.size(), b1);
+        std::deque<char> sl(s1.begin(), s1.end());
+        decode_base64(sl.begin(), sl.end(), b2);
+        CHECK(b1 == std::vector<uint8_t>(first, last));
+        CHECK(b2 == b1);
+
+        s1.clear(); s2.clear();
+        CHECK(encode_base64url(first, last, s1) == encode_base64url(l.begin(), l.end(), s2));
+        CHECK(s1 == s2);
+        b1.clear();
+        decode_base64url(s1.data(), s1.data() + s1.size(), b1);
+        CHECK(b1 == std::vector<uint8_t>(first, last));
+
+        s1.clear(); s2.clear();
+        CHECK(encode_base16(first, last, s1) == encode_base16(l.begin(), l.end(), s2));
+        CHECK(s1 == s2);
+        b1.clear();
+        decode_base16(s1.data(), s1.data() + s1.size(), b1);
+        CHECK(b1 == std::vector<uint8_t>(first, last));
+
+        std::wstring ws;
+        encode_base16(first, last, ws);
+        CHECK(ws == std::wstring(s2.begin(), s2.end()));
+    }
+
+    SECTION("padding, invalid chars and stop at '='")
+    {
+        std::string s = "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVo=";
+        std::vector<uint8_t> b;
+        decode_base64(s.data(), s.data() + s.size(), b);
+        CHECK(std::string(b.begin(), b.end()) == "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+
+        std::string t = "QUJDREVGR0hJSktM*U5PUFFSU1RVVldYWVo";
+        std::vector<uint8_t> c;
+        CHECK_THROWS(decode_base64(t.data(), t.data() + t.size(), c));
+
+        std::string u = "0123456789abcdefABCDEF0123456789abcdefXX";
+        std::vector<uint8_t> d;
+        CHECK_THROWS(decode_base16(u.data(), u.data() + u.size(), d));
+    }
+}
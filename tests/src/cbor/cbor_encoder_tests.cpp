@@ -18,6 +18,18 @@
 
 using namespace jsoncons;
 
+namespace cbor_encoder_tests {
+
+    struct document
+    {
+        std::string id;
+        std::string body;
+    };
+
+} // namespace cbor_encoder_tests
+
+JSONCONS_ALL_MEMBER_TRAITS(cbor_encoder_tests::document,id,body)
+
 TEST_CASE("cbor encode multi dim array test")
 {
     std::vector<uint8_t> v;
@@ -457,3 +469,92 @@ TEST_CASE("cbor encode with semantic_tags")
     }
 }
 
+
+TEST_CASE("cbor_encoder with gather_sink")
+{
+    std::vector<uint8_t> bytes(5000, 7);
+    json j(json_object_arg);
+    j.try_emplace("bytes", byte_string_arg, bytes);
+    j.try_emplace("text", std::string(5000, 't'));
+    j.try_emplace("small", "s");
+
+    std::vector<uint8_t> expected;
+    cbor::encode_cbor(j, expected);
+
+    auto count_external = [&j](const gather_buffer<uint8_t>& buf, std::vector<uint8_t>& v)
+    {
+        std::size_t external_count = 0;
+        for (auto segment : buf.segments())
+        {
+            v.insert(v.end(), segment.begin(), segment.end());
+            if (segment.data() == j.at("bytes").as_byte_string_view().data() ||
+                segment.data() == reinterpret_cast<const uint8_t*>(j.at("text").as_string_view().data()))
+            {
+                ++external_count;
+            }
+        }
+        return external_count;
+    };
+
+    SECTION("cbor::encode_cbor references long values")
+    {
+        gather_buffer<uint8_t> buf;
+        cbor::encode_cbor(j, buf);
+
+        std::vector<uint8_t> v;
+        CHECK(count_external(buf, v) == 2);
+        CHECK(v == expected);
+    }
+
+    SECTION("an encoder with a gather_sink copies")
+    {
+        gather_buffer<uint8_t> buf;
+        {
+            cbor::basic_cbor_encoder<gather_sink<uint8_t>> encoder(buf);
+            j.dump(encoder);
+        }
+
+        std::vector<uint8_t> v;
+        CHECK(count_external(buf, v) == 0);
+        CHECK(v == expected);
+    }
+}
+
+TEST_CASE("cbor_encoder with gather_sink and ser_traits")
+{
+    // ser_traits encodes a document through a temporary json, whose strings are
+    // destroyed before the segments are read
+    cbor_encoder_tests::document doc{"d1", std::string(5000, 'b')};
+
+    std::vector<uint8_t> expected;
+    cbor::encode_cbor(doc, expected);
+
+    auto concatenate = [](const gather_buffer<uint8_t>& buf)
+    {
+        std::vector<uint8_t> v;
+        for (auto segment : buf.segments())
+        {
+            v.insert(v.end(), segment.begin(), segment.end());
+        }
+        return v;
+    };
+
+    SECTION("encode_cbor")
+    {
+        gather_buffer<uint8_t> buf;
+        cbor::encode_cbor(doc, buf);
+        CHECK(buf.segments().size() == 1);
+        CHECK(concatenate(buf) == expected);
+    }
+
+    SECTION("encode_json with a cbor encoder")
+    {
+        gather_buffer<uint8_t> buf;
+        {
+            cbor::basic_cbor_encoder<gather_sink<uint8_t>> encoder(buf);
+            encode_json(doc, encoder);
+        }
+        CHECK(buf.segments().size() == 1);
+        CHECK(concatenate(buf) == expected);
+    }
+}
@@ -0,0 +1,216 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("cbor_view navigation")
+{
+    json j = json::parse(R"({"name":"Cocktail","ids":[1,-2,3.5,true,null,{"x":[]}],"empty":{},"big":18446744073709551616})");
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(j, data);
+
+    for (bool indexed : {false, true})
+    {
+        cbor::cbor_view root(data, indexed);
+
+        CHECK(root.is_object());
+        CHECK(root.size() == 4);
+        CHECK(root.contains("ids"));
+        CHECK_FALSE(root.contains("nope"));
+        CHECK(root.at("name").as<std::string>() == "Cocktail");
+        CHECK(root["name"].as<string_view>() == string_view("Cocktail"));
+        CHECK(root["empty"].is_object());
+        CHECK(root["empty"].empty());
+        CHECK(root["big"].is_number());
+        CHECK(root["big"].tag() == semantic_tag::bigint);
+        CHECK(root["big"].as<std::string>() == "18446744073709551616");
+        CHECK_THROWS(root.at("nope"));
+
+        cbor::cbor_view ids = root["ids"];
+        REQUIRE(ids.is_array());
+        CHECK(ids.size() == 6);
+        CHECK(ids[0].as<int>() == 1);
+        CHECK(ids[1].is_int64());
+        CHECK(ids[1].as<int>() == -2);
+        CHECK(ids[2].as<double>() == 3.5);
+        CHECK(ids[3].as<bool>());
+        CHECK(ids[4].is_null());
+        CHECK(ids[5]["x"].is_array());
+        CHECK_THROWS(ids.at(6));
+
+        std::size_t count = 0;
+        for (auto item : root["ids"].array_range())
+        {
+            CHECK_FALSE(item.is_string());
+            ++count;
+        }
+        CHECK(count == 6);
+
+        std::vector<std::string> keys;
+        for (const auto& member : root.object_range())
+        {
+            keys.push_back(member.key().as<std::string>());
+        }
+        CHECK((keys == std::vector<std::string>{"big","empty","ids","name"}));
+        CHECK(root.find("ids")->value().size() == 6);
+        CHECK(root.find("nope") == root.object_range().end());
+
+        CHECK(ids.as<json>() == j["ids"]);
+        CHECK(root.as<json>() == j);
+        CHECK((ids[5]["x"].as<std::vector<int>>().empty()));
+        std::ostringstream os;
+        os << ids[5];
+        CHECK(os.str() == R"({"x":[]})");
+    }
+}
+
+TEST_CASE("cbor_view indefinite length items")
+{
+    std::vector<uint8_t> data = {0xbf, // map(*)
+                                    0x7f, // text(*)
+                                       0x62,0x6e,0x61, // "na"
+                                       0x62,0x6d,0x65, // "me"
+                                       0xff,
+                                    0x5f, // bytes(*)
+                                       0x42,0x01,0x02,
+                                       0x41,0x03,
+                                       0xff,
+                                    0x61,0x61, // "a"
+                                    0x9f, // array(*)
+                                       0x01,
+                                       0x9f,0x02,0xff,
+                                       0x7f,0x61,0x78,0xff,
+                                       0xff,
+                                    0xff};
+    cbor::cbor_view root(data);
+
+    CHECK(root.size() == 2);
+    CHECK(root.contains("name"));
+    CHECK_FALSE(root.contains("nam"));
+    CHECK((root["name"].as<std::vector<uint8_t>>() == std::vector<uint8_t>{1,2,3}));
+    CHECK_THROWS(root["name"].as<byte_string_view>());
+
+    cbor::cbor_view a = root["a"];
+    CHECK(a.size() == 3);
+    CHECK(a[1][0].as<int>() == 2);
+    CHECK(a[2].as<std::string>() == "x");
+    CHECK(a[2].equals("x"));
+    CHECK_THROWS(a.at(3));
+
+    std::size_t count = 0;
+    for (auto item : a.array_range())
+    {
+        (void)item;
+        ++count;
+    }
+    CHECK(count == 3);
+
+    CHECK(root.as<json>() == cbor::decode_cbor<json>(data));
+}
+
+TEST_CASE("cbor_view stringref")
+{
+    std::vector<uint8_t> data = {0xd9,0x01,0x00, // tag(256)
+                                   0x83, // array(3)
+                                      0xa2, // map(2)
+                                         0x64,0x72,0x61,0x6e,0x6b, // "rank"
+                                         0x04,
+                                         0x65,0x63,0x6f,0x75,0x6e,0x74, // "count"
+                                         0x19,0x01,0xa1,
+                                      0xa2, // map(2)
+                                         0xd8,0x19,0x00, // stringref(0) "rank"
+                                         0x05,
+                                         0xd8,0x19,0x01, // stringref(1) "count"
+                                         0xd9,0x01,0x00, // tag(256)
+                                            0x82, // array(2)
+                                               0x63,0x61,0x61,0x61, // "aaa"
+                                               0xd8,0x19,0x00, // stringref(0) "aaa"
+                                      0xd8,0x19,0x01}; // stringref(1) "count"
+
+    cbor::cbor_view root(data);
+    REQUIRE(root.is_array());
+    CHECK(root.size() == 3);
+    CHECK(root[0]["rank"].as<int>() == 4);
+    CHECK(root[1]["rank"].as<int>() == 5);
+    CHECK(root[2].as<std::string>() == "count");
+
+    cbor::cbor_view inner = root[1]["count"];
+    CHECK(inner[0].as<std::string>() == "aaa");
+    CHECK(inner[1].as<std::string>() == "aaa");
+
+    json expected = cbor::decode_cbor<json>(data);
+    CHECK(root.as<json>() == expected);
+    CHECK(root[1].as<json>() == expected[1]);
+    CHECK(inner.as<json>() == expected[1]["count"]);
+}
+
+TEST_CASE("cbor_view packed strings")
+{
+    json j = json::parse(R"([{"category":"reference","title":"Sayings"},{"category":"fiction","title":"Sword"}])");
+    std::vector<uint8_t> data;
+    cbor::cbor_options options;
+    options.pack_strings(true);
+    cbor::encode_cbor(j, data, options);
+
+    cbor::cbor_view root(data, true);
+    CHECK(root[1]["category"].as<std::string>() == "fiction");
+    CHECK(root[1]["title"].as<std::string>() == "Sword");
+    CHECK(root[1].as<json>() == j[1]);
+}
+
+TEST_CASE("cbor_view errors")
+{
+    std::vector<uint8_t> data = {0x82,0x01}; // array(2) with one element
+    cbor::cbor_view root(data);
+    CHECK(root[0].as<int>() == 1);
+    CHECK_THROWS(root.at(1).as<int>());
+    CHECK_THROWS(root.as<json>());
+
+    // -1 - (2^64 - 1) does not fit in an int64_t
+    std::vector<uint8_t> negative = {0x3b,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff};
+    cbor::cbor_view n(negative);
+    CHECK_THROWS_AS(n.as<int64_t>(), ser_error);
+    CHECK(n.as<double>() == -18446744073709551616.0);
+}
+
+TEST_CASE("cbor_view truncated input")
+{
+    SECTION("definite length key")
+    {
+        std::vector<uint8_t> data = {0xa1,0x65,'a','b'}; // map(1), key text(5) with two bytes
+        cbor::cbor_view root(data);
+        CHECK_THROWS_AS(root.contains("abcde"), ser_error);
+        CHECK_THROWS_AS(root.at("abcde"), ser_error);
+    }
+
+    SECTION("definite length strings")
+    {
+        std::vector<uint8_t> text = {0x65,'a','b'};
+        CHECK_THROWS_AS(cbor::cbor_view(text).as<string_view>(), ser_error);
+
+        std::vector<uint8_t> bytes = {0x45,0x01,0x02};
+        CHECK_THROWS_AS(cbor::cbor_view(bytes).as<byte_string_view>(), ser_error);
+    }
+
+    SECTION("indefinite length key")
+    {
+        std::vector<uint8_t> data = {0xa1,0x7f,0x61,'a',0x65,'b'}; // chunk text(5) with one byte
+        cbor::cbor_view root(data);
+        CHECK_THROWS_AS(root.contains("abcdef"), ser_error);
+    }
+
+    SECTION("chunk of another major type")
+    {
+        std::vector<uint8_t> data = {0xa1,0x7f,0x61,'a',0x41,'b',0xff,0x01}; // byte string chunk in a text string
+        cbor::cbor_view root(data);
+        CHECK_THROWS_AS(root.contains("ab"), ser_error);
+        CHECK_THROWS_AS(root.at("ab"), ser_error);
+    }
+}
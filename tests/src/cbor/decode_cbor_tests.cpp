@@ -661,3 +661,41 @@ TEST_CASE("cbor bigfloat tests")
     }
 } 
 
+
+TEST_CASE("decode cbor definite and indefinite length containers")
+{
+    SECTION("nested")
+    {
+        std::vector<uint8_t> v = {0x9f, // Start indefinite length array
+                                    0xa2, // Map of length 2
+                                      0x61,'b',0x01,
+                                      0x61,'a',0x9f, // Start indefinite length array
+                                        0x01,
+                                        0x82,0x02,0x03, // Array of length 2
+                                      0xff,
+                                    0x83,0x01,0x02, // Array of length 3
+                                      0xa1,0x61,'c',0xf5, // Map of length 1
+                                  0xff};
+
+        json j = cbor::decode_cbor<json>(v);
+        CHECK(j == json::parse(R"([{"a":[1,[2,3]],"b":1},[1,2,{"c":true}]])"));
+
+        ojson oj = cbor::decode_cbor<ojson>(v);
+        CHECK(oj.to_string() == R"([{"b":1,"a":[1,[2,3]]},[1,2,{"c":true}]])");
+    }
+
+    SECTION("duplicate keys keep the first")
+    {
+        std::vector<uint8_t> v = {0xa3, // Map of length 3
+                                  0x61,'b',0x01,
+                                  0x61,'a',0x02,
+                                  0x61,'b',0x03};
+
+        json j = cbor::decode_cbor<json>(v);
+        CHECK(j.to_string() == R"({"a":2,"b":1})");
+
+        ojson oj = cbor::decode_cbor<ojson>(v);
+        CHECK(oj.to_string() == R"({"b":1,"a":2})");
+        CHECK(oj.at("a") == 2);
+    }
+}
@@ -145,3 +145,55 @@ TEST_CASE("cbor_arrays_and_maps")
     check_encode_cbor({ 0xa1,0x62,'o','c',0x84,'\0','\1','\2','\3' }, json::parse("{\"oc\": [0, 1, 2, 3]}"));
 }
 
+
+namespace encode_cbor_tests {
+
+    // Throws from every second conversion, so that the writing pass of an exact_size_arg overload fails
+    struct flaky
+    {
+        mutable int calls = 0;
+    };
+}
+
+namespace jsoncons {
+
+    template <class Json>
+    struct json_type_traits<Json,encode_cbor_tests::flaky>
+    {
+        static Json to_json(const encode_cbor_tests::flaky& val)
+        {
+            if (++val.calls % 2 == 0)
+            {
+                JSONCONS_THROW(std::runtime_error("Second pass"));
+            }
+            return Json("abc");
+        }
+    };
+}
+
+TEST_CASE("encode_cbor with exact_size_arg")
+{
+    json j = json::parse(R"({"name":"a\"b","values":[1,-2,3.5,100000,true,null],"big":18446744073709551616,"nested":[[],[{}]]})");
+
+    std::vector<uint8_t> expected = {0x01};
+    cbor::encode_cbor(j, expected);
+
+    std::vector<uint8_t> v = {0x01};
+    cbor::encode_cbor(exact_size_arg, j, v);
+    CHECK(v == expected);
+
+    std::map<std::string,std::vector<int>> m = {{"a",{1,-300,70000}},{"b",{}}};
+    std::vector<uint8_t> expected2;
+    cbor::encode_cbor(m, expected2);
+    std::vector<uint8_t> v2;
+    cbor::encode_cbor(exact_size_arg, m, v2);
+    CHECK(v2 == expected2);
+
+    SECTION("failure restores the size")
+    {
+        encode_cbor_tests::flaky val;
+        std::vector<uint8_t> v3 = {0x01};
+        CHECK_THROWS(cbor::encode_cbor(exact_size_arg, val, v3));
+        CHECK(v3 == std::vector<uint8_t>{0x01});
+    }
+}
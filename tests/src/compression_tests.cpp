@@ -0,0 +1,240 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/compression.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/prefetching_source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+#if defined(JSONCONS_HAS_ZLIB) || defined(JSONCONS_HAS_ZSTD)
+
+namespace {
+
+    json make_compression_test_document()
+    {
+        json doc(json_array_arg);
+        for (int i = 0; i < 2000; ++i)
+        {
+            json item;
+            item["id"] = i;
+            item["name"] = std::string("name") + std::to_string(i);
+            item["value"] = i * 0.25;
+            doc.push_back(std::move(item));
+        }
+        return doc;
+    }
+}
+
+#endif
+
+#if defined(JSONCONS_HAS_ZLIB)
+
+TEST_CASE("gzip_source tests")
+{
+    SECTION("file compressed with gzip")
+    {
+        std::ifstream plain_is("./input/address-book.json");
+        json expected = json::parse(plain_is);
+
+        std::ifstream is("./input/address-book.json.gz", std::ios::binary);
+        REQUIRE(is);
+        json_decoder<json> decoder;
+        basic_json_reader<char,gzip_source> reader(is, decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("concatenated members")
+    {
+        std::stringstream ss;
+        {
+            gzip_sink sink(ss);
+            sink.append("[1,", 3);
+        }
+        {
+            gzip_sink sink(ss);
+            sink.append("2]", 2);
+        }
+        gzip_source source(ss);
+        std::string s(10, ' ');
+        CHECK(source.read(&s[0], s.size()) == 5);
+        CHECK(s.substr(0,5) == "[1,2]");
+        CHECK(source.eof());
+        CHECK_FALSE(source.is_error());
+    }
+
+    SECTION("corrupt input")
+    {
+        std::stringstream ss;
+        {
+            gzip_sink sink(ss);
+            std::string s(1000, 'a');
+            sink.append(s.data(), s.size());
+        }
+        std::string data = ss.str();
+        data[data.size()/2] ^= 0x5a;
+        std::istringstream is(data);
+        gzip_source source(is);
+        std::vector<char> v(2000);
+        source.read(v.data(), v.size());
+        CHECK(source.eof());
+        CHECK(source.is_error());
+    }
+
+    SECTION("truncated input")
+    {
+        std::stringstream ss;
+        {
+            gzip_sink sink(ss);
+            std::string s(1000, 'a');
+            sink.append(s.data(), s.size());
+        }
+        std::string data = ss.str();
+        std::istringstream is(data.substr(0, data.size() - 4));
+        gzip_source source(is);
+        std::vector<char> v(2000);
+        source.read(v.data(), v.size());
+        CHECK(source.is_error());
+    }
+
+    SECTION("json round trip, cursor and prefetching")
+    {
+        json doc = make_compression_test_document();
+
+        std::stringstream ss;
+        {
+            basic_json_encoder<char,gzip_sink> encoder(ss);
+            doc.dump(encoder);
+        }
+        std::string compressed = ss.str();
+
+        {
+            std::istringstream is(compressed);
+            json_decoder<json> decoder;
+            basic_json_reader<char,gzip_source> reader(is, decoder);
+            reader.read();
+            CHECK(decoder.get_result() == doc);
+        }
+        {
+            std::istringstream is(compressed);
+            basic_json_cursor<char,gzip_source> cursor(is);
+            std::size_t count = 0;
+            for (; !cursor.done(); cursor.next())
+            {
+                if (cursor.current().event_type() == staj_event_type::begin_object)
+                {
+                    ++count;
+                }
+            }
+            CHECK(count == doc.size());
+        }
+        {
+            // Decompress on a helper thread
+            std::istringstream is(compressed);
+            json_decoder<json> decoder;
+            basic_json_reader<char,prefetching_source<gzip_source>> reader(is, decoder);
+            reader.read();
+            CHECK(decoder.get_result() == doc);
+        }
+    }
+
+    SECTION("msgpack round trip")
+    {
+        json doc = make_compression_test_document();
+
+        std::stringstream ss;
+        {
+            msgpack::basic_msgpack_encoder<binary_gzip_sink> encoder(ss);
+            doc.dump(encoder);
+        }
+
+        json_decoder<json> decoder;
+        msgpack::basic_msgpack_reader<binary_gzip_source> reader(ss, decoder);
+        reader.read();
+        CHECK(decoder.get_result() == doc);
+    }
+}
+
+#endif // defined(JSONCONS_HAS_ZLIB)
+
+#if defined(JSONCONS_HAS_ZSTD)
+
+TEST_CASE("zstd_source tests")
+{
+    json doc = make_compression_test_document();
+    std::vector<uint8_t> cbor_data;
+    cbor::encode_cbor(doc, cbor_data);
+
+    SECTION("data compressed with ZSTD_compress")
+    {
+        std::string compressed(ZSTD_compressBound(cbor_data.size()), 0);
+        std::size_t n = ZSTD_compress(&compressed[0], compressed.size(), cbor_data.data(), cbor_data.size(), 3);
+        REQUIRE_FALSE(ZSTD_isError(n));
+        compressed.resize(n);
+
+        std::istringstream is(compressed);
+        json_decoder<json> decoder;
+        cbor::basic_cbor_reader<binary_zstd_source> reader(is, decoder);
+        reader.read();
+        CHECK(decoder.get_result() == doc);
+    }
+
+    SECTION("cbor round trip and cursor")
+    {
+        std::stringstream ss;
+        {
+            cbor::basic_cbor_encoder<binary_zstd_sink> encoder(ss);
+            doc.dump(encoder);
+        }
+        std::string compressed = ss.str();
+        CHECK(compressed.size() < cbor_data.size());
+
+        {
+            std::istringstream is(compressed);
+            json_decoder<json> decoder;
+            cbor::basic_cbor_reader<binary_zstd_source> reader(is, decoder);
+            reader.read();
+            CHECK(decoder.get_result() == doc);
+        }
+        {
+            std::istringstream is(compressed);
+            cbor::basic_cbor_cursor<binary_zstd_source> cursor(is);
+            std::size_t count = 0;
+            for (; !cursor.done(); cursor.next())
+            {
+                if (cursor.current().event_type() == staj_event_type::begin_object)
+                {
+                    ++count;
+                }
+            }
+            CHECK(count == doc.size());
+        }
+    }
+
+    SECTION("truncated input")
+    {
+        std::stringstream ss;
+        {
+            binary_zstd_sink sink(ss);
+            sink.append(cbor_data.data(), cbor_data.size());
+        }
+        std::string data = ss.str();
+        std::istringstream is(data.substr(0, data.size() / 2));
+        binary_zstd_source source(is);
+        std::vector<uint8_t> v(cbor_data.size());
+        source.read(v.data(), v.size());
+        CHECK(source.eof());
+        CHECK(source.is_error());
+    }
+}
+
+#endif // defined(JSONCONS_HAS_ZSTD)
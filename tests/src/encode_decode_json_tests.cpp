@@ -281,3 +281,81 @@ TEST_CASE("encode/decode map with integer key")
     CHECK(m[2] == result[2]);
 }
 
+
+namespace encode_json_tests {
+
+    // Throws from every second conversion, so that the writing pass of an exact_size_arg overload fails
+    struct flaky
+    {
+        mutable int calls = 0;
+    };
+}
+
+namespace jsoncons {
+
+    template <class Json>
+    struct json_type_traits<Json,encode_json_tests::flaky>
+    {
+        static Json to_json(const encode_json_tests::flaky& val)
+        {
+            if (++val.calls % 2 == 0)
+            {
+                JSONCONS_THROW(std::runtime_error("Second pass"));
+            }
+            return Json("abc");
+        }
+    };
+}
+
+TEST_CASE("encode_json with exact_size_arg")
+{
+    json j = json::parse(R"({"name":"a\"b\u0001\n","values":[1,-2,3.5,1e300,true,null],"empty":{},"nested":[[],[{}]]})");
+
+    SECTION("compressed")
+    {
+        std::string expected;
+        j.dump(expected);
+
+        std::string s;
+        j.dump(exact_size_arg, s);
+        CHECK(s == expected);
+        CHECK(s.size() == expected.size());
+    }
+    SECTION("pretty, appended to existing content")
+    {
+        std::string expected = "prefix";
+        j.dump(expected, json_options(), indenting::indent);
+
+        std::string s = "prefix";
+        encode_json(exact_size_arg, j, s, json_options(), indenting::indent);
+        CHECK(s == expected);
+    }
+    SECTION("non-json value")
+    {
+        std::map<std::string,std::vector<double>> m = {{"a",{1.5,2}},{"b\t",{}}};
+        std::string expected;
+        encode_json(m, expected, indenting::indent);
+
+        std::string s;
+        encode_json(exact_size_arg, m, s, json_options(), indenting::indent);
+        CHECK(s == expected);
+    }
+    SECTION("escape_all_non_ascii")
+    {
+        json k(u8"é中\U0001F600");
+        auto options = json_options{}.escape_all_non_ascii(true);
+        std::string expected;
+        k.dump(expected, options);
+
+        std::string s;
+        k.dump(exact_size_arg, s, options);
+        CHECK(s == expected);
+    }
+    SECTION("failure restores the size")
+    {
+        encode_json_tests::flaky val;
+        std::string s = "prefix";
+        CHECK_THROWS(encode_json(exact_size_arg, val, s));
+        CHECK(s == "prefix");
+    }
+}
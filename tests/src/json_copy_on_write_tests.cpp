@@ -0,0 +1,90 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jsonpatch/jsonpatch.hpp>
+#include <catch/catch.hpp>
+#include <string>
+
+using namespace jsoncons;
+
+using cow_json = basic_json<char,copy_on_write_policy<sorted_policy>>;
+using cow_ojson = basic_json<char,copy_on_write_policy<preserve_order_policy>>;
+
+namespace {
+
+    template <class Json>
+    bool same_storage(const Json& a, const Json& b)
+    {
+        if (a.is_object() && b.is_object())
+        {
+            return &a.object_value() == &b.object_value();
+        }
+        if (a.is_array() && b.is_array())
+        {
+            return &a.array_value() == &b.array_value();
+        }
+        return false;
+    }
+}
+
+TEST_CASE("copy_on_write copies share storage")
+{
+    const cow_json a = cow_json::parse(R"({"audit":{"user":"x","ids":[1,2,3]},"body":{"items":[{"n":1},{"n":2}]}})");
+    cow_json b = a;
+
+    CHECK(same_storage(a, b));
+    CHECK(a == b);
+
+    SECTION("write clones only the path")
+    {
+        b["body"]["items"][0]["n"] = 10;
+
+        CHECK(a.at("body").at("items").at(0).at("n").as<int>() == 1);
+        CHECK(b.at("body").at("items").at(0).at("n").as<int>() == 10);
+
+        const cow_json& cb = b;
+        CHECK_FALSE(same_storage(a, cb));
+        CHECK_FALSE(same_storage(a.at("body"), cb.at("body")));
+        CHECK(same_storage(a.at("audit"), cb.at("audit")));
+        CHECK(same_storage(a.at("body").at("items").at(1), cb.at("body").at("items").at(1)));
+    }
+
+    SECTION("destroying copies")
+    {
+        {
+            cow_json c = b;
+            cow_json d = std::move(c);
+            d["audit"].erase("user");
+        }
+        b = cow_json();
+        CHECK(a.at("audit").at("user").as<std::string>() == "x");
+    }
+}
+
+TEST_CASE("copy_on_write with apply_patch and merge_or_update")
+{
+    const cow_ojson doc = cow_ojson::parse(R"({"a":{"b":[1,2]},"c":{"d":true}})");
+
+    SECTION("apply_patch")
+    {
+        cow_ojson patch = cow_ojson::parse(R"([{"op":"add","path":"/a/b/-","value":3},{"op":"remove","path":"/c/d"}])");
+        cow_ojson target = doc;
+        jsonpatch::apply_patch(target, patch);
+
+        CHECK(doc == cow_ojson::parse(R"({"a":{"b":[1,2]},"c":{"d":true}})"));
+        CHECK(target == cow_ojson::parse(R"({"a":{"b":[1,2,3]},"c":{}})"));
+    }
+
+    SECTION("merge_or_update")
+    {
+        cow_ojson target = doc;
+        cow_ojson source = cow_ojson::parse(R"({"c":{"e":1},"f":2})");
+        target.merge_or_update(source);
+
+        CHECK(doc.at("c").size() == 1);
+        CHECK(target == cow_ojson::parse(R"({"a":{"b":[1,2]},"c":{"e":1},"f":2})"));
+        const cow_ojson& ct = target;
+        CHECK(same_storage(doc.at("a"), ct.at("a")));
+    }
+}
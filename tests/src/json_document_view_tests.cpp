@@ -0,0 +1,107 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_document_view.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("json_document_view navigation")
+{
+    std::string s = R"({"name":"a\"b","ids":[1,-2,3.5,true,null,{"x":[]}],"empty":{},"big":18446744073709551616})";
+
+    json_document doc;
+    doc.parse(s);
+    json_document_view root = doc.root();
+
+    CHECK(root.is_object());
+    CHECK(root.size() == 4);
+    CHECK(root.contains("ids"));
+    CHECK_FALSE(root.contains("nope"));
+    CHECK(root.at("name").as<std::string>() == "a\"b");
+    CHECK(root["name"].as_string_view() == string_view("a\"b"));
+    CHECK(root["empty"].is_object());
+    CHECK(root["empty"].empty());
+    CHECK(root["big"].is_number());
+    CHECK(root["big"].tag() == semantic_tag::bigint);
+    CHECK_THROWS(root.at("nope"));
+
+    json_document_view ids = root["ids"];
+    REQUIRE(ids.is_array());
+    CHECK(ids.size() == 6);
+    CHECK(ids[0].as<int>() == 1);
+    CHECK(ids[1].is_int64());
+    CHECK_FALSE(ids[1].is_uint64());
+    CHECK(ids[2].as<double>() == 3.5);
+    CHECK(ids[3].as<bool>());
+    CHECK(ids[4].is_null());
+    CHECK(ids[5]["x"].is_array());
+    CHECK(ids[5].type() == json_type::object_value);
+    CHECK_THROWS(ids.at(6));
+
+    std::size_t count = 0;
+    for (auto item : ids.array_range())
+    {
+        CHECK_FALSE((item.is_object() && item.size() != 1));
+        ++count;
+    }
+    CHECK(count == 6);
+
+    std::vector<std::string> keys;
+    for (const auto& member : root.object_range())
+    {
+        keys.emplace_back(member.key().data(), member.key().size());
+    }
+    CHECK((keys == std::vector<std::string>{"name","ids","empty","big"}));
+    CHECK(root.find("empty")->value().size() == 0);
+
+    SECTION("dump and materialize")
+    {
+        CHECK(root.to_string() == ojson::parse(s).to_string());
+        CHECK(ids.to_string() == R"([1,-2,3.5,true,null,{"x":[]}])");
+        CHECK(root.as<json>() == json::parse(s));
+        CHECK(ids.as<ojson>() == ojson::parse(R"([1,-2,3.5,true,null,{"x":[]}])"));
+        std::ostringstream os;
+        os << ids[5];
+        CHECK(os.str() == R"({"x":[]})");
+    }
+}
+
+TEST_CASE("json_document reuse")
+{
+    json_document doc;
+    doc.parse(R"([1,2,3])");
+    CHECK(doc.root().size() == 3);
+
+    doc.parse(R"({"a":"b"})");
+    CHECK(doc.root()["a"].as<std::string>() == "b");
+
+    std::istringstream is(R"("text")");
+    doc.parse(is);
+    CHECK(doc.root().as<std::string>() == "text");
+
+    std::error_code ec;
+    doc.parse(R"({"a":)", json_options(), ec);
+    CHECK(ec);
+}
+
+TEST_CASE("json_document from cbor")
+{
+    json j = json::parse(R"({"a":[1,2,{"b":"c"}],"d":1.5})");
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(j, data);
+
+    json_document doc;
+    json_tape_builder builder(doc.tape());
+    cbor::cbor_bytes_reader reader(data, builder);
+    reader.read();
+    REQUIRE(builder.is_valid());
+
+    CHECK(doc.root()["a"][2]["b"].as<std::string>() == "c");
+    CHECK(doc.root().as<json>() == j);
+}
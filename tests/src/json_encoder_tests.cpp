@@ -29,3 +29,183 @@ TEST_CASE("test_byte_string_serialization")
     CHECK(os.str() == expected);
 }
 
+
+TEST_CASE("escape_string at every offset")
+{
+    // Put each special char at each offset of strings that span several vector widths
+    std::vector<std::pair<std::string,std::string>> specials = {{"\"","\\\""},{"\\","\\\\"},{"\n","\\n"},
+        {std::string(1,'\x01'),"\\u0001"},{"\x7f","\\u007F"},{"/","/"},{"\xc3\xa9","\xc3\xa9"}};
+
+    for (const auto& special : specials)
+    {
+        for (std::size_t length = 0; length < 70; ++length)
+        {
+            for (std::size_t pos = 0; pos <= length; ++pos)
+            {
+                std::string s = std::string(pos, 'a') + special.first + std::string(length - pos, 'b');
+                std::string expected = std::string(pos, 'a') + special.second + std::string(length - pos, 'b');
+
+                std::string result;
+                string_sink<std::string> sink(result);
+                std::size_t count = jsoncons::detail::escape_string(s.data(), s.size(), false, false, sink);
+                sink.flush();
+                CHECK(result == expected);
+                CHECK(count == expected.size());
+            }
+        }
+    }
+}
+
+TEST_CASE("escape_string options")
+{
+    std::string s = "0123456789abcdef/0123456789abcdef\xc3\xa9 0123456789abcdef";
+
+    json_options options;
+    options.escape_solidus(true);
+    CHECK(json(s).to_string(options) == "\"0123456789abcdef\\/0123456789abcdef\xc3\xa9 0123456789abcdef\"");
+
+    options.escape_solidus(false).escape_all_non_ascii(true);
+    CHECK(json(s).to_string(options) == "\"0123456789abcdef/0123456789abcdef\\u00E9 0123456789abcdef\"");
+
+    std::wstring ws = L"0123456789abcdef\"\u00e9";
+    CHECK(wjson(ws).to_string() == L"\"0123456789abcdef\\\"\u00e9\"");
+}
+
+namespace {
+
+    // A sink without reserve and commit
+    class plain_string_sink
+    {
+        std::string& s_;
+    public:
+        using value_type = char;
+
+        plain_string_sink(std::string& s)
+            : s_(s)
+        {
+        }
+
+        void flush()
+        {
+        }
+
+        void append(const char* s, std::size_t length)
+        {
+            s_.append(s, length);
+        }
+
+        void push_back(char ch)
+        {
+            s_.push_back(ch);
+        }
+    };
+
+} // namespace
+
+TEST_CASE("sink reserve and commit")
+{
+    SECTION("stream_sink grows a buffer smaller than the reservation")
+    {
+        std::ostringstream os;
+        {
+            stream_sink<char> sink(os, 4);
+            sink.append("ab", 2);
+            char* p = sink.reserve(10);
+            std::memcpy(p, "0123456789", 10);
+            sink.commit(7);
+            sink.push_back('x');
+        }
+        CHECK(os.str() == "ab0123456x");
+    }
+
+    SECTION("string_sink")
+    {
+        std::string s = "ab";
+        string_sink<std::string> sink(s);
+        char* p = sink.reserve(10);
+        std::memcpy(p, "0123456789", 10);
+        sink.commit(3);
+        sink.push_back('x');
+        CHECK(s == "ab012x");
+    }
+
+    SECTION("bytes_sink")
+    {
+        std::vector<uint8_t> v = {1};
+        bytes_sink sink(v);
+        uint8_t* p = sink.reserve(8);
+        p[0] = 2; p[1] = 3;
+        sink.commit(2);
+        CHECK(v == std::vector<uint8_t>({1,2,3}));
+    }
+}
+
+TEST_CASE("json_encoder doubles and indentation")
+{
+    std::string nested = std::string(20, '[') + "1.5" + std::string(20, ']');
+    json j = json::parse(R"([0.1,-1.7976931348623157e308,2.2250738585072014e-308,-5e-324,1e21,123456789012345680.0,-0.0001,{"a":)" + nested + "}]");
+    std::string compressed = R"([0.1,-1.7976931348623157e+308,2.2250738585072014e-308,-5e-324,1e+21,1.2345678901234568e+17,-0.0001,{"a":)" + nested + "}]";
+
+    SECTION("compressed")
+    {
+        std::string s;
+        j.dump(s);
+        CHECK(s == compressed);
+
+        std::string s2;
+        basic_json_compressed_encoder<char,plain_string_sink> encoder(s2);
+        j.dump(encoder);
+        CHECK(s2 == compressed);
+    }
+
+    SECTION("pretty")
+    {
+        json_options options;
+        options.indent_size(2);
+        std::string s;
+        j.dump(s, options, indenting::indent);
+        CHECK(json::parse(s) == j);
+
+        std::string s2;
+        basic_json_encoder<char,plain_string_sink> encoder(s2, options);
+        j.dump(encoder);
+        CHECK(s2 == s);
+
+        // The innermost array is indented 21 levels of 2 spaces
+        CHECK(s.find("\n" + std::string(42, ' ') + "[1.5]\n") != std::string::npos);
+        CHECK(s.find("\n" + std::string(43, ' ') + "[1.5]") == std::string::npos);
+    }
+}
+
+TEST_CASE("json_encoder with gather_sink")
+{
+    std::string big(10000, 'a');
+    big[5000] = '"';
+
+    json j(json_object_arg);
+    j.try_emplace("big", big);
+    j.try_emplace("small", "x");
+    j.try_emplace("n", 1.5);
+
+    std::string expected;
+    j.dump(expected);
+
+    gather_buffer<char> buf;
+    encode_json(j, buf);
+    CHECK(buf.size() == expected.size());
+
+    std::string s;
+    std::vector<const char*> external;
+    const char* p = j.at("big").as_string_view().data();
+    for (auto segment : buf.segments())
+    {
+        s.append(segment.data(), segment.size());
+        if (segment.data() >= p && segment.data() < p + big.size())
+        {
+            external.push_back(segment.data());
+        }
+    }
+    CHECK(s == expected);
+    // The clean runs either side of the escaped quote are referenced in place
+    CHECK((external == std::vector<const char*>{p, p + 5001}));
+}
@@ -0,0 +1,148 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <unordered_set>
+#include <unordered_map>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+using hc_json = basic_json<char,cached_hash_policy<sorted_policy>>;
+
+TEST_CASE("std::hash<json> tests")
+{
+    std::hash<json> hasher;
+
+    SECTION("numbers that compare equal hash equal")
+    {
+        CHECK(hasher(json(1)) == hasher(json(1u)));
+        CHECK(hasher(json(1)) == hasher(json(1.0)));
+        CHECK(hasher(json(half_arg, 0x3c00)) == hasher(json(1.0)));
+        CHECK(hasher(json(0.0)) == hasher(json(-0.0)));
+        CHECK(hasher(json(1)) != hasher(json(2)));
+    }
+
+    SECTION("tags are ignored")
+    {
+        CHECK(hasher(json("2020-01-01", semantic_tag::datetime)) == hasher(json("2020-01-01")));
+    }
+
+    SECTION("containers")
+    {
+        json a = json::parse(R"({"a":[1,2,3],"b":{"c":null}})");
+        json b = json::parse(R"({"b":{"c":null},"a":[1.0,2,3]})");
+        CHECK(a == b);
+        CHECK(hasher(a) == hasher(b));
+        CHECK(hasher(a) != hasher(json::parse(R"({"a":[1,3,2],"b":{"c":null}})")));
+
+        json typed(typed_array_arg, std::vector<int16_t>{1, 2, 3});
+        CHECK(hasher(typed) == hasher(a["a"]));
+        CHECK(hasher(json()) != hasher(json(json_array_arg)));
+        CHECK(hasher(json(json_object_arg)) == hasher(json::parse("{}")));
+    }
+
+    SECTION("typed arrays")
+    {
+        json doubles(typed_array_arg, std::vector<double>{-0.0, 1.5, 1e300});
+        CHECK(hasher(doubles) == hasher(json::parse("[0,1.5,1e300]")));
+
+        json floats(typed_array_arg, std::vector<float>{0.5f, -2.0f});
+        CHECK(hasher(floats) == hasher(json::parse("[0.5,-2]")));
+
+        json halfs(typed_array_arg, half_arg, std::vector<uint16_t>{0x3c00, 0xc000});
+        CHECK(hasher(halfs) == hasher(json::parse("[1,-2]")));
+
+        json int64s(typed_array_arg, std::vector<int64_t>{-1, 0, 10});
+        CHECK(hasher(int64s) == hasher(json::parse("[-1,0,10]")));
+        CHECK(hasher(int64s) != hasher(json::parse("[-1,10,0]")));
+    }
+
+    SECTION("unordered containers")
+    {
+        std::unordered_set<json> set;
+        set.insert(json::parse("[1,2]"));
+        set.insert(json::parse("[1.0,2.0]"));
+        set.insert(json::parse(R"({"x":1})"));
+        CHECK(set.size() == 2);
+
+        std::unordered_map<ojson,int> map;
+        map[ojson::parse(R"({"k":true})")] = 1;
+        CHECK(map.count(ojson::parse(R"({"k":true})")) == 1);
+    }
+}
+
+TEST_CASE("cached_hash_policy tests")
+{
+    std::hash<hc_json> hasher;
+
+    hc_json a = hc_json::parse(R"({"a":[1,2,3],"b":{"c":null}})");
+    hc_json b = a;
+
+    std::size_t h = hasher(a);
+    CHECK(hasher(a) == h);
+    CHECK(hasher(b) == h);
+    CHECK(a == b);
+
+    SECTION("mutation clears the cached hash")
+    {
+        b["a"][0] = 10;
+        CHECK(hasher(b) != h);
+        CHECK(a != b);
+        CHECK(hasher(b) == std::hash<json>()(json::parse(R"({"a":[10,2,3],"b":{"c":null}})")));
+
+        b["a"][0] = 1;
+        CHECK(hasher(b) == h);
+        CHECK(a == b);
+    }
+
+    SECTION("changing a nested value after hashing")
+    {
+        hc_json c = hc_json::parse(R"({"x":{"y":1},"z":[[1],[2]]})");
+        hc_json d = c;
+        hc_json& x = c["x"];
+        hc_json& x2 = d["x"];
+        hc_json& z = c["z"][0];
+        hc_json& z2 = d["z"][0];
+        std::size_t hc = hasher(c);
+        CHECK(hasher(d) == hc);
+
+        x["y"] = 2;
+        x2["y"] = 2;
+        CHECK(c == d);
+        CHECK(hasher(c) != hc);
+        CHECK(hasher(c) == hasher(d));
+
+        std::size_t hc2 = hasher(c);
+        z.push_back(3);
+        z2.push_back(3);
+        CHECK(c == d);
+        CHECK(hasher(c) != hc2);
+        CHECK(hasher(c) == hasher(d));
+        CHECK(hasher(c) == std::hash<json>()(json::parse(R"({"x":{"y":2},"z":[[1,3],[2]]})")));
+    }
+
+    SECTION("equality with cached hashes")
+    {
+        hc_json c = hc_json::parse("[1,2,3]");
+        hc_json d = hc_json::parse("[1,2,4]");
+        hc_json e = hc_json::parse("[1.0,2,3]");
+        hasher(c);
+        hasher(d);
+        hasher(e);
+        CHECK(c != d);
+        CHECK(c == e);
+
+        d[2] = 3;
+        CHECK(c == d);
+        hasher(d);
+        CHECK(c == d);
+    }
+
+    SECTION("hash agrees with std::hash<json>")
+    {
+        CHECK(h == std::hash<json>()(json::parse(R"({"a":[1,2,3],"b":{"c":null}})")));
+    }
+}
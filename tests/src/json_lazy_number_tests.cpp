@@ -0,0 +1,180 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("json lazy_number tests")
+{
+    std::string s = R"({"a":1.50,"b":1.23456789012345678901234567890,"c":-2e-3,"d":10,"e":"1.5"})";
+
+    json_options options;
+    options.lazy_number(true);
+
+    json j = json::parse(s, options);
+
+    SECTION("numbers keep their text")
+    {
+        CHECK(j["a"].storage() == storage_kind::short_number_value);
+        CHECK(j["b"].storage() == storage_kind::long_number_value);
+        CHECK(j["d"].storage() == storage_kind::uint64_value);
+        CHECK(j["e"].is_string());
+        CHECK(j.to_string() == s);
+    }
+
+    SECTION("numbers read as doubles")
+    {
+        CHECK(j["a"].is_double());
+        CHECK(j["a"].is_number());
+        CHECK_FALSE(j["a"].is_string());
+        CHECK(j["a"].type() == json_type::double_value);
+        CHECK(j["a"].tag() == semantic_tag::none);
+        CHECK(j["a"].as<double>() == 1.5);
+        CHECK(j["c"].as<double>() == -2e-3);
+        CHECK(j["a"].as<int>() == 1);
+        CHECK(j["b"].as<std::string>() == "1.23456789012345678901234567890");
+    }
+
+    SECTION("comparison")
+    {
+        CHECK(j["a"] == json(1.5));
+        CHECK(json(1.5) == j["a"]);
+        CHECK(j["a"] != j["e"]);
+        CHECK(j["c"] < j["a"]);
+        CHECK(json(1) < j["a"]);
+        CHECK(j == json::parse(s, options));
+        CHECK(std::hash<json>()(j["a"]) == std::hash<json>()(json(1.5)));
+    }
+
+    SECTION("modify one field")
+    {
+        j["d"] = 11;
+        json k = j;
+        CHECK(k["b"].storage() == storage_kind::long_number_value);
+        CHECK(k.to_string() == R"({"a":1.50,"b":1.23456789012345678901234567890,"c":-2e-3,"d":11,"e":"1.5"})");
+    }
+
+    SECTION("other encoders see doubles")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j.at("a"), data);
+        json k = cbor::decode_cbor<json>(data);
+        CHECK(k.storage() == storage_kind::double_value);
+        CHECK(k.tag() == semantic_tag::none);
+        CHECK(k.as<double>() == 1.5);
+
+        std::vector<uint8_t> expected;
+        cbor::encode_cbor(json(1.5), expected);
+        CHECK(data == expected);
+    }
+
+    SECTION("pretty print and filters keep the text")
+    {
+        std::string pretty;
+        j.dump(pretty, indenting::indent);
+        CHECK(pretty.find("1.23456789012345678901234567890") != std::string::npos);
+
+        std::string s2;
+        json_compressed_string_encoder encoder(s2);
+        json_filter filter(encoder);
+        j.dump(filter);
+        CHECK(s2 == s);
+    }
+
+    SECTION("decoding a dump keeps lazy numbers")
+    {
+        json_decoder<json> decoder;
+        j.dump(decoder);
+        json k = decoder.get_result();
+        CHECK(k["b"].storage() == storage_kind::long_number_value);
+        CHECK(k.to_string() == s);
+    }
+
+    SECTION("decode_json")
+    {
+        json k = decode_json<json>(s, options);
+        CHECK(k["b"].storage() == storage_kind::long_number_value);
+
+        std::istringstream is(s);
+        json l = json::parse(is, options);
+        CHECK(l.to_string() == s);
+    }
+}
+
+TEST_CASE("json lazy_number reader tests")
+{
+    std::string s = R"([1.50,-2e-3,10])";
+
+    json_options options;
+    options.lazy_number(true);
+
+    SECTION("json_reader with json_decoder")
+    {
+        json_decoder<json> decoder;
+        json_reader reader(s, decoder, options);
+        reader.read();
+        json j = decoder.get_result();
+        CHECK(j[0].storage() == storage_kind::short_number_value);
+        CHECK(j[1].as<double>() == -2e-3);
+        CHECK(j.to_string() == s);
+    }
+
+    SECTION("json_reader with json_encoder")
+    {
+        std::string out;
+        json_compressed_string_encoder encoder(out);
+        json_reader reader(s, encoder, options);
+        reader.read();
+        CHECK(out == s);
+    }
+
+    SECTION("json_reader with other visitors")
+    {
+        std::vector<uint8_t> data;
+        cbor::cbor_bytes_encoder encoder(data);
+        json_reader reader(s, encoder, options);
+        reader.read();
+
+        std::vector<uint8_t> expected;
+        cbor::cbor_bytes_encoder expected_encoder(expected);
+        json_reader expected_reader(s, expected_encoder);
+        expected_reader.read();
+        CHECK(data == expected);
+    }
+
+    SECTION("lossless_number takes precedence")
+    {
+        options.lossless_number(true);
+        json j = json::parse(s, options);
+        CHECK(j[0].is_string());
+        CHECK(j[0].tag() == semantic_tag::bigdec);
+        CHECK(j[0].as<std::string>() == "1.50");
+    }
+}
+
+TEST_CASE("json_encoder bigdec tests")
+{
+    CHECK(json("273.15", semantic_tag::bigdec).to_string() == "\"273.15\"");
+
+    json_options options;
+    options.lossless_number(true);
+    CHECK(json::parse(R"({"x":1.5})", options).to_string() == R"({"x":"1.5"})");
+}
+
+TEST_CASE("json_encoder number_text_value tests")
+{
+    std::string s;
+    json_compressed_string_encoder encoder(s);
+    encoder.begin_array();
+    encoder.number_text_value("-1.844674407370955161615e+19");
+    encoder.number_text_value("1.");
+    encoder.end_array();
+    encoder.flush();
+    CHECK(s == "[-1.844674407370955161615e+19,1.0]");
+}
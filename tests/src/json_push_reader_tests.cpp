@@ -0,0 +1,116 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_push_reader.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Collects each root value as it is flushed
+    class json_value_collector : public json_filter
+    {
+        json_decoder<json>& decoder_;
+        std::vector<json>& values_;
+    public:
+        json_value_collector(json_decoder<json>& decoder, std::vector<json>& values)
+            : json_filter(decoder), decoder_(decoder), values_(values)
+        {
+        }
+    private:
+        void visit_flush() override
+        {
+            values_.push_back(decoder_.get_result());
+        }
+    };
+
+    std::vector<json> push_in_chunks(const std::string& input, std::size_t chunk_size)
+    {
+        std::vector<json> values;
+        json_decoder<json> decoder;
+        json_value_collector collector(decoder, values);
+        json_push_reader reader(collector);
+
+        std::string chunk;
+        for (std::size_t pos = 0; pos < input.size(); pos += chunk_size)
+        {
+            chunk = input.substr(pos, chunk_size);
+            reader.feed(chunk.data(), chunk.size());
+            // the reader does not hold on to the caller's buffer
+            chunk.assign(chunk.size(), '?');
+        }
+        reader.finish();
+        return values;
+    }
+}
+
+TEST_CASE("json_push_reader tests")
+{
+    std::string input = R"(
+{"name":"Jane Roe","tags":["aéb","\\"],"amount":-1.25e3,"flag":true,"none":null}
+[1,2,[3,{"x":18446744073709551615}]] "text" 10)";
+
+    std::vector<json> expected = {json::parse(R"({"name":"Jane Roe","tags":["aéb","\\"],"amount":-1.25e3,"flag":true,"none":null})"),
+                                  json::parse(R"([1,2,[3,{"x":18446744073709551615}]])"),
+                                  json("text"),
+                                  json(10)};
+
+    SECTION("chunk sizes")
+    {
+        for (std::size_t chunk_size : {1, 2, 3, 7, 16, 1000})
+        {
+            std::vector<json> values = push_in_chunks(input, chunk_size);
+            CHECK(values == expected);
+        }
+    }
+
+    SECTION("unexpected eof")
+    {
+        json_decoder<json> decoder;
+        json_push_reader reader(decoder);
+
+        std::error_code ec;
+        reader.feed(std::string(R"({"a":[1,2)"), ec);
+        REQUIRE_FALSE(ec);
+        reader.finish(ec);
+        CHECK(ec == json_errc::unexpected_eof);
+        CHECK(reader.stopped());
+    }
+
+    SECTION("error stops the reader until reset")
+    {
+        std::vector<json> values;
+        json_decoder<json> decoder;
+        json_value_collector collector(decoder, values);
+        json_push_reader reader(collector);
+
+        std::error_code ec;
+        reader.feed(std::string("[1,}"), ec);
+        CHECK(ec == json_errc::expected_value);
+        CHECK(reader.stopped());
+
+        ec = std::error_code();
+        reader.feed(std::string("[2]"), ec);
+        CHECK_FALSE(ec);
+        CHECK(values.empty());
+
+        decoder.reset();
+        reader.reset();
+        reader.feed(std::string("[3] "), ec);
+        reader.finish(ec);
+        CHECK_FALSE(ec);
+        REQUIRE(values.size() == 1);
+        CHECK(values[0] == json::parse("[3]"));
+    }
+
+    SECTION("throwing overload")
+    {
+        json_decoder<json> decoder;
+        json_push_reader reader(decoder);
+        CHECK_THROWS_AS(reader.feed(std::string("[1 2]")), ser_error);
+    }
+}
@@ -0,0 +1,79 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
+#include <catch/catch.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+using sk_json = basic_json<char,shared_key_policy<sorted_policy>>;
+using sk_ojson = basic_json<char,shared_key_policy<preserve_order_policy>>;
+
+TEST_CASE("shared_key tests")
+{
+    shared_key a("name");
+    shared_key b(a);
+    shared_key c(std::string("name"));
+
+    CHECK(a.shares_storage_with(b));
+    CHECK_FALSE(a.shares_storage_with(c));
+    CHECK(a == b);
+    CHECK(a == c);
+    CHECK(a == "name");
+    CHECK(a == string_view("name"));
+    CHECK(a < shared_key("namf"));
+    CHECK(a.size() == 4);
+    CHECK(std::string(a.c_str()) == "name");
+    CHECK(shared_key().empty());
+    CHECK(std::hash<shared_key>()(a) == std::hash<shared_key>()(c));
+}
+
+TEST_CASE("json with shared keys")
+{
+    std::string s = R"([{"id":1,"name":"a","tags":[]},{"id":2,"name":"b","tags":["x"]}])";
+
+    SECTION("parse shares keys")
+    {
+        sk_json j = sk_json::parse(s);
+        REQUIRE(j.size() == 2);
+        auto it0 = j[0].object_range().begin();
+        auto it1 = j[1].object_range().begin();
+        for (; it0 != j[0].object_range().end(); ++it0, ++it1)
+        {
+            CHECK(it0->key() == it1->key());
+            CHECK(it0->key().shares_storage_with(it1->key()));
+        }
+        CHECK(j.to_string() == json::parse(s).to_string());
+    }
+
+    SECTION("cbor shares keys")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(json::parse(s), data);
+        sk_ojson j = cbor::decode_cbor<sk_ojson>(data);
+        CHECK(j[0].object_range().begin()->key().shares_storage_with(j[1].object_range().begin()->key()));
+        CHECK(j.to_string() == s);
+    }
+
+    SECTION("modify")
+    {
+        sk_json j = sk_json::parse(s);
+        j[0]["id"] = 10;
+        j[0].insert_or_assign("extra", true);
+        j[1].erase("tags");
+        CHECK(j[0]["id"].as<int>() == 10);
+        CHECK(j[0].contains("extra"));
+        CHECK_FALSE(j[1].contains("tags"));
+        CHECK(jsonpointer::get(j, "/0/name").as<std::string>() == "a");
+
+        auto m = j[1].as<std::map<std::string,sk_json>>();
+        CHECK(m.size() == 2);
+        sk_json k(m);
+        CHECK(k == j[1]);
+    }
+}
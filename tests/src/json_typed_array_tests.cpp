@@ -0,0 +1,223 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <vector>
+#include <list>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("json typed array construction")
+{
+    SECTION("from vector<double>")
+    {
+        std::vector<double> v = {1.5, 2.5, 3.5};
+        json j(typed_array_arg, v);
+
+        CHECK(j.is_array());
+        CHECK(j.is_typed_array());
+        CHECK(j.type() == json_type::array_value);
+        CHECK(j.storage() == storage_kind::typed_array_value);
+        CHECK(j.size() == 3);
+        CHECK_FALSE(j.empty());
+        CHECK(j.as_typed_array_view().type() == typed_array_type::double_value);
+        CHECK(j.to_string() == "[1.5,2.5,3.5]");
+    }
+
+    SECTION("to_json packs contiguous containers of numbers")
+    {
+        json j = std::vector<int32_t>{-1, 0, 1};
+        CHECK(j.is_typed_array());
+        CHECK(j.to_string() == "[-1,0,1]");
+
+        json k = std::list<int32_t>{-1, 0, 1};
+        CHECK_FALSE(k.is_typed_array());
+        CHECK(j == k);
+    }
+
+    SECTION("half")
+    {
+        std::vector<uint16_t> v = {0x3c00, 0x4000}; // 1.0, 2.0
+        json j(typed_array_arg, half_arg, v);
+        CHECK(j.as_typed_array_view().type() == typed_array_type::half_value);
+        CHECK(j[1].is_half());
+        CHECK(j[1].as<double>() == 2.0);
+    }
+}
+
+TEST_CASE("json typed array element access")
+{
+    json j(typed_array_arg, std::vector<uint8_t>{1, 2, 3});
+
+    SECTION("const access keeps packed storage")
+    {
+        const json& cj = j;
+        CHECK(cj[0].as<int>() == 1);
+        CHECK(cj.at(2).as<int>() == 3);
+        int sum = 0;
+        for (const auto& item : cj.array_range())
+        {
+            sum += item.as<int>();
+        }
+        CHECK(sum == 6);
+        CHECK(j.is_typed_array());
+    }
+
+    SECTION("mutable access unpacks")
+    {
+        j[1] = "two";
+        CHECK_FALSE(j.is_typed_array());
+        CHECK(j == json::parse(R"([1,"two",3])"));
+    }
+
+    SECTION("push_back unpacks")
+    {
+        j.push_back(4.5);
+        CHECK(j.is_array());
+        CHECK_FALSE(j.is_typed_array());
+        CHECK(j.size() == 4);
+        CHECK(j[3].as<double>() == 4.5);
+    }
+
+    SECTION("clear")
+    {
+        j.clear();
+        CHECK(j.is_array());
+        CHECK(j.empty());
+    }
+
+    SECTION("copy and swap")
+    {
+        json k = j;
+        CHECK(k.is_typed_array());
+        CHECK(k == j);
+
+        json l("string");
+        l.swap(k);
+        CHECK(l.is_typed_array());
+        CHECK(k.is_string());
+    }
+}
+
+TEST_CASE("json typed array comparison")
+{
+    json a(typed_array_arg, std::vector<int16_t>{1, 2, 3});
+    json b(typed_array_arg, std::vector<double>{1.0, 2.0, 3.0});
+    json c = json::parse("[1,2,3]");
+    json d = json::parse("[1,2,4]");
+
+    CHECK(a == b);
+    CHECK(a == c);
+    CHECK(c == a);
+    CHECK(a != d);
+    CHECK(a < d);
+    CHECK_FALSE(d < a);
+    CHECK(json(1) < a);
+    CHECK(a < json(json_object_arg, {{"a",1}}));
+}
+
+TEST_CASE("json typed array as vector")
+{
+    json j(typed_array_arg, std::vector<float>{1.0f, 2.0f, 3.0f});
+
+    CHECK(j.is<std::vector<float>>());
+    CHECK((j.as<std::vector<float>>() == std::vector<float>{1.0f, 2.0f, 3.0f}));
+    CHECK((j.as<std::vector<double>>() == std::vector<double>{1.0, 2.0, 3.0}));
+    CHECK((j.as<std::list<int>>() == std::list<int>{1, 2, 3}));
+    CHECK((j.as<std::vector<std::string>>() == std::vector<std::string>{"1.0", "2.0", "3.0"}));
+}
+
+TEST_CASE("json typed array from cbor")
+{
+    std::vector<double> v = {1.25, -2.5, 1e10};
+    std::vector<uint8_t> data;
+    cbor::cbor_options options;
+    options.use_typed_arrays(true);
+    cbor::encode_cbor(v, data, options);
+
+    json j = cbor::decode_cbor<json>(data);
+    REQUIRE(j.is_typed_array());
+    CHECK(j.as_typed_array_view().type() == typed_array_type::double_value);
+    CHECK((j.as<std::vector<double>>() == v));
+
+    SECTION("round trip as typed array")
+    {
+        std::vector<uint8_t> data2;
+        cbor::encode_cbor(j, data2, options);
+        CHECK(data2 == data);
+    }
+
+    SECTION("round trip as array")
+    {
+        std::vector<uint8_t> data2;
+        cbor::encode_cbor(j, data2);
+        json k = cbor::decode_cbor<json>(data2);
+        CHECK_FALSE(k.is_typed_array());
+        CHECK(k == j);
+    }
+}
+
+TEST_CASE("json bulk numeric conversions")
+{
+    SECTION("ordinary array to vector")
+    {
+        json j = json::parse("[1,-2,3.5,4]");
+        CHECK_FALSE(j.is_typed_array());
+        CHECK((j.as<std::vector<double>>() == std::vector<double>{1.0, -2.0, 3.5, 4.0}));
+        CHECK((j.as<std::vector<int64_t>>() == std::vector<int64_t>{1, -2, 3, 4}));
+        CHECK((j.as<std::list<float>>() == std::list<float>{1.0f, -2.0f, 3.5f, 4.0f}));
+
+        json k = json::parse(R"([1,"2",true])");
+        CHECK((k.as<std::vector<int>>() == std::vector<int>{1, 2, 1}));
+        CHECK_THROWS(json::parse(R"([1,"a"])").as<std::vector<int>>());
+    }
+
+    SECTION("std::array")
+    {
+        std::array<double,3> a = {1.5, 2.5, 3.5};
+        json j(a);
+        CHECK(j.is_typed_array());
+        CHECK(j.to_string() == "[1.5,2.5,3.5]");
+        CHECK((j.as<std::array<double,3>>() == a));
+        CHECK((j.as<std::array<int,3>>() == std::array<int,3>{1, 2, 3}));
+        CHECK((json::parse("[1,2,3]").as<std::array<uint16_t,3>>() == std::array<uint16_t,3>{1, 2, 3}));
+
+        std::array<std::string,2> s = {"a", "b"};
+        json k(s);
+        CHECK_FALSE(k.is_typed_array());
+        CHECK((k.as<std::array<std::string,2>>() == s));
+    }
+
+    SECTION("span export")
+    {
+        std::vector<double> v = {1.5, 2.5, 3.5};
+        json j(v);
+        CHECK(j.is<span<const double>>());
+        CHECK_FALSE(j.is<span<const float>>());
+
+        span<const double> s = j.as<span<const double>>();
+        REQUIRE(s.size() == 3);
+        CHECK(s[2] == 3.5);
+        CHECK(s.data() == j.as_typed_array_view().data(double_array_arg).data());
+
+        CHECK_THROWS(j.as<span<const float>>());
+        CHECK_THROWS(json::parse("[1.5,2.5]").as<span<const double>>());
+
+        json k(span<const double>(v.data(), 2));
+        CHECK(k.is_typed_array());
+        CHECK(k == json::parse("[1.5,2.5]"));
+    }
+
+    SECTION("matrix")
+    {
+        std::vector<std::vector<double>> m = {{1, 2}, {3, 4}, {5, 6}};
+        json j(m);
+        CHECK(j[1].is_typed_array());
+        CHECK(j.to_string() == "[[1.0,2.0],[3.0,4.0],[5.0,6.0]]");
+        CHECK((j.as<std::vector<std::vector<double>>>() == m));
+        CHECK((json::parse(j.to_string()).as<std::vector<std::vector<double>>>() == m));
+    }
+}
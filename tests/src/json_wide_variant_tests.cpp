@@ -0,0 +1,49 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+
+using namespace jsoncons;
+
+using json32 = basic_json<char,wide_variant_policy<sorted_policy,32>>;
+using ojson64 = basic_json<char,wide_variant_policy<preserve_order_policy,64>>;
+
+TEST_CASE("wide_variant_policy tests")
+{
+    CHECK(sizeof(json32) == 32);
+    CHECK(sizeof(ojson64) == 64);
+
+    SECTION("ISO timestamps are short strings with 32 bytes")
+    {
+        json32 j("2020-06-01T12:34:56.789Z", semantic_tag::datetime);
+        CHECK(j.storage() == storage_kind::short_string_value);
+        CHECK(j.tag() == semantic_tag::datetime);
+        CHECK(j.as<std::string>() == "2020-06-01T12:34:56.789Z");
+
+        json32 k(std::string(29, 'x'));
+        CHECK(k.storage() == storage_kind::short_string_value);
+        json32 l(std::string(30, 'x'));
+        CHECK(l.storage() == storage_kind::long_string_value);
+    }
+
+    SECTION("UUIDs are short strings with 64 bytes")
+    {
+        ojson64 j = ojson64::parse(R"({"id":"123e4567-e89b-12d3-a456-426614174000","n":1})");
+        CHECK(j["id"].storage() == storage_kind::short_string_value);
+        CHECK(j["id"].as<std::string>() == "123e4567-e89b-12d3-a456-426614174000");
+
+        ojson64 k = j;
+        CHECK(k == j);
+        CHECK(k.to_string() == R"({"id":"123e4567-e89b-12d3-a456-426614174000","n":1})");
+    }
+
+    SECTION("conversion to default json")
+    {
+        json32 j = json32::parse(R"(["2020-06-01T12:34:56Z",1.5])");
+        json k = json::parse(j.to_string());
+        CHECK(k[0].as<std::string>() == j[0].as<std::string>());
+        CHECK(k[0].storage() == storage_kind::long_string_value);
+    }
+}
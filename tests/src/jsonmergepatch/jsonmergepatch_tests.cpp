@@ -0,0 +1,117 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <catch/catch.hpp>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons_ext/jsonmergepatch/jsonmergepatch.hpp>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Test cases from RFC 7396, Appendix A
+    const char* rfc7396_cases = R"(
+    [
+        [{"a":"b"}, {"a":"c"}, {"a":"c"}],
+        [{"a":"b"}, {"b":"c"}, {"a":"b","b":"c"}],
+        [{"a":"b"}, {"a":null}, {}],
+        [{"a":"b","b":"c"}, {"a":null}, {"b":"c"}],
+        [{"a":["b"]}, {"a":"c"}, {"a":"c"}],
+        [{"a":"c"}, {"a":["b"]}, {"a":["b"]}],
+        [{"a":{"b":"c"}}, {"a":{"b":"d","c":null}}, {"a":{"b":"d"}}],
+        [{"a":[{"b":"c"}]}, {"a":[1]}, {"a":[1]}],
+        [["a","b"], ["c","d"], ["c","d"]],
+        [{"a":"b"}, ["c"], ["c"]],
+        [{"a":"foo"}, null, null],
+        [{"a":"foo"}, "bar", "bar"],
+        [{"e":null}, {"a":1}, {"e":null,"a":1}],
+        [[1,2], {"a":"b","c":null}, {"a":"b"}],
+        [{}, {"a":{"bb":{"ccc":null}}}, {"a":{"bb":{}}}]
+    ]
+    )";
+
+}
+
+TEST_CASE("jsonmergepatch apply_merge_patch tests")
+{
+    json cases = json::parse(rfc7396_cases);
+
+    SECTION("const patch")
+    {
+        for (const auto& c : cases.array_range())
+        {
+            json target = c[0];
+            jsonmergepatch::apply_merge_patch(target, c[1]);
+            CHECK(target == c[2]);
+        }
+    }
+
+    SECTION("rvalue patch")
+    {
+        for (const auto& c : cases.array_range())
+        {
+            json target = c[0];
+            json patch = c[1];
+            jsonmergepatch::apply_merge_patch(target, std::move(patch));
+            CHECK(target == c[2]);
+        }
+    }
+
+    SECTION("patch from cursor")
+    {
+        for (const auto& c : cases.array_range())
+        {
+            json target = c[0];
+            std::string s;
+            c[1].dump(s);
+            json_cursor cursor(s);
+            jsonmergepatch::apply_merge_patch(target, cursor);
+            CHECK(target == c[2]);
+        }
+    }
+}
+
+TEST_CASE("jsonmergepatch from_diff tests")
+{
+    json source = json::parse(R"(
+    {
+        "title": "Goodbye!",
+        "author" : {"givenName" : "John", "familyName" : "Doe"},
+        "tags":[ "example", "sample" ],
+        "content": "This will be unchanged"
+    }
+    )");
+
+    json target = json::parse(R"(
+    {
+        "title": "Hello!",
+        "author" : {"givenName" : "John"},
+        "tags": [ "example" ],
+        "content": "This will be unchanged",
+        "phoneNumber": "+01-123-456-7890"
+    }
+    )");
+
+    json patch = jsonmergepatch::from_diff(source, target);
+
+    json expected = json::parse(R"(
+    {
+        "title": "Hello!",
+        "phoneNumber": "+01-123-456-7890",
+        "author": {"familyName": null},
+        "tags": [ "example" ]
+    }
+    )");
+    CHECK(patch == expected);
+
+    jsonmergepatch::apply_merge_patch(source, patch);
+    CHECK(source == target);
+}
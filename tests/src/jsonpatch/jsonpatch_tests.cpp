@@ -492,5 +492,90 @@ TEST_CASE("add_when_new_items_in_target_array2")
     check_patch(source,patch,std::error_code(),target);
 }
 
+TEST_CASE("from_diff with insertion at front of array")
+{
+    json source = json::parse(R"({"a" : [1,2,3,4,5]})");
+    json target = json::parse(R"({"a" : [0,1,2,3,4,5]})");
+
+    json patch = jsonpatch::from_diff(source, target);
+
+    json expected = json::parse(R"([{"op":"add","path":"/a/0","value":0}])");
+    CHECK(patch == expected);
+    check_patch(source,patch,std::error_code(),target);
+}
+
+TEST_CASE("from_diff with removals and changes inside array")
+{
+    json source = json::parse(R"([{"id":1,"v":"a"},{"id":2},{"id":3},{"id":4,"v":"b"},5,6])");
+    json target = json::parse(R"([{"id":1,"v":"a"},{"id":3},{"id":4,"v":"c"},6,7,8])");
+
+    json patch = jsonpatch::from_diff(source, target);
+
+    CHECK(patch.size() == 5);
+    check_patch(source,patch,std::error_code(),target);
+}
+
+TEST_CASE("from_diff with nested arrays and objects")
+{
+    json source = json::parse(R"({"x":[[1,2],[3,4],{"k":[5,6]}],"y":{"z":[true,false]}})");
+    json target = json::parse(R"({"x":[[0,1,2],{"k":[5,7,6]}],"y":{"z":[false],"w":null}})");
+
+    json patch = jsonpatch::from_diff(source, target);
+
+    check_patch(source,patch,std::error_code(),target);
+}
+
+TEST_CASE("apply_patch rollback of move, replace and remove")
+{
+    json target = json::parse(R"({"a":{"b":[1,2,3]},"c":"d","e":[4,5]})");
+    const json expected = target;
+
+    json patch = json::parse(R"(
+    [
+        { "op": "move", "from": "/a/b", "path": "/e/0" },
+        { "op": "move", "from": "/c", "path": "/a/c" },
+        { "op": "replace", "path": "/e/1", "value": 6 },
+        { "op": "remove", "path": "/e/2" },
+        { "op": "copy", "from": "/a", "path": "/e/-" },
+        { "op": "remove", "path": "/x" }
+    ]
+    )");
+
+    check_patch(target,patch,jsonpatch::jsonpatch_errc::remove_failed,expected);
+}
 
+TEST_CASE("apply_patch with rvalue patch")
+{
+    json target = json::parse(R"({"foo":"bar"})");
 
+    json patch = json::parse(R"(
+    [
+        { "op": "add", "path": "/baz", "value": {"long_enough_to_allocate": [1,2,3]} },
+        { "op": "replace", "path": "/foo", "value": "a long string value that is not stored inline" }
+    ]
+    )");
+
+    jsonpatch::apply_patch(target, std::move(patch));
+
+    json expected = json::parse(R"({"foo":"a long string value that is not stored inline","baz":{"long_enough_to_allocate":[1,2,3]}})");
+    CHECK(target == expected);
+}
+
+TEST_CASE("apply_patch with no_rollback")
+{
+    json target = json::parse(R"({"foo":"bar"})");
+
+    json patch = json::parse(R"(
+    [
+        { "op": "add", "path": "/baz", "value": "qux" },
+        { "op": "remove", "path": "/x" }
+    ]
+    )");
+
+    std::error_code ec;
+    jsonpatch::apply_patch(target, patch, jsonpatch::apply_patch_options::no_rollback, ec);
+    CHECK(ec == jsonpatch::jsonpatch_errc::remove_failed);
+
+    json expected = json::parse(R"({"foo":"bar","baz":"qux"})");
+    CHECK(target == expected);
+}
@@ -152,3 +152,96 @@ TEST_CASE("flatten test")
     }
 }
 
+
+TEST_CASE("jsonpointer flatten_to and unflatten from pairs")
+{
+    json input = json::parse(R"(
+    {
+        "application": "hiking",
+        "reputons": [
+            {
+                "rater": "HikingAsylum",
+                "assertion": "advanced",
+                "rated": "Marilyn C",
+                "rating": 0.90,
+                "confidence": 0.99
+            },
+            {
+                "rater": "HikingAsylum",
+                "assertion": "intermediate",
+                "rated": "Hongmin",
+                "rating": 0.75,
+                "confidence": 0.97
+            }
+        ],
+        "a/b" : {"m~n" : [], "x" : {}},
+        "discards": {
+            "1000": "Record does not exist",
+            "1004": "Queue limit exceeded"
+        }
+    }
+    )");
+
+    std::vector<std::pair<std::string,json>> pairs;
+    jsonpointer::flatten_to(input, 
+        [&pairs](const jsoncons::string_view& key, const json& val)
+        {
+            pairs.emplace_back(std::string(key.data(), key.size()), val);
+        });
+
+    SECTION("flatten_to agrees with flatten")
+    {
+        json flattened = jsonpointer::flatten(input);
+        REQUIRE(flattened.size() == pairs.size());
+        for (const auto& item : pairs)
+        {
+            CHECK(flattened.at(item.first) == item.second);
+        }
+        CHECK(pairs[0].first == "/a~1b/m~0n");
+    }
+
+    SECTION("unflatten from pairs")
+    {
+        json expected = jsonpointer::unflatten(jsonpointer::flatten(input));
+        json result = jsonpointer::unflatten<json>(pairs.begin(), pairs.end());
+        CHECK(result == expected);
+        CHECK(result["reputons"].is_array());
+        CHECK(result["discards"].is_object());
+    }
+
+    SECTION("unflatten from pairs with assume_object")
+    {
+        json result = jsonpointer::unflatten<json>(pairs.begin(), pairs.end(), jsonpointer::unflatten_options::assume_object);
+        CHECK(result["reputons"].is_object());
+        CHECK(result["reputons"]["1"]["rated"] == json("Hongmin"));
+    }
+
+    SECTION("unflatten from unordered pairs")
+    {
+        std::vector<std::pair<std::string,json>> unordered = {{"/b/0","x"},{"/a","y"},{"/b/1","z"},{"/b/0","w"}};
+        json result = jsonpointer::unflatten<json>(unordered.begin(), unordered.end());
+        CHECK(result == json::parse(R"({"a":"y","b":["w","z"]})"));
+    }
+
+    SECTION("unflatten does not depend on the order of array elements")
+    {
+        std::vector<std::pair<std::string,json>> reversed = {{"/b/1",1},{"/b/0",0}};
+        json result = jsonpointer::unflatten<json>(reversed.begin(), reversed.end());
+        CHECK(result == json::parse(R"({"b":[0,1]})"));
+
+        json flattened(json_object_arg);
+        for (const auto& item : reversed)
+        {
+            flattened.try_emplace(item.first, item.second);
+        }
+        CHECK(result == jsonpointer::unflatten(flattened));
+
+        std::vector<std::pair<std::string,json>> nested = {{"/2/x",2},{"/0",0},{"/1/1",11},{"/1/0",10}};
+        result = jsonpointer::unflatten<json>(nested.begin(), nested.end());
+        CHECK(result == json::parse(R"([0,[10,11],{"x":2}])"));
+
+        std::vector<std::pair<std::string,json>> gap = {{"/b/2",2},{"/b/0",0}};
+        result = jsonpointer::unflatten<json>(gap.begin(), gap.end());
+        CHECK(result == json::parse(R"({"b":{"0":0,"2":2}})"));
+    }
+}
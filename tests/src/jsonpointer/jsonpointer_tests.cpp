@@ -334,3 +334,125 @@ TEST_CASE("[jsonpointer] Inserting object after deleting it")
     CHECK(oj.size() == 1);
 }
 
+
+TEST_CASE("[jsonpointer] parsed_json_ptr")
+{
+    json example = json::parse(R"(
+       {
+          "a/b": ["bar", "baz"],
+          "m~n": ["foo", "qux"],
+          "c" : {"d" : 1}
+       }
+    )");
+
+    SECTION("tokens")
+    {
+        jsonpointer::parsed_json_ptr ptr("/m~0n/1");
+        REQUIRE(ptr.size() == 2);
+        CHECK(ptr[0].name() == "m~n");
+        CHECK_FALSE(ptr[0].is_index());
+        CHECK(ptr[1].is_index());
+        CHECK(ptr[1].index() == 1);
+        CHECK(ptr.string() == "/m~0n/1");
+    }
+
+    SECTION("invalid pointer")
+    {
+        std::error_code ec;
+        jsonpointer::parsed_json_ptr ptr("a/b", ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::expected_slash);
+        ec = std::error_code();
+        jsonpointer::parsed_json_ptr ptr2("/a~2", ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::expected_0_or_1);
+    }
+
+    SECTION("get and contains")
+    {
+        jsonpointer::parsed_json_ptr ptr("/a~1b/1");
+        CHECK(jsonpointer::get(example, ptr) == json("baz"));
+        CHECK(jsonpointer::get(example, jsonpointer::parsed_json_ptr("")) == example);
+        CHECK(jsonpointer::contains(example, ptr));
+        CHECK_FALSE(jsonpointer::contains(example, jsonpointer::parsed_json_ptr("/a~1b/2")));
+
+        std::error_code ec;
+        jsonpointer::get(example, jsonpointer::parsed_json_ptr("/a~1b/-"), ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::index_exceeds_array_size);
+        jsonpointer::get(example, jsonpointer::parsed_json_ptr("/c/e"), ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::name_not_found);
+    }
+
+    SECTION("modifiers")
+    {
+        jsonpointer::insert(example, jsonpointer::parsed_json_ptr("/a~1b/-"), json("end"));
+        jsonpointer::insert(example, jsonpointer::parsed_json_ptr("/a~1b/0"), json("begin"));
+        CHECK(example["a/b"] == json::parse(R"(["begin","bar","baz","end"])"));
+
+        std::error_code ec;
+        jsonpointer::insert(example, jsonpointer::parsed_json_ptr("/c/d"), json(2), ec);
+        CHECK(ec == jsonpointer::jsonpointer_errc::key_already_exists);
+        jsonpointer::insert_or_assign(example, jsonpointer::parsed_json_ptr("/c/d"), json(2));
+        CHECK(example["c"]["d"] == json(2));
+
+        jsonpointer::replace(example, jsonpointer::parsed_json_ptr("/m~0n/0"), json("bar"));
+        CHECK(example["m~n"][0] == json("bar"));
+
+        jsonpointer::remove(example, jsonpointer::parsed_json_ptr("/m~0n/1"));
+        CHECK(example["m~n"].size() == 1);
+        jsonpointer::remove(example, jsonpointer::parsed_json_ptr("/c/d"));
+        CHECK(example["c"].empty());
+    }
+}
+
+TEST_CASE("[jsonpointer] json_ptr_batch")
+{
+    const json example = json::parse(R"(
+       {
+          "store": {
+              "book": [{"title" : "A"},{"title" : "B"}],
+              "bicycle": {"color": "red"}
+          }
+       }
+    )");
+
+    jsonpointer::json_ptr_batch batch;
+    auto id1 = batch.add("/store/book/1/title");
+    auto id2 = batch.add("/store/book/0/title");
+    auto id3 = batch.add("/store/bicycle/color");
+    auto id4 = batch.add("/store/book/2/title");
+    auto id5 = batch.add("");
+
+    std::vector<const json*> results = batch.resolve(example);
+    REQUIRE(results.size() == 5);
+    REQUIRE(results[id1] != nullptr);
+    CHECK(*results[id1] == json("B"));
+    REQUIRE(results[id2] != nullptr);
+    CHECK(*results[id2] == json("A"));
+    REQUIRE(results[id3] != nullptr);
+    CHECK(*results[id3] == json("red"));
+    CHECK(results[id4] == nullptr);
+    CHECK(results[id5] == &example);
+}
+
+TEST_CASE("[jsonpointer] json_ptr_batch with many siblings")
+{
+    json doc(json_object_arg);
+    jsonpointer::json_ptr_batch batch;
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string key = "k" + std::to_string(i);
+        doc.try_emplace(key, json(json_array_arg, {json(i)}));
+        batch.add("/" + key + "/0");
+        batch.add("/" + key);
+    }
+    batch.add("/k7/0");
+
+    std::vector<json*> results = batch.resolve(doc);
+    REQUIRE(results.size() == 2001);
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        REQUIRE(results[2*i] != nullptr);
+        CHECK(*results[2*i] == json(i));
+        CHECK(results[2*i+1] == &doc.at("k" + std::to_string(i)));
+    }
+    CHECK(results[2000] == results[14]);
+}
@@ -125,3 +125,22 @@ TEST_CASE("encode_msgpack_arrays_and_maps")
     check_encode_msgpack({0x81,0xa2,'o','c',0x94,'\0','\1','\2','\3'}, json::parse("{\"oc\": [0, 1, 2, 3]}"));
 }
 
+
+TEST_CASE("encode_msgpack with exact_size_arg")
+{
+    json j = json::parse(R"({"name":"a\"b","values":[1,-2,3.5,100000,true,null],"nested":[[],[{}]]})");
+
+    std::vector<uint8_t> expected = {0x01};
+    msgpack::encode_msgpack(j, expected);
+
+    std::vector<uint8_t> v = {0x01};
+    msgpack::encode_msgpack(exact_size_arg, j, v);
+    CHECK(v == expected);
+
+    std::map<std::string,std::vector<int>> m = {{"a",{1,-300,70000}},{"b",{}}};
+    std::vector<uint8_t> expected2;
+    msgpack::encode_msgpack(m, expected2);
+    std::vector<uint8_t> v2;
+    msgpack::encode_msgpack(exact_size_arg, m, v2);
+    CHECK(v2 == expected2);
+}
@@ -106,3 +106,53 @@ TEST_CASE("Too many and too few items in MessagePack object or array")
         encoder.flush();
     }
 }
+
+TEST_CASE("msgpack_encoder with gather_sink")
+{
+    std::vector<uint8_t> bytes(5000, 7);
+    json j(json_object_arg);
+    j.try_emplace("bytes", byte_string_arg, bytes);
+    j.try_emplace("text", std::string(5000, 't'));
+    j.try_emplace("small", "s");
+
+    std::vector<uint8_t> expected;
+    msgpack::encode_msgpack(j, expected);
+
+    auto count_external = [&j](const gather_buffer<uint8_t>& buf, std::vector<uint8_t>& v)
+    {
+        std::size_t external_count = 0;
+        for (auto segment : buf.segments())
+        {
+            v.insert(v.end(), segment.begin(), segment.end());
+            if (segment.data() == j.at("bytes").as_byte_string_view().data() ||
+                segment.data() == reinterpret_cast<const uint8_t*>(j.at("text").as_string_view().data()))
+            {
+                ++external_count;
+            }
+        }
+        return external_count;
+    };
+
+    SECTION("msgpack::encode_msgpack references long values")
+    {
+        gather_buffer<uint8_t> buf;
+        msgpack::encode_msgpack(j, buf);
+
+        std::vector<uint8_t> v;
+        CHECK(count_external(buf, v) == 2);
+        CHECK(v == expected);
+    }
+
+    SECTION("an encoder with a gather_sink copies")
+    {
+        gather_buffer<uint8_t> buf;
+        {
+            msgpack::basic_msgpack_encoder<gather_sink<uint8_t>> encoder(buf);
+            j.dump(encoder);
+        }
+
+        std::vector<uint8_t> v;
+        CHECK(count_external(buf, v) == 0);
+        CHECK(v == expected);
+    }
+}
@@ -0,0 +1,194 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <jsoncons_ext/msgpack/msgpack_push_reader.hpp>
+#include <catch/catch.hpp>
+#include <vector>
+
+using namespace jsoncons;
+using namespace jsoncons::msgpack;
+
+namespace {
+
+    // Collects each root value as it is flushed
+    class msgpack_value_collector : public json_filter
+    {
+        json_decoder<json>& decoder_;
+        std::vector<json>& values_;
+    public:
+        msgpack_value_collector(json_decoder<json>& decoder, std::vector<json>& values)
+            : json_filter(decoder), decoder_(decoder), values_(values)
+        {
+        }
+    private:
+        void visit_flush() override
+        {
+            values_.push_back(decoder_.get_result());
+        }
+    };
+
+    std::vector<json> push_msgpack_in_chunks(const std::vector<uint8_t>& input, std::size_t chunk_size)
+    {
+        std::vector<json> values;
+        json_decoder<json> decoder;
+        msgpack_value_collector collector(decoder, values);
+        msgpack_push_reader reader(collector);
+
+        std::vector<uint8_t> chunk;
+        for (std::size_t pos = 0; pos < input.size(); pos += chunk_size)
+        {
+            std::size_t n = (std::min)(chunk_size, input.size() - pos);
+            chunk.assign(input.begin() + pos, input.begin() + pos + n);
+            reader.feed(chunk.data(), chunk.size());
+            // the reader does not hold on to the caller's buffer
+            chunk.assign(chunk.size(), 0xc1);
+        }
+        reader.finish();
+        return values;
+    }
+}
+
+TEST_CASE("msgpack_push_reader tests")
+{
+    std::vector<json> expected = {json::parse(R"({"name":"Jane Roe","tags":["a","b"],"amount":-1250.5,"flag":true,"none":null})"),
+                                  json::parse(R"([1,-2,[3,{"x":18446744073709551615}],[],{}])"),
+                                  json(std::string(300, 'x')),
+                                  json(byte_string_arg, std::vector<uint8_t>(70000, 7)),
+                                  json(10)};
+
+    std::vector<uint8_t> input;
+    for (const auto& val : expected)
+    {
+        std::vector<uint8_t> buffer;
+        encode_msgpack(val, buffer);
+        input.insert(input.end(), buffer.begin(), buffer.end());
+    }
+
+    SECTION("chunk sizes")
+    {
+        for (std::size_t chunk_size : {1, 2, 3, 7, 16, 1000, 100000})
+        {
+            std::vector<json> values = push_msgpack_in_chunks(input, chunk_size);
+            CHECK(values == expected);
+        }
+    }
+
+    SECTION("unexpected eof")
+    {
+        json_decoder<json> decoder;
+        msgpack_push_reader reader(decoder);
+
+        std::error_code ec;
+        reader.feed(input.data(), 5, ec);
+        REQUIRE_FALSE(ec);
+        reader.finish(ec);
+        CHECK(ec == msgpack_errc::unexpected_eof);
+        CHECK(reader.stopped());
+    }
+
+    SECTION("throwing overload")
+    {
+        json_decoder<json> decoder;
+        msgpack_push_reader reader(decoder);
+        std::vector<uint8_t> truncated(input.begin(), input.begin() + 5);
+        reader.feed(truncated.data(), truncated.size());
+        CHECK_THROWS_AS(reader.finish(), ser_error);
+    }
+}
+
+TEST_CASE("msgpack_push_reader errors")
+{
+    SECTION("never used")
+    {
+        json_decoder<json> decoder;
+        msgpack_push_reader reader(decoder);
+
+        std::vector<uint8_t> input = {0x91,0xc1};
+        std::error_code ec;
+        reader.feed(input.data(), input.size(), ec);
+        CHECK(ec == msgpack_errc::unknown_type);
+        CHECK(reader.stopped());
+    }
+
+    SECTION("max nesting depth")
+    {
+        json_decoder<json> decoder;
+        auto options = msgpack_options{}
+            .max_nesting_depth(2);
+        msgpack_push_reader reader(decoder, options);
+
+        std::vector<uint8_t> input = {0x91,0x91,0x91,0x01};
+        std::error_code ec;
+        reader.feed(input.data(), input.size(), ec);
+        CHECK(ec == msgpack_errc::max_nesting_depth_exceeded);
+
+        reader.reset();
+        ec = std::error_code();
+        std::vector<uint8_t> valid = {0x91,0x91,0x01};
+        reader.feed(valid.data(), valid.size(), ec);
+        CHECK_FALSE(ec);
+        CHECK(decoder.get_result() == json::parse("[[1]]"));
+    }
+
+    SECTION("max buffered bytes")
+    {
+        json_decoder<json> decoder;
+        auto options = msgpack_options{}
+            .max_buffered_bytes(256);
+        msgpack_push_reader reader(decoder, options);
+
+        // A byte string header declaring a length far beyond the input
+        std::vector<uint8_t> header = {0xc6,0xff,0xff,0xff,0xff};
+        std::vector<uint8_t> chunk(100, 0);
+        std::error_code ec;
+        reader.feed(header.data(), header.size(), ec);
+        CHECK_FALSE(ec);
+        reader.feed(chunk.data(), chunk.size(), ec);
+        reader.feed(chunk.data(), chunk.size(), ec);
+        CHECK_FALSE(ec);
+        reader.feed(chunk.data(), chunk.size(), ec);
+        CHECK(ec == msgpack_errc::max_buffered_bytes_exceeded);
+        CHECK(reader.stopped());
+    }
+
+    SECTION("default max buffered bytes")
+    {
+        json_decoder<json> decoder;
+        msgpack_push_reader reader(decoder);
+
+        std::vector<uint8_t> header = {0xc6,0xff,0xff,0xff,0xff};
+        std::vector<uint8_t> chunk(1024*1024 - header.size(), 0);
+        std::error_code ec;
+        reader.feed(header.data(), header.size(), ec);
+        reader.feed(chunk.data(), chunk.size(), ec);
+        CHECK_FALSE(ec);
+        reader.feed(chunk.data(), 1, ec);
+        CHECK(ec == msgpack_errc::max_buffered_bytes_exceeded);
+    }
+
+    SECTION("max buffered bytes with a completing chunk")
+    {
+        json_decoder<json> decoder;
+        auto options = msgpack_options{}
+            .max_buffered_bytes(16);
+        msgpack_push_reader reader(decoder, options);
+
+        json j(byte_string_arg, std::vector<uint8_t>(32, 1));
+        std::vector<uint8_t> input;
+        encode_msgpack(j, input);
+        std::error_code ec;
+        reader.feed(input.data(), 1, ec);
+        CHECK_FALSE(ec);
+        reader.feed(input.data() + 1, input.size() - 1, ec);
+        CHECK(ec == msgpack_errc::max_buffered_bytes_exceeded);
+
+        // Complete items within one chunk are not buffered
+        reader.reset();
+        ec = std::error_code();
+        reader.feed(input.data(), input.size(), ec);
+        CHECK_FALSE(ec);
+        CHECK(decoder.get_result() == j);
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("msgpack_view navigation")
+{
+    std::string long_string(300, 'x');
+    json j(json_object_arg);
+    j["name"] = "Cocktail";
+    j["ids"] = json::parse(R"([1,-2,3.5,true,null,{"x":[]},300,-70000,18446744073709551615])");
+    j["empty"] = json(json_object_arg);
+    j["long"] = long_string;
+    j["bytes"] = json(byte_string_arg, std::vector<uint8_t>{1,2,3});
+
+    std::vector<uint8_t> data;
+    msgpack::encode_msgpack(j, data);
+
+    for (bool indexed : {false, true})
+    {
+        msgpack::msgpack_view root(data, indexed);
+
+        CHECK(root.is_object());
+        CHECK(root.size() == 5);
+        CHECK(root.contains("ids"));
+        CHECK_FALSE(root.contains("nope"));
+        CHECK(root.at("name").as<std::string>() == "Cocktail");
+        CHECK(root["name"].as<string_view>() == string_view("Cocktail"));
+        CHECK(root["long"].as<std::string>() == long_string);
+        CHECK(root["empty"].is_object());
+        CHECK(root["empty"].empty());
+        CHECK(root["bytes"].is_byte_string());
+        CHECK((root["bytes"].as<std::vector<uint8_t>>() == std::vector<uint8_t>{1,2,3}));
+        CHECK_THROWS(root.at("nope"));
+
+        msgpack::msgpack_view ids = root["ids"];
+        REQUIRE(ids.is_array());
+        CHECK(ids.size() == 9);
+        CHECK(ids[0].as<int>() == 1);
+        CHECK(ids[1].is_int64());
+        CHECK(ids[1].as<int>() == -2);
+        CHECK(ids[2].as<double>() == 3.5);
+        CHECK(ids[3].as<bool>());
+        CHECK(ids[4].is_null());
+        CHECK(ids[5]["x"].is_array());
+        CHECK(ids[6].as<int>() == 300);
+        CHECK(ids[7].as<int>() == -70000);
+        CHECK(ids[8].as<uint64_t>() == (std::numeric_limits<uint64_t>::max)());
+        CHECK_THROWS(ids.at(9));
+
+        std::size_t count = 0;
+        for (auto item : root["ids"].array_range())
+        {
+            CHECK_FALSE(item.is_string());
+            ++count;
+        }
+        CHECK(count == 9);
+
+        std::vector<std::string> keys;
+        for (const auto& member : root.object_range())
+        {
+            keys.push_back(member.key().as<std::string>());
+        }
+        CHECK((keys == std::vector<std::string>{"bytes","empty","ids","long","name"}));
+        CHECK(root.find("ids")->value().size() == 9);
+        CHECK(root.find("nope") == root.object_range().end());
+
+        CHECK(ids.as<json>() == j["ids"]);
+        CHECK(root.as<json>() == j);
+        std::ostringstream os;
+        os << ids[5];
+        CHECK(os.str() == R"({"x":[]})");
+    }
+}
+
+TEST_CASE("msgpack_view errors")
+{
+    std::vector<uint8_t> data = {0x92,0x01}; // fixarray(2) with one element
+    msgpack::msgpack_view root(data);
+    CHECK(root[0].as<int>() == 1);
+    CHECK_THROWS(root.at(1).as<int>());
+    CHECK_THROWS(root.as<json>());
+}
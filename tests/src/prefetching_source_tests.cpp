@@ -0,0 +1,134 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/prefetching_source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/csv/csv.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("prefetching_source tests")
+{
+    std::string data;
+    for (int i = 0; i < 1000; ++i)
+    {
+        data.push_back(static_cast<char>(i % 251));
+    }
+
+    SECTION("get, peek, ignore and read")
+    {
+        std::istringstream is(data);
+        prefetching_source<binary_stream_source> source(is, 7, 3);
+
+        CHECK(source.peek() == 0);
+        CHECK(source.get() == 0);
+        uint8_t c = 0;
+        CHECK(source.get(c) == 1);
+        CHECK(c == 1);
+        source.ignore(10);
+        CHECK(source.position() == 12);
+
+        std::vector<uint8_t> v(500);
+        CHECK(source.read(v.data(), v.size()) == 500);
+        CHECK(v[0] == 12);
+        CHECK(v[499] == static_cast<uint8_t>(511 % 251));
+        CHECK(source.position() == 512);
+        CHECK_FALSE(source.eof());
+
+        std::vector<uint8_t> rest(1000);
+        CHECK(source.read(rest.data(), rest.size()) == 488);
+        CHECK(source.eof());
+        CHECK_FALSE(source.is_error());
+        CHECK(source.get() == byte_traits::eof());
+        CHECK(source.position() == 1000);
+    }
+
+    SECTION("empty input")
+    {
+        std::istringstream is;
+        prefetching_source<binary_stream_source> source(is);
+        CHECK(source.peek() == byte_traits::eof());
+        CHECK(source.eof());
+    }
+
+    SECTION("destroyed before input is consumed")
+    {
+        std::istringstream is(data);
+        {
+            prefetching_source<binary_stream_source> source(is, 16, 2);
+            CHECK(source.get() == 0);
+        }
+        CHECK(is.tellg() > 0);
+    }
+}
+
+TEST_CASE("prefetching_source with readers and cursors")
+{
+    json expected(json_array_arg);
+    for (int i = 0; i < 500; ++i)
+    {
+        json item;
+        item["id"] = i;
+        item["name"] = std::string("name") + std::to_string(i);
+        item["value"] = i * 0.5;
+        expected.push_back(std::move(item));
+    }
+
+    SECTION("json_reader")
+    {
+        std::stringstream is;
+        is << expected;
+
+        json_decoder<json> decoder;
+        basic_json_reader<char,prefetching_source<stream_source<char>>> reader(prefetching_source<stream_source<char>>(is, 64, 4), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("json_cursor")
+    {
+        std::stringstream is;
+        is << expected;
+
+        basic_json_cursor<char,prefetching_source<stream_source<char>>> cursor(is);
+        std::size_t count = 0;
+        for (; !cursor.done(); cursor.next())
+        {
+            if (cursor.current().event_type() == staj_event_type::begin_object)
+            {
+                ++count;
+            }
+        }
+        CHECK(count == expected.size());
+    }
+
+    SECTION("cbor_reader")
+    {
+        std::vector<uint8_t> buffer;
+        cbor::encode_cbor(expected, buffer);
+        std::stringstream is(std::string(buffer.begin(), buffer.end()));
+
+        json_decoder<json> decoder;
+        cbor::basic_cbor_reader<prefetching_source<binary_stream_source>> reader(prefetching_source<binary_stream_source>(is, 100, 2), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("csv_reader")
+    {
+        std::stringstream is("a,b\n1,2\n3,4\n");
+
+        json_decoder<json> decoder;
+        auto options = csv::csv_options{}
+            .assume_header(true);
+        csv::basic_csv_reader<char,prefetching_source<stream_source<char>>> reader(prefetching_source<stream_source<char>>(is, 3), decoder, options);
+        reader.read();
+        CHECK(decoder.get_result() == json::parse(R"([{"a":1,"b":2},{"a":3,"b":4}])"));
+    }
+}
@@ -7,6 +7,7 @@
 #include <utility>
 #include <ctime>
 #include <string>
+#include <random>
 #include <catch/catch.hpp>
 
 using namespace jsoncons;
@@ -57,3 +58,85 @@ BOOST_AUTO_TEST_CASE( test1 )
 }
 #endif
 
+
+TEST_CASE("unicons::validate vectorized and scalar agree")
+{
+    // Valid sequences of each length, and bytes that are invalid in various ways
+    std::vector<std::string> pieces = {"a", "0123456789abcdef", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", 
+        "\xed\x9f\xbf", "\xf4\x8f\xbf\xbf", "\x80", "\xc0\xaf", "\xe0\x80\xaf", "\xed\xa0\x80", "\xf4\x90\x80\x80", 
+        "\xf8\x88\x80\x80\x80", "\xc3", "\xe2\x82", "\xf0\x9f\x98", "\xff"};
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> dist(0, pieces.size() - 1);
+    std::uniform_int_distribution<int> count(0, 40);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        std::string s;
+        int n = count(gen);
+        for (int j = 0; j < n; ++j)
+        {
+            // Mostly valid, so errors land at every offset in a block
+            std::size_t k = dist(gen);
+            s.append(pieces[(i % 4 == 0 || j == n - 1) ? k : k % 7]);
+        }
+        auto expected = unicons::validate(s.begin(), s.end());
+        auto result = unicons::validate(s.data(), s.data() + s.size());
+        CHECK(result.ec == expected.ec);
+        CHECK((result.it - s.data()) == (expected.it - s.begin()));
+    }
+}
+
+TEST_CASE("json_parser validates UTF-8 in the string scan")
+{
+    SECTION("valid")
+    {
+        std::string s = "[\"0123456789abcdef\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80 0123456789abcdef\", \"\\u00e9\"]";
+        json j = json::parse(s);
+        CHECK(j[0].as<std::string>() == "0123456789abcdef\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80 0123456789abcdef");
+        CHECK(j[1].as<std::string>() == "\xc3\xa9");
+    }
+
+    SECTION("invalid")
+    {
+        std::string prefix = "0123456789abcdef0123456789abcdef";
+        for (std::size_t i = 0; i < prefix.size(); ++i)
+        {
+            std::string s = "[\"" + prefix.substr(0, i) + "\xed\xa0\x80" + prefix.substr(i) + "\"]";
+            std::error_code ec;
+            json_decoder<json> decoder;
+            json_reader reader(s, decoder);
+            reader.read(ec);
+            CHECK(ec == json_errc::illegal_codepoint);
+        }
+        CHECK_THROWS(json::parse("[\"abc\xc3\"]"));
+        CHECK_THROWS(json::parse("[\"\\ud800\"]"));
+    }
+
+    SECTION("sequence split across buffers")
+    {
+        std::string s = "[\"abc\xe2\x82\xac\"]";
+        for (std::size_t split = 1; split < s.size(); ++split)
+        {
+            json_decoder<json> decoder;
+            json_parser parser;
+            parser.update(s.data(), split);
+            parser.parse_some(decoder);
+            parser.update(s.data() + split, s.size() - split);
+            parser.parse_some(decoder);
+            parser.finish_parse(decoder);
+            REQUIRE(parser.done());
+            CHECK(decoder.get_result()[0].as<std::string>() == "abc\xe2\x82\xac");
+        }
+
+        std::string t = "[\"abc\xe2\x82\x41\"]";
+        json_decoder<json> decoder;
+        json_parser parser;
+        std::error_code ec;
+        parser.update(t.data(), 6);
+        parser.parse_some(decoder, ec);
+        REQUIRE_FALSE(ec);
+        parser.update(t.data() + 6, t.size() - 6);
+        parser.parse_some(decoder, ec);
+        CHECK(ec);
+    }
+}